@@ -327,7 +327,8 @@ template<typename GraphDom, typename GraphCodom,
 typename IndexMap1, typename IndexMap2,
 typename EdgePred, typename VertexPred,
 typename Callback,
-problem_selector problem_selection>
+problem_selector problem_selection,
+typename PartialMapPred = AlwaysTrue>
 class state {
 	typedef typename graph_traits<GraphDom>::vertex_descriptor vertex1_type;
 	typedef typename graph_traits<GraphCodom>::vertex_descriptor vertex2_type;
@@ -369,8 +370,9 @@ public:
 	state &operator=(const state&) = delete;
 public:
 
-	state(const GraphDom &gDom, const GraphCodom &gCodom, EdgePred edgePred, VertexPred vertexPred)
-	: gDom(gDom), gCodom(gCodom), edgePred(edgePred), vertexPred(vertexPred),
+	state(const GraphDom &gDom, const GraphCodom &gCodom, EdgePred edgePred, VertexPred vertexPred,
+			PartialMapPred partialMapPred = PartialMapPred())
+	: gDom(gDom), gCodom(gCodom), edgePred(edgePred), vertexPred(vertexPred), partialMapPred(partialMapPred),
 	stateDom(gDom, gCodom), stateCodom(gCodom, gDom) { }
 
 	// Add vertex pair to the state
@@ -393,6 +395,8 @@ public:
 	bool feasible(const vertex1_type& v_new, const vertex2_type& w_new) {
 
 		if(!vertexPred(v_new, w_new)) return false;
+		// the pair may also be rejected based on the current partial mapping, which does not yet contain it
+		if(!partialMapPred(v_new, w_new, stateDom.get_map(), gDom, gCodom)) return false;
 
 		// graph1
 		graph1_size_type term_in1_count = 0, term_out1_count = 0, rest1_count = 0;
@@ -590,6 +594,7 @@ public:
 
 	EdgePred edgePred;
 	VertexPred vertexPred;
+	PartialMapPred partialMapPred;
 
 	base_state<GraphDom, GraphCodom, IndexMap1, IndexMap2> stateDom;
 	base_state<GraphCodom, GraphDom, IndexMap2, IndexMap1> stateCodom;
@@ -623,12 +628,13 @@ typename VertexOrder1,
 typename EdgeEquivalencePredicate,
 typename VertexEquivalencePredicate,
 typename SubGraphIsoMapCallback,
-problem_selector problem_selection>
+problem_selector problem_selection,
+typename PartialMapPredicate>
 bool match(const Graph1& graph1, const Graph2& graph2,
 		SubGraphIsoMapCallback user_callback, const VertexOrder1& vertex_order1,
 		state<Graph1, Graph2, IndexMap1, IndexMap2,
 		EdgeEquivalencePredicate, VertexEquivalencePredicate,
-		SubGraphIsoMapCallback, problem_selection>& s) {
+		SubGraphIsoMapCallback, problem_selection, PartialMapPredicate>& s) {
 
 	typename VertexOrder1::const_iterator graph1_verts_iter;
 
@@ -700,13 +706,15 @@ typename IndexMapLarge,
 typename VertexOrderSmall,
 typename EdgeEquivalencePredicate,
 typename VertexEquivalencePredicate,
-typename SubGraphIsoMapCallback>
+typename SubGraphIsoMapCallback,
+typename PartialMapPredicate>
 bool vf2_subgraph_morphism(const GraphSmall& graph_small, const GraphLarge& graph_large,
 		SubGraphIsoMapCallback user_callback,
 		IndexMapSmall index_map_small, IndexMapLarge index_map_large,
 		const VertexOrderSmall& vertex_order_small,
 		EdgeEquivalencePredicate edge_comp,
-		VertexEquivalencePredicate vertex_comp) {
+		VertexEquivalencePredicate vertex_comp,
+		PartialMapPredicate partial_map_comp) {
 
 	// Graph requirements
 	BOOST_CONCEPT_ASSERT((BidirectionalGraphConcept<GraphSmall>));
@@ -765,8 +773,8 @@ bool vf2_subgraph_morphism(const GraphSmall& graph_small, const GraphLarge& grap
 
 	detail::state<GraphSmall, GraphLarge, IndexMapSmall, IndexMapLarge,
 			EdgeEquivalencePredicate, VertexEquivalencePredicate,
-			SubGraphIsoMapCallback, problem_selection>
-			s(graph_small, graph_large, edge_comp, vertex_comp);
+			SubGraphIsoMapCallback, problem_selection, PartialMapPredicate>
+			s(graph_small, graph_large, edge_comp, vertex_comp, partial_map_comp);
 
 	return detail::match(graph_small, graph_large, user_callback, vertex_order_small, s);
 }
@@ -797,7 +805,39 @@ bool vf2_subgraph_mono(const GraphSmall& graph_small, const GraphLarge& graph_la
 			index_map_small, index_map_large,
 			vertex_order_small,
 			edge_comp,
-			vertex_comp);
+			vertex_comp,
+			AlwaysTrue());
+}
+
+// As above, but each candidate pair (v, w) is additionally checked by
+// partial_map_comp(v, w, m, graph_small, graph_large), where m is the current partial mapping
+// which does not contain v. This allows for rejecting a branch as soon as
+// a condition on several vertices can be evaluated.
+
+template <typename GraphSmall,
+typename GraphLarge,
+typename IndexMapSmall,
+typename IndexMapLarge,
+typename VertexOrderSmall,
+typename EdgeEquivalencePredicate,
+typename VertexEquivalencePredicate,
+typename PartialMapPredicate,
+typename SubGraphIsoMapCallback>
+bool vf2_subgraph_mono(const GraphSmall& graph_small, const GraphLarge& graph_large,
+		SubGraphIsoMapCallback user_callback,
+		IndexMapSmall index_map_small, IndexMapLarge index_map_large,
+		const VertexOrderSmall& vertex_order_small,
+		EdgeEquivalencePredicate edge_comp,
+		VertexEquivalencePredicate vertex_comp,
+		PartialMapPredicate partial_map_comp) {
+	return detail::vf2_subgraph_morphism<detail::subgraph_mono>
+			(graph_small, graph_large,
+			user_callback,
+			index_map_small, index_map_large,
+			vertex_order_small,
+			edge_comp,
+			vertex_comp,
+			partial_map_comp);
 }
 
 
@@ -866,7 +906,8 @@ bool vf2_subgraph_iso(const GraphSmall& graph_small, const GraphLarge& graph_lar
 			index_map_small, index_map_large,
 			vertex_order_small,
 			edge_comp,
-			vertex_comp);
+			vertex_comp,
+			AlwaysTrue());
 }
 
 
@@ -0,0 +1,263 @@
+#ifndef JLA_BOOST_GRAPH_MORPHISM_FINDERS_VF2PP_HPP
+#define JLA_BOOST_GRAPH_MORPHISM_FINDERS_VF2PP_HPP
+
+#include <jla_boost/Functional.hpp>
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
+#include <jla_boost/graph/morphism/models/InvertibleAdaptor.hpp>
+#include <jla_boost/graph/morphism/models/Vector.hpp>
+
+#include <boost/graph/graph_traits.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+// A VF2++/RI-style search for monomorphisms and isomorphisms, as an alternative to vf2.hpp.
+// Before the search, the candidate domain of each domain vertex is computed as a bitset over the codomain vertices,
+// with the codomain vertices that satisfy the vertex predicate and have large enough degrees.
+// The domain vertices are then ordered such that each vertex has as many earlier neighbours as possible,
+// with ties broken by the smallest candidate domain, i.e., the rarest label, and then by the largest degree.
+// During the search the candidates for a vertex are the unused neighbours of the image of an earlier neighbour,
+// filtered by its candidate domain.
+// The graphs must not have parallel edges, and the vertex indices of both graphs must be in [0, num_vertices(g)).
+
+namespace jla_boost::GraphMorphism {
+namespace detail {
+
+// A set of the integers in [0, size), stored as 64-bit words.
+struct vf2pp_bitset_view {
+	static std::size_t num_words(std::size_t size) {
+		return (size + 63) / 64;
+	}
+
+	bool test(std::size_t i) const {
+		return (words[i / 64] >> (i % 64)) & 1;
+	}
+
+	void set(std::size_t i) const {
+		words[i / 64] |= std::uint64_t(1) << (i % 64);
+	}
+
+	void reset(std::size_t i) const {
+		words[i / 64] &= ~(std::uint64_t(1) << (i % 64));
+	}
+public:
+	std::uint64_t *words;
+};
+
+template<bool IsIso, typename GraphDom, typename GraphCodom,
+		typename EdgePred, typename VertexPred, typename PartialMapPred, typename Callback>
+struct vf2pp_state {
+	using VertexDom = typename boost::graph_traits<GraphDom>::vertex_descriptor;
+	using VertexCodom = typename boost::graph_traits<GraphCodom>::vertex_descriptor;
+	static constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+public:
+	vf2pp_state(const GraphDom &gDom, const GraphCodom &gCodom,
+	            EdgePred edgePred, VertexPred vertexPred, PartialMapPred partialMapPred, Callback callback)
+			: gDom(gDom), gCodom(gCodom), edgePred(edgePred), vertexPred(vertexPred),
+			  partialMapPred(partialMapPred), callback(callback),
+			  nDom(num_vertices(gDom)), nCodom(num_vertices(gCodom)),
+			  numWords(vf2pp_bitset_view::num_words(nCodom)),
+			  domainWords(nDom * numWords, 0), usedWords(numWords, 0),
+			  mapDom(gDom, gCodom), mapCodom(gCodom, gDom) {}
+
+	// Returns false if some domain vertex has no candidates.
+	bool compute_domains() {
+		verticesDom.resize(nDom);
+		for(const auto v : asRange(vertices(gDom)))
+			verticesDom[get(boost::vertex_index_t(), gDom, v)] = v;
+		domainSize.assign(nDom, 0);
+		for(std::size_t i = 0; i != nDom; ++i) {
+			const auto v = verticesDom[i];
+			const auto domain = get_domain(i);
+			for(const auto w : asRange(vertices(gCodom))) {
+				if(!degree_compatible(v, w)) continue;
+				if(!vertexPred(v, w)) continue;
+				domain.set(get(boost::vertex_index_t(), gCodom, w));
+				++domainSize[i];
+			}
+			if(domainSize[i] == 0) return false;
+		}
+		return true;
+	}
+
+	void compute_order() {
+		order.clear();
+		order.reserve(nDom);
+		parent.assign(nDom, none);
+		parentIsSource.assign(nDom, false);
+		std::vector<std::size_t> numOrderedNeighbours(nDom, 0);
+		std::vector<bool> ordered(nDom, false);
+		const auto totalDegree = [&](const VertexDom v) {
+			return out_degree(v, gDom) + (is_directed(gDom) ? in_degree(v, gDom) : 0);
+		};
+		const auto better = [&](const std::size_t a, const std::size_t b) {
+			if(numOrderedNeighbours[a] != numOrderedNeighbours[b])
+				return numOrderedNeighbours[a] > numOrderedNeighbours[b];
+			if(domainSize[a] != domainSize[b]) return domainSize[a] < domainSize[b];
+			return totalDegree(verticesDom[a]) > totalDegree(verticesDom[b]);
+		};
+		const auto visitNeighbour = [&](const std::size_t iOther, const std::size_t i, const bool iIsSource) {
+			if(ordered[iOther]) return;
+			if(numOrderedNeighbours[iOther] == 0) {
+				parent[iOther] = i;
+				parentIsSource[iOther] = iIsSource;
+			}
+			++numOrderedNeighbours[iOther];
+		};
+		while(order.size() != nDom) {
+			// the unordered vertices with no ordered neighbours start a new connected component
+			std::size_t best = none;
+			for(std::size_t i = 0; i != nDom; ++i)
+				if(!ordered[i] && (best == none || better(i, best)))
+					best = i;
+			order.push_back(best);
+			ordered[best] = true;
+			for(const auto e : asRange(out_edges(verticesDom[best], gDom)))
+				visitNeighbour(get(boost::vertex_index_t(), gDom, target(e, gDom)), best, true);
+			if(is_directed(gDom))
+				for(const auto e : asRange(in_edges(verticesDom[best], gDom)))
+					visitNeighbour(get(boost::vertex_index_t(), gDom, source(e, gDom)), best, false);
+		}
+	}
+
+	// Returns false if the callback asked to stop.
+	bool match(const std::size_t depth) {
+		if(depth == nDom) {
+			foundMatch = true;
+			return callback(makeInvertibleVertexMapAdaptor(std::cref(mapDom), std::cref(mapCodom)), gDom, gCodom);
+		}
+		const std::size_t i = order[depth];
+		const VertexDom v = verticesDom[i];
+		const auto tryCandidate = [&](const VertexCodom w) {
+			const auto wIdx = get(boost::vertex_index_t(), gCodom, w);
+			if(!get_domain(i).test(wIdx)) return true;
+			const auto used = vf2pp_bitset_view{usedWords.data()};
+			if(used.test(wIdx)) return true;
+			if(!feasible(v, w)) return true;
+			put(mapDom, gDom, gCodom, v, w);
+			put(mapCodom, gCodom, gDom, w, v);
+			used.set(wIdx);
+			const bool cont = match(depth + 1);
+			used.reset(wIdx);
+			put(mapCodom, gCodom, gDom, w, boost::graph_traits<GraphDom>::null_vertex());
+			put(mapDom, gDom, gCodom, v, boost::graph_traits<GraphCodom>::null_vertex());
+			return cont;
+		};
+		if(parent[i] == none) {
+			for(const auto w : asRange(vertices(gCodom)))
+				if(!tryCandidate(w)) return false;
+		} else {
+			const VertexCodom wParent = get(mapDom, gDom, gCodom, verticesDom[parent[i]]);
+			if(parentIsSource[i]) {
+				for(const auto e : asRange(out_edges(wParent, gCodom)))
+					if(!tryCandidate(target(e, gCodom))) return false;
+			} else {
+				for(const auto e : asRange(in_edges(wParent, gCodom)))
+					if(!tryCandidate(source(e, gCodom))) return false;
+			}
+		}
+		return true;
+	}
+private:
+	vf2pp_bitset_view get_domain(const std::size_t i) {
+		return vf2pp_bitset_view{domainWords.data() + i * numWords};
+	}
+
+	bool degree_compatible(const VertexDom v, const VertexCodom w) const {
+		if(IsIso) {
+			if(out_degree(v, gDom) != out_degree(w, gCodom)) return false;
+			if(is_directed(gDom) && in_degree(v, gDom) != in_degree(w, gCodom)) return false;
+		} else {
+			if(out_degree(v, gDom) > out_degree(w, gCodom)) return false;
+			if(is_directed(gDom) && in_degree(v, gDom) > in_degree(w, gCodom)) return false;
+		}
+		return true;
+	}
+
+	// Checks the edges from v to its mapped neighbours, and the partial map predicate.
+	bool feasible(const VertexDom v, const VertexCodom w) {
+		if(!partialMapPred(v, w, mapDom, gDom, gCodom)) return false;
+		for(const auto e : asRange(out_edges(v, gDom))) {
+			const auto u = target(e, gDom);
+			const auto wu = u == v ? w : get(mapDom, gDom, gCodom, u);
+			if(wu == boost::graph_traits<GraphCodom>::null_vertex()) continue;
+			const auto eCodom = edge(w, wu, gCodom);
+			if(!eCodom.second || !edgePred(e, eCodom.first)) return false;
+		}
+		if(is_directed(gDom)) {
+			for(const auto e : asRange(in_edges(v, gDom))) {
+				const auto u = source(e, gDom);
+				const auto wu = u == v ? w : get(mapDom, gDom, gCodom, u);
+				if(wu == boost::graph_traits<GraphCodom>::null_vertex()) continue;
+				const auto eCodom = edge(wu, w, gCodom);
+				if(!eCodom.second || !edgePred(e, eCodom.first)) return false;
+			}
+		}
+		return true;
+	}
+public:
+	const GraphDom &gDom;
+	const GraphCodom &gCodom;
+	EdgePred edgePred;
+	VertexPred vertexPred;
+	PartialMapPred partialMapPred;
+	Callback callback;
+	const std::size_t nDom, nCodom, numWords;
+	std::vector<VertexDom> verticesDom; // by index
+	std::vector<std::uint64_t> domainWords; // nDom rows of numWords words
+	std::vector<std::size_t> domainSize;
+	std::vector<std::uint64_t> usedWords; // the codomain vertices in the image
+	std::vector<std::size_t> order; // domain vertex indices
+	std::vector<std::size_t> parent; // the first ordered neighbour, or none
+	std::vector<bool> parentIsSource; // whether the parent is the source of the edge between them
+	VectorVertexMap<GraphDom, GraphCodom> mapDom;
+	VectorVertexMap<GraphCodom, GraphDom> mapCodom;
+	bool foundMatch = false;
+};
+
+template<bool IsIso, typename GraphDom, typename GraphCodom, typename Callback,
+		typename EdgePred, typename VertexPred, typename PartialMapPred>
+bool vf2pp_morphism(const GraphDom &gDom, const GraphCodom &gCodom, Callback callback,
+                    EdgePred edgePred, VertexPred vertexPred, PartialMapPred partialMapPred) {
+	if(IsIso) {
+		if(num_vertices(gDom) != num_vertices(gCodom)) return false;
+		if(num_edges(gDom) != num_edges(gCodom)) return false;
+	} else {
+		if(num_vertices(gDom) > num_vertices(gCodom)) return false;
+		if(num_edges(gDom) > num_edges(gCodom)) return false;
+	}
+	vf2pp_state<IsIso, GraphDom, GraphCodom, EdgePred, VertexPred, PartialMapPred, Callback>
+			s(gDom, gCodom, edgePred, vertexPred, partialMapPred, callback);
+	if(!s.compute_domains()) return false;
+	s.compute_order();
+	s.match(0);
+	return s.foundMatch;
+}
+
+} // namespace detail
+
+// Enumerates the monomorphisms from gDom to gCodom, until callback(m, gDom, gCodom) returns false.
+// Each candidate pair (v, w) is checked by vertexPred(v, w) when the candidate domains are computed,
+// and by partialMapPred(v, w, m, gDom, gCodom) during the search, where m is the current partial morphism
+// which does not contain v.
+// Returns true if a morphism was found.
+template<typename GraphDom, typename GraphCodom, typename Callback,
+		typename EdgePred, typename VertexPred, typename PartialMapPred = AlwaysTrue>
+bool vf2pp_subgraph_mono(const GraphDom &gDom, const GraphCodom &gCodom, Callback callback,
+                         EdgePred edgePred, VertexPred vertexPred, PartialMapPred partialMapPred = {}) {
+	return detail::vf2pp_morphism<false>(gDom, gCodom, callback, edgePred, vertexPred, partialMapPred);
+}
+
+// As vf2pp_subgraph_mono, but for isomorphisms.
+template<typename GraphDom, typename GraphCodom, typename Callback,
+		typename EdgePred, typename VertexPred, typename PartialMapPred = AlwaysTrue>
+bool vf2pp_graph_iso(const GraphDom &gDom, const GraphCodom &gCodom, Callback callback,
+                     EdgePred edgePred, VertexPred vertexPred, PartialMapPred partialMapPred = {}) {
+	return detail::vf2pp_morphism<true>(gDom, gCodom, callback, edgePred, vertexPred, partialMapPred);
+}
+
+} // namespace jla_boost::GraphMorphism
+
+#endif // JLA_BOOST_GRAPH_MORPHISM_FINDERS_VF2PP_HPP
@@ -437,6 +437,35 @@ void test_return_value() {
 	}
 }
 
+void test_partial_map_predicate() {
+	typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::bidirectionalS> Graph;
+	typedef boost::graph_traits<Graph>::vertex_descriptor Vertex;
+	Graph gSmall, gLarge;
+	for(int i = 0; i != 2; ++i) add_vertex(gSmall);
+	for(int i = 0; i != 3; ++i) add_vertex(gLarge);
+	int num_hits = 0;
+	const auto callback = [&num_hits](auto &&m, const Graph &gDom, const Graph &gCodom) {
+		BOOST_CHECK(get(m, gDom, gCodom, Vertex(0)) < get(m, gDom, gCodom, Vertex(1)));
+		++num_hits;
+		return true;
+	};
+	// only order-preserving maps, checked on the partial maps
+	const auto pred = [](Vertex v, Vertex w, const auto &m, const Graph &gDom, const Graph &gCodom) {
+		BOOST_CHECK(get(m, gDom, gCodom, v) == boost::graph_traits<Graph>::null_vertex());
+		for(const auto u : asRange(vertices(gDom))) {
+			const auto wU = get(m, gDom, gCodom, u);
+			if(wU == boost::graph_traits<Graph>::null_vertex()) continue;
+			if((u < v) != (wU < w)) return false;
+		}
+		return true;
+	};
+	bool exists = vf2_subgraph_mono(gSmall, gLarge, callback,
+	                                get(vertex_index, gSmall), get(vertex_index, gLarge),
+	                                vertex_order_by_mult(gSmall), AlwaysTrue(), AlwaysTrue(), pred);
+	BOOST_CHECK(exists);
+	BOOST_CHECK_EQUAL(num_hits, 3);
+}
+
 } // namespace test
 } // namespace jla_boost
 
@@ -445,4 +474,5 @@ BOOST_AUTO_TEST_CASE(test_main) {
 	test_vf2(0, nullptr);
 	test_empty_graph_cases();
 	test_return_value();
+	test_partial_map_predicate();
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
+#include <jla_boost/graph/morphism/finders/vf2.hpp>
+#include <jla_boost/graph/morphism/finders/vf2pp.hpp>
+
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/mcgregor_common_subgraphs.hpp>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <set>
+#include <vector>
+
+namespace jla_boost {
+namespace test {
+using namespace boost;
+namespace GM = jla_boost::GraphMorphism;
+using namespace GM;
+
+namespace {
+
+// Simple random graphs, i.e., without parallel edges, with vertex and edge names in [0, maxName].
+template<typename Graph>
+Graph make_random_graph(std::mt19937 &gen, int n, double edgeProbability, int maxName) {
+	Graph g(n);
+	std::uniform_real_distribution<double> distReal(0.0, 1.0);
+	std::uniform_int_distribution<int> distName(0, maxName);
+	for(const auto v : asRange(vertices(g)))
+		put(vertex_name_t(), g, v, distName(gen));
+	for(int u = 0; u != n; ++u) {
+		for(int v = is_directed(g) ? 0 : u + 1; v != n; ++v) {
+			if(u == v || distReal(gen) > edgeProbability) continue;
+			const auto e = add_edge(vertex(u, g), vertex(v, g), g).first;
+			put(edge_name_t(), g, e, distName(gen));
+		}
+	}
+	return g;
+}
+
+struct collect_callback {
+	template<typename VertexMap, typename GraphDom, typename GraphCodom>
+	bool operator()(VertexMap &&m, const GraphDom &gDom, const GraphCodom &gCodom) {
+		std::vector<std::size_t> image;
+		for(const auto v : asRange(vertices(gDom)))
+			image.push_back(get(m, gDom, gCodom, v));
+		morphisms->insert(image);
+		return true;
+	}
+public:
+	std::set<std::vector<std::size_t>> *morphisms;
+};
+
+template<typename Graph>
+void compare_with_vf2(bool iso) {
+	std::mt19937 gen(42);
+	for(int round = 0; round != 50; ++round) {
+		const int nCodom = 6 + round % 7;
+		const int nDom = iso ? nCodom : 2 + round % 5;
+		const Graph gCodom = make_random_graph<Graph>(gen, nCodom, 0.4, 2);
+		// for isomorphisms, the domain is a copy with permuted vertices
+		Graph gDom = iso ? Graph(nDom) : make_random_graph<Graph>(gen, nDom, 0.4, 2);
+		if(iso) {
+			std::vector<int> perm(nDom);
+			for(int i = 0; i != nDom; ++i) perm[i] = i;
+			std::shuffle(perm.begin(), perm.end(), gen);
+			for(int i = 0; i != nDom; ++i)
+				put(vertex_name_t(), gDom, vertex(perm[i], gDom), get(vertex_name_t(), gCodom, vertex(i, gCodom)));
+			for(const auto e : asRange(edges(gCodom))) {
+				const auto eDom = add_edge(vertex(perm[source(e, gCodom)], gDom),
+				                           vertex(perm[target(e, gCodom)], gDom), gDom).first;
+				put(edge_name_t(), gDom, eDom, get(edge_name_t(), gCodom, e));
+			}
+		}
+		const auto vertexPred = make_property_map_equivalent(get(vertex_name, gDom), get(vertex_name, gCodom));
+		const auto edgePred = make_property_map_equivalent(get(edge_name, gDom), get(edge_name, gCodom));
+
+		std::set<std::vector<std::size_t>> resVF2, resVF2PP;
+		const bool foundVF2 = iso
+		                      ? vf2_graph_iso(gDom, gCodom, collect_callback{&resVF2},
+		                                      get(vertex_index, gDom), get(vertex_index, gCodom),
+		                                      vertex_order_by_mult(gDom), edgePred, vertexPred)
+		                      : vf2_subgraph_mono(gDom, gCodom, collect_callback{&resVF2},
+		                                          get(vertex_index, gDom), get(vertex_index, gCodom),
+		                                          vertex_order_by_mult(gDom), edgePred, vertexPred);
+		const bool foundVF2PP = iso
+		                        ? vf2pp_graph_iso(gDom, gCodom, collect_callback{&resVF2PP}, edgePred, vertexPred)
+		                        : vf2pp_subgraph_mono(gDom, gCodom, collect_callback{&resVF2PP}, edgePred, vertexPred);
+		BOOST_CHECK_EQUAL(foundVF2, foundVF2PP);
+		BOOST_CHECK(resVF2 == resVF2PP);
+		if(iso) BOOST_CHECK(foundVF2PP);
+	}
+}
+
+struct stop_callback {
+	template<typename VertexMap, typename GraphDom, typename GraphCodom>
+	bool operator()(VertexMap &&, const GraphDom &, const GraphCodom &) {
+		++*count;
+		return false;
+	}
+public:
+	int *count;
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(test_vf2pp_mono_undirected) {
+	using Graph = adjacency_list<vecS, vecS, undirectedS,
+			property<vertex_name_t, int>, property<edge_name_t, int>>;
+	compare_with_vf2<Graph>(false);
+}
+
+BOOST_AUTO_TEST_CASE(test_vf2pp_mono_directed) {
+	using Graph = adjacency_list<vecS, vecS, bidirectionalS,
+			property<vertex_name_t, int>, property<edge_name_t, int>>;
+	compare_with_vf2<Graph>(false);
+}
+
+BOOST_AUTO_TEST_CASE(test_vf2pp_iso) {
+	using Graph = adjacency_list<vecS, vecS, undirectedS,
+			property<vertex_name_t, int>, property<edge_name_t, int>>;
+	compare_with_vf2<Graph>(true);
+}
+
+BOOST_AUTO_TEST_CASE(test_vf2pp_return_value) {
+	using Graph = adjacency_list<vecS, vecS, undirectedS>;
+	Graph gEmpty, gSmall(1), gLarge(2);
+	add_edge(0, 1, gLarge);
+	int count = 0;
+	// even empty matches are reported
+	BOOST_CHECK(vf2pp_subgraph_mono(gEmpty, gLarge, stop_callback{&count}, AlwaysTrue(), AlwaysTrue()));
+	BOOST_CHECK_EQUAL(count, 1);
+	// no morphism due to sizes
+	BOOST_CHECK(!vf2pp_graph_iso(gSmall, gLarge, stop_callback{&count}, AlwaysTrue(), AlwaysTrue()));
+	BOOST_CHECK(!vf2pp_subgraph_mono(gLarge, gSmall, stop_callback{&count}, AlwaysTrue(), AlwaysTrue()));
+	// no morphism due to vertex mismatches
+	BOOST_CHECK(!vf2pp_subgraph_mono(gSmall, gLarge, stop_callback{&count}, AlwaysTrue(), AlwaysFalse()));
+	BOOST_CHECK_EQUAL(count, 1);
+	// stop after the first hit
+	BOOST_CHECK(vf2pp_subgraph_mono(gSmall, gLarge, stop_callback{&count}, AlwaysTrue(), AlwaysTrue()));
+	BOOST_CHECK_EQUAL(count, 2);
+	// the partial map predicate rejects mapping the second vertex
+	const auto rejectSecond = [](auto v, auto w, const auto &m, const auto &gDom, const auto &gCodom) {
+		for(const auto u : asRange(vertices(gDom)))
+			if(u != v && get(m, gDom, gCodom, u) != graph_traits<Graph>::null_vertex())
+				return false;
+		return true;
+	};
+	BOOST_CHECK(!vf2pp_graph_iso(gLarge, gLarge, stop_callback{&count}, AlwaysTrue(), AlwaysTrue(), rejectSecond));
+	BOOST_CHECK_EQUAL(count, 2);
+}
+
+} // namespace test
+} // namespace jla_boost
@@ -271,6 +271,11 @@ struct Config {
 	enum class IsomorphismAlg {
 		VF2, Canon, SmilesCanonVF2
 	};
+	// The search used for finding monomorphisms and isomorphisms, see graph.morphismFinder.
+	// VF2PP is a VF2++-style search that orders the vertices by the rarity of their labels.
+	enum class MorphismFinder {
+		VF2, VF2PP
+	};
 
 	Config() = default;
 	Config(Config &&) = delete;
@@ -302,6 +307,11 @@ struct Config {
         ((bool, applyAssumeConfluence, false))                                      \
         ((int, applyLimit, -1))                                                     \
         ((bool, doRuleIsomorphismDuringBinding, true))                              \
+        ((bool, directRuleApplication, true))                                       \
+        ((bool, dumpAsJson, false))                                                 \
+        ((bool, repeatKeepOnlyLastRounds, false))                                   \
+        ((bool, collectStats, false))                                               \
+        ((unsigned int, componentMatchCacheSize, 65536))                            \
     ))                                                                              \
     ((Graph, graph,                                                                 \
         ((bool, smilesCheckAST, false))                                             \
@@ -311,6 +321,7 @@ struct Config {
         ((bool, checkIsoInPermutation, false))                                      \
         ((unsigned long, numIsomorphismCalls, 0))                                   \
         ((bool, vf2UseOrigVertexOrder, true))                                       \
+        ((mod::Config::MorphismFinder, morphismFinder, mod::Config::MorphismFinder::VF2)) \
         ((bool, printVariablesAsMath, false))                                       \
     ))                                                                              \
     ((Rule, rule,                                                                   \
@@ -328,6 +339,7 @@ struct Config {
         ((bool, printMatchesOnlyHaxChem, false))                                    \
         ((int, componentWiseMorphismLimit, 0))                                      \
         ((bool, useBoostCommonSubgraph, false))                                     \
+        ((bool, useComponentFingerprints, true))                                    \
     ))
 
 #define MOD_CONFIG_nsIter(rNS, dataNS, tNS)                                           \
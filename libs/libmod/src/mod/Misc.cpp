@@ -3,6 +3,7 @@
 #include <mod/BuildConfig.hpp>
 #include <mod/graph/Graph.hpp>
 #include <mod/lib/DG/Hyper.hpp>
+#include <mod/lib/DG/IO/BinaryDump.hpp>
 #include <mod/lib/Graph/Graph.hpp>
 #include <mod/lib/Graph/Properties/Molecule.hpp>
 #include <mod/lib/IO/IO.hpp>
@@ -34,9 +35,16 @@ double rngUniformReal() {
 
 std::string strFromDump(const std::string &file) {
 	boost::iostreams::mapped_file_source ifs(file);
-	std::vector<std::uint8_t> data(ifs.begin(), ifs.end());
 	std::ostringstream err;
-	auto jOpt = lib::IO::readJson(data, err);
+	std::optional<nlohmann::json> jOpt;
+	if(lib::DG::BinaryDump::isBinaryDump(ifs.begin(), ifs.end())) {
+		ifs.close();
+		const auto dump = lib::DG::BinaryDump::Reader::open(file, err);
+		if(dump) jOpt = dump->toJson(err);
+	} else {
+		std::vector<std::uint8_t> data(ifs.begin(), ifs.end());
+		jOpt = lib::IO::readJson(data, err);
+	}
 	if(!jOpt)
 		throw InputError("Error showing dump: " + err.str());
 	std::stringstream ss;
@@ -22,6 +22,7 @@ void command(const std::string &line) {
 
 void flushCommands() {
 	lib::IO::post() << std::flush;
+	lib::IO::clearDeduplicated();
 }
 
 void disableCommands() {
@@ -199,6 +199,13 @@ void ExecuteResult::list(bool withUniverse) const {
 	p->res.list(withUniverse);
 }
 
+std::string ExecuteResult::getStatsJson() const {
+	const auto *stats = p->res.getStats();
+	if(!stats)
+		throw LogicError("No statistics were collected for this execution. Enable it with getConfig().dg.collectStats before executing the strategy.");
+	return stats->toJson().dump();
+}
+
 // -----------------------------------------------------------------------------
 
 struct AddAbstractResult::Pimpl {
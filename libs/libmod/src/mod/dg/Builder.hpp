@@ -215,6 +215,25 @@ public:
 	// rst:		Output information from the execution of the strategy.
 	// rst:		The universe lists can be rather long so with `withUniverse == false` they are omitted.
 	void list(bool withUniverse) const;
+	// rst: .. function:: std::string getStatsJson() const
+	// rst:
+	// rst:		:returns: a JSON object with statistics for the execution of the strategy.
+	// rst:			It has the keys ``time`` (the total time in seconds), ``vf2`` (the number of VF2 ``calls``
+	// rst:			and the number of tried ``candidatePairs``, i.e., search-tree nodes),
+	// rst:			``componentMatchCache`` (the ``hits``, ``misses``, and ``evictions`` in the cache of component matches
+	// rst:			of the derivation graph, see :cpp:expr:`getConfig().dg.componentMatchCacheSize`),
+	// rst:			and ``rules``, a list with an entry for each rule used by a rule strategy.
+	// rst:			Each entry has the ``name`` of the rule, the number of ``executions``,
+	// rst:			the ``vf2`` searches done by them, the number of ``compositions`` done during graph binding,
+	// rst:			the number of ``boundRules`` ``created`` and discarded as ``duplicates``,
+	// rst:			the number of products found (``hits``) or not found (``misses``) by the ``checkIfNew`` lookups
+	// rst:			in the graph database, the number of derivations rejected by ``left`` and ``right``
+	// rst:			``predicateRejections``, the number of accepted ``derivations``,
+	// rst:			and the ``time`` in seconds spent in ``total`` and constructing the ``products``.
+	// rst:		:throws: :class:`LogicError` if the statistics were not collected,
+	// rst:			i.e., if :cpp:expr:`getConfig().dg.collectStats` was `false` when the strategy was executed.
+	// rst:			When disabled, which is the default, the collection has no noticeable overhead.
+	std::string getStatsJson() const;
 private:
 	struct Pimpl;
 	std::unique_ptr<Pimpl> p;
@@ -10,6 +10,7 @@
 #include <mod/lib/DG/NonHyperBuilder.hpp>
 #include <mod/lib/DG/Strategies/GraphState.hpp>
 #include <mod/lib/DG/Strategies/Strategy.hpp>
+#include <mod/lib/DG/IO/BinaryDump.hpp>
 #include <mod/lib/DG/IO/Read.hpp>
 #include <mod/lib/DG/IO/Write.hpp>
 #include <mod/lib/Graph/Graph.hpp>
@@ -196,19 +197,21 @@ std::string DG::dump() const {
 
 std::string DG::dump(const std::string &filename) const {
 	if(!isLocked()) throw LogicError("Can not dump DG before it is locked.");
-	if(filename.empty()) {
-		std::string name = lib::IO::makeUniqueFilePrefix() + "DG.dg";
+	const std::string name = filename.empty() ? lib::IO::makeUniqueFilePrefix() + "DG.dg" : filename;
+	if(getConfig().dg.dumpAsJson)
 		lib::IO::writeJsonFile(name, lib::DG::Write::dumpToJson(getNonHyper()));
-		return name;
-	} else {
-		lib::IO::writeJsonFile(filename, lib::DG::Write::dumpToJson(getNonHyper()));
-		return filename;
-	}
+	else
+		lib::DG::BinaryDump::write(getNonHyper(), name);
+	return name;
 }
 
 void DG::listStats() const {
 	if(!isLocked()) throw LogicError("No stats can be printed before calculation.");
-	else p->dg->getHyper().printStats(std::cout);
+	p->dg->getHyper().printStats(std::cout);
+	if(const auto *builder = dynamic_cast<const lib::DG::NonHyperBuilder *>(p->dg.get())) {
+		builder->getComponentMatchCache().printStats(std::cout);
+		std::cout << "------------------------------------------------------------------" << std::endl;
+	}
 }
 
 //------------------------------------------------------------------------------
@@ -161,6 +161,8 @@ public:
 	// rst:
 	// rst:		Exports the derivation graph to a file, including associated graphs and rules.
 	// rst:		Use :func:`load` or :func:`Builder::load` to import the derivation graph again.
+	// rst:		The dump is written in a compact binary format, unless ``getConfig().dg.dumpAsJson`` is set,
+	// rst:		in which case the older JSON-based format is used. Both formats can be loaded.
 	// rst:
 	// rst:		:param filename: the name of the file to save the dump to.
 	// rst:			If non is given an auto-generated name in the ``out/`` folder is used.
@@ -172,7 +174,8 @@ public:
 	std::string dump(const std::string &filename) const;
 	// rst: .. function:: void listStats() const
 	// rst: 
-	// rst:		Output various stats of the derivation graph.
+	// rst:		Output various stats of the derivation graph,
+	// rst:		including the index of the graph database and the cache of component matches.
 	// rst:
 	// rst:		:throws: :class:`LogicError` if the DG has not been calculated.
 	void listStats() const;
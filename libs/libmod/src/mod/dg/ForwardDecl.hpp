@@ -8,6 +8,8 @@ struct AddAbstractResult;
 struct Builder;
 struct DG;
 struct ExecuteResult;
+struct GraphPredicate;
+struct GraphValue;
 struct PrintData;
 struct Printer;
 struct Strategy;
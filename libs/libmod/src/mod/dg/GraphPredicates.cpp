@@ -0,0 +1,192 @@
+#include "GraphPredicates.hpp"
+
+#include <mod/Error.hpp>
+#include <mod/graph/Graph.hpp>
+#include <mod/lib/DG/GraphPredicates.hpp>
+
+#include <cassert>
+#include <ostream>
+
+namespace mod::dg {
+namespace GP = lib::DG::GraphPredicates;
+
+namespace {
+
+GP::Graphs toLib(const std::vector<std::shared_ptr<graph::Graph>> &gs) {
+	GP::Graphs res;
+	res.reserve(gs.size());
+	for(const auto &g : gs) {
+		if(!g) throw LogicError("One of the graphs is a null pointer.");
+		res.push_back(&g->getGraph());
+	}
+	return res;
+}
+
+GraphValue makeValue(GP::Quantity quantity, const std::string &label = "") {
+	return GraphValue(std::make_shared<const GP::Value>(quantity, label));
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// GraphValue
+//------------------------------------------------------------------------------
+
+GraphValue::GraphValue(std::shared_ptr<const lib::DG::GraphPredicates::Value> v) : v(std::move(v)) {
+	assert(this->v);
+}
+
+std::ostream &operator<<(std::ostream &s, const GraphValue &v) {
+	return s << *v.v;
+}
+
+double GraphValue::operator()(std::shared_ptr<graph::Graph> g) const {
+	if(!g) throw LogicError("The graph is a null pointer.");
+	return (*v)(g->getGraph());
+}
+
+double GraphValue::operator()(const std::vector<std::shared_ptr<graph::Graph>> &gs) const {
+	return (*v)(toLib(gs));
+}
+
+const std::shared_ptr<const lib::DG::GraphPredicates::Value> &GraphValue::getValue() const {
+	return v;
+}
+
+GraphValue GraphValue::numVertices() {
+	return makeValue(GP::Quantity::NumVertices);
+}
+
+GraphValue GraphValue::numEdges() {
+	return makeValue(GP::Quantity::NumEdges);
+}
+
+GraphValue GraphValue::numComponents() {
+	return makeValue(GP::Quantity::NumComponents);
+}
+
+GraphValue GraphValue::numRings() {
+	return makeValue(GP::Quantity::NumRings);
+}
+
+GraphValue GraphValue::vertexLabelCount(const std::string &label) {
+	return makeValue(GP::Quantity::VertexLabelCount, label);
+}
+
+GraphValue GraphValue::edgeLabelCount(const std::string &label) {
+	return makeValue(GP::Quantity::EdgeLabelCount, label);
+}
+
+GraphValue GraphValue::exactMass() {
+	return makeValue(GP::Quantity::ExactMass);
+}
+
+GraphValue GraphValue::charge() {
+	return makeValue(GP::Quantity::Charge);
+}
+
+GraphValue GraphValue::numChargedVertices() {
+	return makeValue(GP::Quantity::NumChargedVertices);
+}
+
+GraphValue GraphValue::numRadicals() {
+	return makeValue(GP::Quantity::NumRadicals);
+}
+
+GraphValue GraphValue::energy() {
+	return makeValue(GP::Quantity::Energy);
+}
+
+GraphValue GraphValue::massDistance(std::shared_ptr<graph::Graph> target) {
+	if(!target) throw LogicError("The target is a null pointer.");
+	return GraphValue(std::make_shared<const GP::Value>(GP::Quantity::MassDistance, target->getGraph()));
+}
+
+GraphValue GraphValue::vertexLabelDistance(std::shared_ptr<graph::Graph> target) {
+	if(!target) throw LogicError("The target is a null pointer.");
+	return GraphValue(std::make_shared<const GP::Value>(GP::Quantity::VertexLabelDistance, target->getGraph()));
+}
+
+GraphPredicate operator<(const GraphValue &v, double c) {
+	return GraphPredicate(GP::makeCompare(*v.v, GP::Relation::Less, c));
+}
+
+GraphPredicate operator<=(const GraphValue &v, double c) {
+	return GraphPredicate(GP::makeCompare(*v.v, GP::Relation::LessEqual, c));
+}
+
+GraphPredicate operator>(const GraphValue &v, double c) {
+	return GraphPredicate(GP::makeCompare(*v.v, GP::Relation::Greater, c));
+}
+
+GraphPredicate operator>=(const GraphValue &v, double c) {
+	return GraphPredicate(GP::makeCompare(*v.v, GP::Relation::GreaterEqual, c));
+}
+
+GraphPredicate operator==(const GraphValue &v, double c) {
+	return GraphPredicate(GP::makeCompare(*v.v, GP::Relation::Equal, c));
+}
+
+GraphPredicate operator!=(const GraphValue &v, double c) {
+	return GraphPredicate(GP::makeCompare(*v.v, GP::Relation::NotEqual, c));
+}
+
+//------------------------------------------------------------------------------
+// GraphPredicate
+//------------------------------------------------------------------------------
+
+GraphPredicate::GraphPredicate(std::shared_ptr<const lib::DG::GraphPredicates::Predicate> p) : p(std::move(p)) {
+	assert(this->p);
+}
+
+std::ostream &operator<<(std::ostream &s, const GraphPredicate &p) {
+	p.p->print(s);
+	return s;
+}
+
+bool GraphPredicate::operator()(std::shared_ptr<graph::Graph> g) const {
+	if(!g) throw LogicError("The graph is a null pointer.");
+	return (*p)(GP::Graphs{&g->getGraph()});
+}
+
+bool GraphPredicate::operator()(const std::vector<std::shared_ptr<graph::Graph>> &gs) const {
+	return (*p)(toLib(gs));
+}
+
+const std::shared_ptr<const lib::DG::GraphPredicates::Predicate> &GraphPredicate::getPredicate() const {
+	return p;
+}
+
+GraphPredicate GraphPredicate::makeAnd(const GraphPredicate &l, const GraphPredicate &r) {
+	return GraphPredicate(GP::makeAnd(l.p, r.p));
+}
+
+GraphPredicate GraphPredicate::makeOr(const GraphPredicate &l, const GraphPredicate &r) {
+	return GraphPredicate(GP::makeOr(l.p, r.p));
+}
+
+GraphPredicate GraphPredicate::makeNot(const GraphPredicate &p) {
+	return GraphPredicate(GP::makeNot(p.p));
+}
+
+GraphPredicate operator&&(const GraphPredicate &l, const GraphPredicate &r) {
+	return GraphPredicate::makeAnd(l, r);
+}
+
+GraphPredicate operator||(const GraphPredicate &l, const GraphPredicate &r) {
+	return GraphPredicate::makeOr(l, r);
+}
+
+GraphPredicate operator!(const GraphPredicate &p) {
+	return GraphPredicate::makeNot(p);
+}
+
+GraphPredicate GraphPredicate::makeAll(const GraphPredicate &p) {
+	return GraphPredicate(GP::makeAll(p.p));
+}
+
+GraphPredicate GraphPredicate::makeAny(const GraphPredicate &p) {
+	return GraphPredicate(GP::makeAny(p.p));
+}
+
+} // namespace mod::dg
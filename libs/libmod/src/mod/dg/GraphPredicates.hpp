@@ -0,0 +1,174 @@
+#ifndef MOD_DG_GRAPHPREDICATES_HPP
+#define MOD_DG_GRAPHPREDICATES_HPP
+
+#include <mod/BuildConfig.hpp>
+#include <mod/graph/ForwardDecl.hpp>
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mod::lib::DG::GraphPredicates {
+struct Predicate;
+struct Value;
+} // namespace mod::lib::DG::GraphPredicates
+namespace mod::dg {
+struct GraphPredicate;
+
+// rst: Native predicates on graphs and on the sides of derivations, for use with
+// rst: :cpp:func:`Strategy::makeFilter`, :cpp:func:`Strategy::makeLeftPredicate`,
+// rst: and :cpp:func:`Strategy::makeRightPredicate`.
+// rst: They are evaluated entirely in the library, and the per-graph values are computed only once for each graph,
+// rst: so they are much cheaper than equivalent predicates given as general function objects.
+// rst:
+// rst: A predicate is built by comparing a :class:`GraphValue` with a number,
+// rst: and combining such comparisons, e.g., ``GraphValue::vertexLabelCount("C") <= 7 && GraphValue::charge() == 0``.
+// rst:
+
+// rst-class: dg::GraphValue
+// rst:
+// rst:		A quantity of a multiset of graphs, e.g., a side of a derivation.
+// rst:		The value of a multiset is the sum of the values of its graphs,
+// rst:		and a single graph is evaluated as a multiset with only that graph.
+// rst:		The chemical quantities are determined from the decoded vertex labels, as for :cpp:func:`graph::Graph::getExactMass`.
+// rst:
+// rst-class-start:
+struct MOD_DECL GraphValue {
+	explicit GraphValue(std::shared_ptr<const lib::DG::GraphPredicates::Value> v);
+	MOD_DECL friend std::ostream &operator<<(std::ostream &s, const GraphValue &v);
+	// rst: .. function:: double operator()(std::shared_ptr<graph::Graph> g) const
+	// rst:               double operator()(const std::vector<std::shared_ptr<graph::Graph>> &gs) const
+	// rst:
+	// rst:		:returns: the value of the given graph or multiset of graphs.
+	// rst:		:throws: :class:`LogicError` if a graph is a null pointer.
+	double operator()(std::shared_ptr<graph::Graph> g) const;
+	double operator()(const std::vector<std::shared_ptr<graph::Graph>> &gs) const;
+	const std::shared_ptr<const lib::DG::GraphPredicates::Value> &getValue() const;
+public:
+	// rst: .. function:: static GraphValue numVertices()
+	// rst:               static GraphValue numEdges()
+	// rst:
+	// rst:		:returns: the number of vertices, respectively edges.
+	static GraphValue numVertices();
+	static GraphValue numEdges();
+	// rst: .. function:: static GraphValue numComponents()
+	// rst:
+	// rst:		:returns: the number of connected components, i.e., the number of graphs.
+	static GraphValue numComponents();
+	// rst: .. function:: static GraphValue numRings()
+	// rst:
+	// rst:		:returns: the cycle rank, i.e., the number of independent cycles.
+	static GraphValue numRings();
+	// rst: .. function:: static GraphValue vertexLabelCount(const std::string &label)
+	// rst:               static GraphValue edgeLabelCount(const std::string &label)
+	// rst:
+	// rst:		:returns: the number of vertices, respectively edges, with the given string label.
+	static GraphValue vertexLabelCount(const std::string &label);
+	static GraphValue edgeLabelCount(const std::string &label);
+	// rst: .. function:: static GraphValue exactMass()
+	// rst:
+	// rst:		:returns: the exact mass, which is NaN for graphs which are not molecules.
+	// rst:			Therefore all comparisons of it are false for such graphs, including ``!=``.
+	static GraphValue exactMass();
+	// rst: .. function:: static GraphValue charge()
+	// rst:
+	// rst:		:returns: the total charge.
+	static GraphValue charge();
+	// rst: .. function:: static GraphValue numChargedVertices()
+	// rst:
+	// rst:		:returns: the number of vertices with non-zero charge.
+	static GraphValue numChargedVertices();
+	// rst: .. function:: static GraphValue numRadicals()
+	// rst:
+	// rst:		:returns: the number of vertices with a radical.
+	static GraphValue numRadicals();
+	// rst: .. function:: static GraphValue energy()
+	// rst:
+	// rst:		:returns: the energy as given by :cpp:func:`graph::Graph::getEnergy`, which is NaN for graphs which are not molecules.
+	// rst:			The energy is computed with Open Babel, unless it has been cached on the graph.
+	static GraphValue energy();
+	// rst: .. function:: static GraphValue massDistance(std::shared_ptr<graph::Graph> target)
+	// rst:               static GraphValue vertexLabelDistance(std::shared_ptr<graph::Graph> target)
+	// rst:
+	// rst:		Heuristic distances to a target graph, e.g., for scoring in :cpp:func:`Strategy::makeBestFirst`.
+	// rst:		The mass distance is the absolute difference of the exact masses, and thus NaN if one of the graphs is not a molecule.
+	// rst:		The vertex label distance is the number of vertex labels to add or remove from the multiset of vertex labels of a graph
+	// rst:		to obtain the multiset of the target.
+	// rst:
+	// rst:		:returns: the distance of a graph to `target`.
+	// rst:		:throws: :class:`LogicError` if `target` is a null pointer.
+	static GraphValue massDistance(std::shared_ptr<graph::Graph> target);
+	static GraphValue vertexLabelDistance(std::shared_ptr<graph::Graph> target);
+public:
+	// rst: .. function:: friend GraphPredicate operator<(const GraphValue &v, double c)
+	// rst:               friend GraphPredicate operator<=(const GraphValue &v, double c)
+	// rst:               friend GraphPredicate operator>(const GraphValue &v, double c)
+	// rst:               friend GraphPredicate operator>=(const GraphValue &v, double c)
+	// rst:               friend GraphPredicate operator==(const GraphValue &v, double c)
+	// rst:               friend GraphPredicate operator!=(const GraphValue &v, double c)
+	// rst:
+	// rst:		:returns: the predicate comparing the value with `c`.
+	MOD_DECL friend GraphPredicate operator<(const GraphValue &v, double c);
+	MOD_DECL friend GraphPredicate operator<=(const GraphValue &v, double c);
+	MOD_DECL friend GraphPredicate operator>(const GraphValue &v, double c);
+	MOD_DECL friend GraphPredicate operator>=(const GraphValue &v, double c);
+	MOD_DECL friend GraphPredicate operator==(const GraphValue &v, double c);
+	MOD_DECL friend GraphPredicate operator!=(const GraphValue &v, double c);
+private:
+	std::shared_ptr<const lib::DG::GraphPredicates::Value> v;
+};
+// rst-class-end:
+
+// rst-class: dg::GraphPredicate
+// rst:
+// rst:		An immutable predicate on a multiset of graphs.
+// rst:		Copies share the underlying representation.
+// rst:
+// rst-class-start:
+struct MOD_DECL GraphPredicate {
+	explicit GraphPredicate(std::shared_ptr<const lib::DG::GraphPredicates::Predicate> p);
+	// rst: .. function:: friend std::ostream &operator<<(std::ostream &s, const GraphPredicate &p)
+	MOD_DECL friend std::ostream &operator<<(std::ostream &s, const GraphPredicate &p);
+	// rst: .. function:: bool operator()(std::shared_ptr<graph::Graph> g) const
+	// rst:               bool operator()(const std::vector<std::shared_ptr<graph::Graph>> &gs) const
+	// rst:
+	// rst:		:returns: whether the predicate holds for the given graph or multiset of graphs.
+	// rst:		:throws: :class:`LogicError` if a graph is a null pointer.
+	bool operator()(std::shared_ptr<graph::Graph> g) const;
+	bool operator()(const std::vector<std::shared_ptr<graph::Graph>> &gs) const;
+	const std::shared_ptr<const lib::DG::GraphPredicates::Predicate> &getPredicate() const;
+public:
+	// rst: .. function:: static GraphPredicate makeAnd(const GraphPredicate &l, const GraphPredicate &r)
+	// rst:               static GraphPredicate makeOr(const GraphPredicate &l, const GraphPredicate &r)
+	// rst:               static GraphPredicate makeNot(const GraphPredicate &p)
+	// rst:               friend GraphPredicate operator&&(const GraphPredicate &l, const GraphPredicate &r)
+	// rst:               friend GraphPredicate operator||(const GraphPredicate &l, const GraphPredicate &r)
+	// rst:               friend GraphPredicate operator!(const GraphPredicate &p)
+	// rst:
+	// rst:		:returns: the conjunction, disjunction, respectively negation, of the given predicates.
+	// rst:			The operators are not short-circuiting when building the predicate,
+	// rst:			but the evaluation of the resulting predicate is.
+	static GraphPredicate makeAnd(const GraphPredicate &l, const GraphPredicate &r);
+	static GraphPredicate makeOr(const GraphPredicate &l, const GraphPredicate &r);
+	static GraphPredicate makeNot(const GraphPredicate &p);
+	MOD_DECL friend GraphPredicate operator&&(const GraphPredicate &l, const GraphPredicate &r);
+	MOD_DECL friend GraphPredicate operator||(const GraphPredicate &l, const GraphPredicate &r);
+	MOD_DECL friend GraphPredicate operator!(const GraphPredicate &p);
+	// rst: .. function:: static GraphPredicate makeAll(const GraphPredicate &p)
+	// rst:               static GraphPredicate makeAny(const GraphPredicate &p)
+	// rst:
+	// rst:		:returns: a predicate which holds for a multiset of graphs if `p` holds for each graph,
+	// rst:			respectively for some graph, on its own.
+	// rst:			E.g., ``makeAll(GraphValue::vertexLabelCount("C") <= 7)`` on the right side of a derivation
+	// rst:			bounds the number of carbon atoms in each product, instead of in all products together.
+	static GraphPredicate makeAll(const GraphPredicate &p);
+	static GraphPredicate makeAny(const GraphPredicate &p);
+private:
+	std::shared_ptr<const lib::DG::GraphPredicates::Predicate> p;
+};
+// rst-class-end:
+
+} // namespace mod::dg
+
+#endif // MOD_DG_GRAPHPREDICATES_HPP
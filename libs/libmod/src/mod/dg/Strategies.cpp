@@ -1,9 +1,12 @@
 #include "Strategies.hpp"
 
 #include <mod/Error.hpp>
+#include <mod/dg/GraphPredicates.hpp>
 #include <mod/rule/Rule.hpp>
+#include <mod/lib/DG/GraphPredicates.hpp>
 #include <mod/lib/DG/Strategies/Strategy.hpp>
 #include <mod/lib/DG/Strategies/Add.hpp>
+#include <mod/lib/DG/Strategies/BestFirst.hpp>
 #include <mod/lib/DG/Strategies/DerivationPredicates.hpp>
 #include <mod/lib/DG/Strategies/Execute.hpp>
 #include <mod/lib/DG/Strategies/Filter.hpp>
@@ -124,6 +127,10 @@ std::shared_ptr<Strategy> Strategy::makeFilter(
 	return std::make_unique<Strategy>(std::make_unique<lib::DG::Strategies::Filter>(filterFunc, alsoUniverse));
 }
 
+std::shared_ptr<Strategy> Strategy::makeFilter(bool alsoUniverse, const GraphPredicate &filterPred) {
+	return makeFilter(alsoUniverse, lib::DG::GraphPredicates::makeFilterFunction(filterPred.getPredicate()));
+}
+
 std::shared_ptr<Strategy>
 Strategy::makeExecute(std::shared_ptr<mod::Function<void(const Strategy::GraphState &)>> func) {
 	if(!func) throw LogicError("The callback is a null pointer.");
@@ -144,6 +151,12 @@ Strategy::makeLeftPredicate(std::shared_ptr<mod::Function<bool(const mod::Deriva
 			std::make_unique<lib::DG::Strategies::LeftPredicate>(predicate, strategy->getStrategy().clone()));
 }
 
+std::shared_ptr<Strategy>
+Strategy::makeLeftPredicate(const GraphPredicate &predicate, std::shared_ptr<Strategy> strategy) {
+	return makeLeftPredicate(lib::DG::GraphPredicates::makeDerivationFunction(predicate.getPredicate(), false),
+	                         strategy);
+}
+
 std::shared_ptr<Strategy>
 Strategy::makeRightPredicate(std::shared_ptr<mod::Function<bool(const mod::Derivation &)>> predicate,
                              std::shared_ptr<Strategy> strategy) {
@@ -153,6 +166,12 @@ Strategy::makeRightPredicate(std::shared_ptr<mod::Function<bool(const mod::Deriv
 			std::make_unique<lib::DG::Strategies::RightPredicate>(predicate, strategy->getStrategy().clone()));
 }
 
+std::shared_ptr<Strategy>
+Strategy::makeRightPredicate(const GraphPredicate &predicate, std::shared_ptr<Strategy> strategy) {
+	return makeRightPredicate(lib::DG::GraphPredicates::makeDerivationFunction(predicate.getPredicate(), true),
+	                          strategy);
+}
+
 std::shared_ptr<Strategy> Strategy::makeRevive(std::shared_ptr<Strategy> strategy) {
 	if(!strategy) throw LogicError("The substrategy is a null pointer.");
 	return std::make_unique<Strategy>(std::make_unique<lib::DG::Strategies::Revive>(strategy->getStrategy().clone()));
@@ -165,4 +184,33 @@ std::shared_ptr<Strategy> Strategy::makeRepeat(int limit, std::shared_ptr<Strate
 			std::make_unique<lib::DG::Strategies::Repeat>(strategy->getStrategy().clone(), limit));
 }
 
+std::shared_ptr<Strategy>
+Strategy::makeBestFirst(std::shared_ptr<Function<double(std::shared_ptr<graph::Graph>)>> score,
+                        std::shared_ptr<Strategy> strategy, const std::vector<std::shared_ptr<graph::Graph>> &targets,
+                        int maxExpansions, int maxVertices, int maxDerivations, double timeLimit) {
+	if(!score) throw LogicError("The score is a null pointer.");
+	if(!strategy) throw LogicError("The substrategy is a null pointer.");
+	for(const auto &g: targets)
+		if(!g) throw LogicError("One of the targets is a null pointer.");
+	if(maxExpansions < 0) throw LogicError("maxExpansions must be non-negative.");
+	if(maxVertices < 0) throw LogicError("maxVertices must be non-negative.");
+	if(maxDerivations < 0) throw LogicError("maxDerivations must be non-negative.");
+	if(!(timeLimit >= 0)) throw LogicError("timeLimit must be non-negative.");
+	lib::DG::Strategies::BestFirst::Limits limits;
+	limits.maxExpansions = maxExpansions;
+	limits.maxVertices = maxVertices;
+	limits.maxDerivations = maxDerivations;
+	limits.timeLimit = timeLimit;
+	return std::make_unique<Strategy>(std::make_unique<lib::DG::Strategies::BestFirst>(
+			strategy->getStrategy().clone(), score, targets, limits));
+}
+
+std::shared_ptr<Strategy>
+Strategy::makeBestFirst(const GraphValue &score,
+                        std::shared_ptr<Strategy> strategy, const std::vector<std::shared_ptr<graph::Graph>> &targets,
+                        int maxExpansions, int maxVertices, int maxDerivations, double timeLimit) {
+	return makeBestFirst(lib::DG::GraphPredicates::makeValueFunction(score.getValue()), strategy, targets,
+	                     maxExpansions, maxVertices, maxDerivations, timeLimit);
+}
+
 } // namespace mod::dg
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <mod/BuildConfig.hpp>
 #include <mod/dg/DG.hpp>
+#include <mod/dg/ForwardDecl.hpp>
 #include <mod/dg/GraphInterface.hpp>
 #include <mod/rule/ForwardDecl.hpp>
 
@@ -101,6 +102,12 @@ public:
 	                                            std::shared_ptr<Function<bool(std::shared_ptr<graph::Graph>,
 	                                                                          const Strategy::GraphState &,
 	                                                                          bool)>> filterFunc);
+	// rst: .. function:: static std::shared_ptr<Strategy> makeFilter(bool alsoUniverse, const GraphPredicate &filterPred)
+	// rst:
+	// rst:		As the other overload, but with a native predicate evaluated on each graph on its own.
+	// rst:
+	// rst:		:returns: a :ref:`strat-filterUniverse` strategy if `alsoUniverse` is `true`, otherwise a :ref:`strat-filterSubset` strategy.
+	static std::shared_ptr<Strategy> makeFilter(bool alsoUniverse, const GraphPredicate &filterPred);
 	// rst: .. function:: static std::shared_ptr<Strategy> makeExecute(std::shared_ptr<Function<void(const Strategy::GraphState&)>> func)
 	// rst:
 	// rst:		:returns: an :ref:`strat-execute` strategy.
@@ -119,6 +126,14 @@ public:
 	// rst:		:throws: :class:`LogicError` if `predicate` or `strategy` is a `nullptr`.
 	static std::shared_ptr<Strategy>
 	makeLeftPredicate(std::shared_ptr<Function<bool(const Derivation &)>> predicate, std::shared_ptr<Strategy> strategy);
+	// rst: .. function:: static std::shared_ptr<Strategy> makeLeftPredicate(const GraphPredicate &predicate, std::shared_ptr<Strategy> strategy)
+	// rst:
+	// rst:		As the other overload, but with a native predicate evaluated on the left side of each derivation.
+	// rst:
+	// rst:		:returns: a :ref:`strat-leftPredicate` strategy.
+	// rst:		:throws: :class:`LogicError` if `strategy` is a `nullptr`.
+	static std::shared_ptr<Strategy>
+	makeLeftPredicate(const GraphPredicate &predicate, std::shared_ptr<Strategy> strategy);
 	// rst: .. function:: static std::shared_ptr<Strategy> makeRightPredicate(std::shared_ptr<Function<bool(const Derivation&) >> predicate, std::shared_ptr<Strategy> strategy)
 	// rst:
 	// rst:		:returns: a :ref:`strat-rightPredicate` strategy.
@@ -126,6 +141,14 @@ public:
 	static std::shared_ptr<Strategy>
 	makeRightPredicate(std::shared_ptr<Function<bool(const Derivation &)>> predicate,
 	                   std::shared_ptr<Strategy> strategy);
+	// rst: .. function:: static std::shared_ptr<Strategy> makeRightPredicate(const GraphPredicate &predicate, std::shared_ptr<Strategy> strategy)
+	// rst:
+	// rst:		As the other overload, but with a native predicate evaluated on the right side of each derivation.
+	// rst:
+	// rst:		:returns: a :ref:`strat-rightPredicate` strategy.
+	// rst:		:throws: :class:`LogicError` if `strategy` is a `nullptr`.
+	static std::shared_ptr<Strategy>
+	makeRightPredicate(const GraphPredicate &predicate, std::shared_ptr<Strategy> strategy);
 	// rst: .. function:: static std::shared_ptr<Strategy> makeRevive(std::shared_ptr<Strategy> strategy)
 	// rst:
 	// rst:		:returns: a :ref:`strat-revive` strategy.
@@ -137,6 +160,36 @@ public:
 	// rst:		:throws: :class:`LogicError` if `limit < 0`
 	// rst:		:throws: :class:`LogicError` if `strategy` is a `nullptr`.
 	static std::shared_ptr<Strategy> makeRepeat(int limit, std::shared_ptr<Strategy> strategy);
+	// rst: .. function:: static std::shared_ptr<Strategy> makeBestFirst(std::shared_ptr<Function<double(std::shared_ptr<graph::Graph>)>> score, \
+	// rst:                  std::shared_ptr<Strategy> strategy, const std::vector<std::shared_ptr<graph::Graph>> &targets, \
+	// rst:                  int maxExpansions, int maxVertices, int maxDerivations, double timeLimit)
+	// rst:
+	// rst:		Each limit is disabled by giving 0, and the time limit is in seconds.
+	// rst:		When a graph isomorphic to one of the `targets` is derived,
+	// rst:		the rest of the execution is skipped.
+	// rst:
+	// rst:		:returns: a :ref:`strat-bestFirst` strategy, expanding the graphs with the lowest `score` first.
+	// rst:		:throws: :class:`LogicError` if `score` or `strategy` is a `nullptr`.
+	// rst:		:throws: :class:`LogicError` if one of the `targets` is a `nullptr`.
+	// rst:		:throws: :class:`LogicError` if one of the limits is negative.
+	static std::shared_ptr<Strategy>
+	makeBestFirst(std::shared_ptr<Function<double(std::shared_ptr<graph::Graph>)>> score,
+	              std::shared_ptr<Strategy> strategy, const std::vector<std::shared_ptr<graph::Graph>> &targets,
+	              int maxExpansions, int maxVertices, int maxDerivations, double timeLimit);
+	// rst: .. function:: static std::shared_ptr<Strategy> makeBestFirst(const GraphValue &score, \
+	// rst:                  std::shared_ptr<Strategy> strategy, const std::vector<std::shared_ptr<graph::Graph>> &targets, \
+	// rst:                  int maxExpansions, int maxVertices, int maxDerivations, double timeLimit)
+	// rst:
+	// rst:		As the other overload, but with a native score, e.g., :cpp:func:`GraphValue::massDistance`.
+	// rst:
+	// rst:		:returns: a :ref:`strat-bestFirst` strategy.
+	// rst:		:throws: :class:`LogicError` if `strategy` is a `nullptr`.
+	// rst:		:throws: :class:`LogicError` if one of the `targets` is a `nullptr`.
+	// rst:		:throws: :class:`LogicError` if one of the limits is negative.
+	static std::shared_ptr<Strategy>
+	makeBestFirst(const GraphValue &score,
+	              std::shared_ptr<Strategy> strategy, const std::vector<std::shared_ptr<graph::Graph>> &targets,
+	              int maxExpansions, int maxVertices, int maxDerivations, double timeLimit);
 };
 // rst-class-end:
 
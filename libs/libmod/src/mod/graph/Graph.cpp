@@ -6,6 +6,8 @@
 #include <mod/graph/Automorphism.hpp>
 #include <mod/graph/GraphInterface.hpp>
 #include <mod/graph/Printer.hpp>
+#include <mod/lib/Algorithm/ParallelFor.hpp>
+#include <mod/lib/Graph/Collection.hpp>
 #include <mod/lib/Graph/Graph.hpp>
 #include <mod/lib/Graph/IO/DepictionData.hpp>
 #include <mod/lib/Graph/IO/Read.hpp>
@@ -17,8 +19,10 @@
 
 #include <boost/iostreams/device/mapped_file.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <optional>
 
 namespace mod::graph {
 
@@ -67,6 +71,8 @@ Graph::EdgeRange Graph::edges() const {
 //------------------------------------------------------------------------------
 
 Graph::AutGroup Graph::aut(LabelSettings labelSettings) const {
+	if(labelSettings.withStereo)
+		throw LogicError("Can not compute automorphism groups with stereo-information.");
 	return AutGroup(g->getAPIReference(), labelSettings);
 }
 
@@ -348,6 +354,64 @@ auto load(const std::string &data, const std::string &type, FParse parse, FProce
 	return process(std::move(*parsedData), std::move(warnings), type, source);
 }
 
+// Parses n records with parse(i, warnings) in parallel, and returns the graphs of the records
+// in order, but with only the first graph of each isomorphism class.
+// If any of the graphs has stereo information, isomorphism includes the stereo information,
+// so stereoisomers are kept apart.
+// Each graph is constructed on the calling thread, so the graph IDs follow the record order.
+template<typename Describe, typename Parse>
+std::vector<std::shared_ptr<Graph>>
+loadBatch(std::size_t n, const std::vector<std::string> &names, const std::string &type,
+          Describe describe, Parse parse) {
+	using DataResult = lib::IO::Result<std::vector<lib::graph::Read::Data>>;
+	std::vector<lib::IO::Warnings> warnings(n);
+	std::vector<std::optional<DataResult>> parsed(n);
+	lib::parallelFor(getConfig().common.numThreads, n, [&](std::size_t i) {
+		parsed[i].emplace(parse(i, warnings[i]));
+	});
+
+	std::vector<std::shared_ptr<Graph>> graphs;
+	graphs.reserve(n);
+	for(std::size_t i = 0; i != n; ++i) {
+		if(!warnings[i].empty())
+			std::cout << "In " << type << " " << describe(i) << ":\n" << warnings[i] << std::flush;
+		auto &data = *parsed[i];
+		if(!data)
+			throw InputError("Error in loading " + type + " " + describe(i) + ".\n" + data.extractError());
+		if(data->size() != 1) {
+			if(data->empty()) {
+				throw InputError("Error in loading " + type + " " + describe(i) + ".\nthe graph is empty.");
+			} else {
+				throw InputError("Error in loading " + type + " " + describe(i)
+				                 + ".\nthe graph is not connected (" + std::to_string(data->size()) + " components).");
+			}
+		}
+		graphs.push_back(makeGraphFromData(std::move(data->front()), warnings[i].extractWarnings()));
+		if(!names.empty() && !names[i].empty()) graphs.back()->setName(names[i]);
+		parsed[i].reset();
+	}
+
+	const bool withStereo = std::any_of(graphs.begin(), graphs.end(), [](const auto &g) {
+		return has_stereo(g->getGraph().getLabelledGraph());
+	});
+	const LabelSettings ls(LabelType::String, LabelRelation::Isomorphism, withStereo, LabelRelation::Isomorphism);
+	std::vector<const lib::graph::Graph *> gPtrs;
+	gPtrs.reserve(graphs.size());
+	for(const auto &g: graphs) gPtrs.push_back(&g->getGraph());
+	lib::graph::Graph::precomputeCanonForms(gPtrs, ls);
+
+	lib::graph::Collection unique(ls, getConfig().graph.isomorphismAlg);
+	std::vector<std::shared_ptr<Graph>> res;
+	for(auto &g: graphs)
+		if(unique.tryInsert(g).second)
+			res.push_back(std::move(g));
+	return res;
+}
+
+std::string describeRecord(std::size_t i, const lib::graph::Read::Record &record, const std::string &file) {
+	return "file '" + file + "', record " + std::to_string(i) + " (line " + std::to_string(record.firstLine) + ")";
+}
+
 } // namespace
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -451,6 +515,62 @@ Graph::fromSDFileMulti(const std::string &file, const MDLOptions &options) {
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+std::vector<std::shared_ptr<Graph>>
+Graph::fromSMILESFileBatch(const std::string &file, bool allowAbstract,
+                           SmilesClassPolicy classPolicy, bool printStereoWarnings) {
+	auto ifs = openFile(file, "SMILES file");
+	auto records = lib::graph::Read::splitLines({ifs.data(), ifs.size()});
+	// each line is a SMILES string, optionally followed by a name
+	std::vector<std::string> names(records.size());
+	for(std::size_t i = 0; i != records.size(); ++i) {
+		auto &src = records[i].src;
+		src.remove_prefix(std::min(src.find_first_not_of(" \t"), src.size()));
+		const auto end = src.find_first_of(" \t");
+		if(end == std::string_view::npos) continue;
+		auto name = src.substr(end);
+		src = src.substr(0, end);
+		name.remove_prefix(std::min(name.find_first_not_of(" \t"), name.size()));
+		name = name.substr(0, name.find_last_not_of(" \t") + 1);
+		names[i] = std::string(name);
+	}
+	return loadBatch(records.size(), names, "SMILES", [&](std::size_t i) {
+		return describeRecord(i, records[i], file);
+	}, [&](std::size_t i, lib::IO::Warnings &warnings) {
+		return lib::graph::Read::smiles(warnings, records[i].src, printStereoWarnings, allowAbstract, classPolicy);
+	});
+}
+
+std::vector<std::shared_ptr<Graph>> Graph::fromSDFileBatch(const std::string &file, const MDLOptions &options) {
+	auto ifs = openFile(file, "SD file");
+	const auto records = lib::graph::Read::splitSDRecords({ifs.data(), ifs.size()});
+	return loadBatch(records.size(), {}, "SD", [&](std::size_t i) {
+		return describeRecord(i, records[i], file);
+	}, [&](std::size_t i, lib::IO::Warnings &warnings) -> lib::IO::Result<std::vector<lib::graph::Read::Data>> {
+		auto res = lib::graph::Read::MDLSD(warnings, records[i].src, options);
+		if(!res) return std::move(res);
+		if(res->size() != 1)
+			return lib::IO::Result<std::vector<lib::graph::Read::Data>>::Error(
+					"the record contains " + std::to_string(res->size()) + " molecules, but exactly one was expected.");
+		return std::move(res->front());
+	});
+}
+
+std::vector<std::shared_ptr<Graph>>
+Graph::fromGMLFileBatch(const std::vector<std::string> &files, bool printStereoWarnings) {
+	std::vector<boost::iostreams::mapped_file_source> ifss;
+	ifss.reserve(files.size());
+	for(const auto &file: files)
+		ifss.push_back(openFile(file, "GML file"));
+	return loadBatch(files.size(), {}, "GML", [&](std::size_t i) {
+		return "file '" + files[i] + "', record " + std::to_string(i);
+	}, [&](std::size_t i, lib::IO::Warnings &warnings) {
+		return lib::graph::Read::gml(warnings, {ifss[i].data(), ifss[i].size()}, printStereoWarnings);
+	});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 std::shared_ptr<Graph> Graph::create(std::unique_ptr<lib::graph::Graph> g) {
 	if(!g) MOD_ABORT;
 	std::shared_ptr<Graph> wrapped = std::shared_ptr<Graph>(new Graph(std::move(g)));
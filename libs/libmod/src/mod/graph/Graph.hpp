@@ -77,6 +77,9 @@ public:
 	// rst: .. function:: AutGroup aut(LabelSettings labelSettings) const
 	// rst:
 	// rst:		:returns: an object representing the automorphism group of the graph.
+	// rst:		:throws: :any:`LogicError` if stereo-information is requested.
+	// rst:		:throws: :any:`LogicError` if term labels are requested and the graph has variables,
+	// rst:			when the group is used.
 	AutGroup aut(LabelSettings labelSettings) const;
 public:
 	// rst: .. function:: std::pair<std::string, std::string> print() const
@@ -363,6 +366,33 @@ public:
 	static std::vector<std::vector<std::shared_ptr<Graph>>>
 	fromSDFileMulti(const std::string &file, const MDLOptions &options);
 	// ===========================================================================
+	// rst: .. function:: static std::vector<std::shared_ptr<Graph>> fromSMILESFileBatch(const std::string &file, bool allowAbstract, \
+	// rst:                                                                              SmilesClassPolicy classPolicy, bool printStereoWarnings)
+	// rst:               static std::vector<std::shared_ptr<Graph>> fromSDFileBatch(const std::string &file, const MDLOptions &options)
+	// rst:               static std::vector<std::shared_ptr<Graph>> fromGMLFileBatch(const std::vector<std::string> &files, \
+	// rst:                                                                           bool printStereoWarnings)
+	// rst:
+	// rst:		Load a large collection of graphs, where each record is a single connected graph.
+	// rst:		For SMILES files each non-blank line is a record, consisting of a SMILES string optionally followed
+	// rst:		by whitespace and the name of the graph.
+	// rst:		For SD files each MOL entry is a record, and for GML each file is a record.
+	// rst:		The records are parsed and canonicalised in parallel using ``getConfig().common.numThreads`` threads,
+	// rst:		and only the first graph of each isomorphism class is returned, in the order of the records.
+	// rst:		If any of the graphs has stereo information, then the isomorphism check includes the stereo information,
+	// rst:		so stereoisomers are not merged.
+	// rst:		Warnings and errors are reported with the index of the record they originate from, starting from 0.
+	// rst:
+	// rst:		See :func:`fromSMILES`, :func:`fromSDFile`, and :func:`fromGMLFile` for the parameter descriptions.
+	// rst:
+	// rst:		:returns: a list of pairwise non-isomorphic graphs.
+	// rst:		:throws: :class:`InputError` on bad input, including records that are not connected graphs.
+	static std::vector<std::shared_ptr<Graph>>
+	fromSMILESFileBatch(const std::string &file, bool allowAbstract,
+	                    SmilesClassPolicy classPolicy, bool printStereoWarnings);
+	static std::vector<std::shared_ptr<Graph>> fromSDFileBatch(const std::string &file, const MDLOptions &options);
+	static std::vector<std::shared_ptr<Graph>>
+	fromGMLFileBatch(const std::vector<std::string> &files, bool printStereoWarnings);
+	// ===========================================================================
 	// rst: .. function:: static std::shared_ptr<Graph> create(std::unique_ptr<lib::graph::Graph> g)
 	// rst:               static std::shared_ptr<Graph> create(std::unique_ptr<lib::graph::Graph> g, \
 	// rst:                                                    std::map<int, std::size_t> externalToInternalIds, \
@@ -0,0 +1,60 @@
+#ifndef MOD_LIB_ALGORITHM_PARALLELFOR_HPP
+#define MOD_LIB_ALGORITHM_PARALLELFOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mod::lib {
+
+// Calls f(i) for each i in [0, n), distributed dynamically over at most numThreads threads,
+// including the calling thread.
+// The order in which f is called is unspecified, so f must only write to state owned by task i,
+// and the caller must merge the per-task results afterwards if a deterministic result is needed.
+// If any call throws, the remaining tasks are skipped and the exception from the lowest task index is rethrown.
+template<typename F>
+void parallelFor(unsigned int numThreads, std::size_t n, F f) {
+	numThreads = static_cast<unsigned int>(std::max<std::size_t>(1, std::min<std::size_t>(numThreads, n)));
+	if(numThreads == 1) {
+		for(std::size_t i = 0; i != n; ++i)
+			f(i);
+		return;
+	}
+	std::atomic<std::size_t> next(0);
+	std::atomic<bool> failed(false);
+	std::mutex mtx;
+	std::size_t errorIdx = n;
+	std::exception_ptr error;
+	const auto worker = [&]() {
+		while(!failed.load(std::memory_order_relaxed)) {
+			const std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+			if(i >= n) break;
+			try {
+				f(i);
+			} catch(...) {
+				std::lock_guard<std::mutex> lock(mtx);
+				if(i < errorIdx) {
+					errorIdx = i;
+					error = std::current_exception();
+				}
+				failed = true;
+			}
+		}
+	};
+	std::vector<std::thread> threads;
+	threads.reserve(numThreads - 1);
+	for(unsigned int t = 1; t < numThreads; ++t)
+		threads.emplace_back(worker);
+	worker();
+	for(auto &t: threads)
+		t.join();
+	if(error) std::rethrow_exception(error);
+}
+
+} // namespace mod::lib
+
+#endif // MOD_LIB_ALGORITHM_PARALLELFOR_HPP
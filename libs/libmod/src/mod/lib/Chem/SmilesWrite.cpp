@@ -267,9 +267,8 @@ struct SmilesWriter {
 #endif
 		const auto idx = get(boost::vertex_index_t(), g);
 
-		if(!pMol.getHasOnlyChemicalBonds()) {
-			MOD_ABORT; // can not get to here currently, as the canonicalization algorithm can't handle non-chemical bonds
-		}
+		if(!pMol.getHasOnlyChemicalBonds())
+			return lib::IO::Result<>::Error("The graph has non-chemical edge labels.");
 		for(const auto v: asRange(vertices(g))) {
 			if(pMol[v].getAtomId() != AtomIds::Invalid) continue;
 			int bracketCount = 0;
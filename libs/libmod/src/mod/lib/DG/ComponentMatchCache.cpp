@@ -0,0 +1,57 @@
+#include "ComponentMatchCache.hpp"
+
+#include <mod/Config.hpp>
+#include <mod/lib/Graph/Graph.hpp>
+#include <mod/lib/Rule/Rule.hpp>
+
+#include <iostream>
+
+namespace mod::lib::DG {
+
+std::shared_ptr<const ComponentMatchCache::Matches>
+ComponentMatchCache::find(const lib::rule::Rule &r, const lib::graph::Graph &g) {
+	const auto iter = index.find(Key(r.getId(), g.getId()));
+	if(iter == index.end()) {
+		++stats.numMisses;
+		return nullptr;
+	}
+	++stats.numHits;
+	entries.splice(entries.begin(), entries, iter->second);
+	return iter->second->matches;
+}
+
+void ComponentMatchCache::insert(const lib::rule::Rule &r, const lib::graph::Graph &g,
+                                 std::shared_ptr<const Matches> matches) {
+	const std::size_t capacity = getConfig().dg.componentMatchCacheSize;
+	if(capacity == 0) return;
+	const Key key(r.getId(), g.getId());
+	const auto iter = index.find(key);
+	if(iter != index.end()) {
+		iter->second->matches = std::move(matches);
+		entries.splice(entries.begin(), entries, iter->second);
+		return;
+	}
+	entries.push_front(Entry{key, std::move(matches)});
+	index.emplace(key, entries.begin());
+	while(entries.size() > capacity) {
+		index.erase(entries.back().key);
+		entries.pop_back();
+		++stats.numEvictions;
+	}
+}
+
+const ComponentMatchCacheStats &ComponentMatchCache::getStats() const {
+	return stats;
+}
+
+void ComponentMatchCache::printStats(std::ostream &s) const {
+	const auto numLookups = stats.numHits + stats.numMisses;
+	s << "Component match cache:" << std::endl;
+	s << "numEntries:   " << entries.size() << std::endl;
+	s << "numHits:      " << stats.numHits << std::endl;
+	s << "numMisses:    " << stats.numMisses << std::endl;
+	s << "numEvictions: " << stats.numEvictions << std::endl;
+	s << "hitRate:      " << (numLookups == 0 ? 0.0 : double(stats.numHits) / numLookups) << std::endl;
+}
+
+} // namespace mod::lib::DG
@@ -0,0 +1,57 @@
+#ifndef MOD_LIB_DG_COMPONENTMATCHCACHE_HPP
+#define MOD_LIB_DG_COMPONENTMATCHCACHE_HPP
+
+#include <boost/functional/hash.hpp>
+
+#include <iosfwd>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace mod::lib::graph {
+struct Graph;
+} // namespace mod::lib::graph
+namespace mod::lib::rule {
+struct Rule;
+} // namespace mod::lib::rule
+namespace mod::lib::DG {
+
+// Counters for a ComponentMatchCache.
+// A hit is a lookup where the matches were stored, and a miss is a lookup where they must be computed.
+struct ComponentMatchCacheStats {
+	std::size_t numHits = 0;
+	std::size_t numMisses = 0;
+	std::size_t numEvictions = 0;
+};
+
+// The matches of the left-hand components of rules into graphs, shared by the direct rule applications of a DG.
+// Rules and graphs are immutable, so the matches found in one round of a repeat strategy, or in one execution,
+// are also valid in all later rounds and executions, and the VF2 searches need not be repeated.
+// An entry holds the matches of all components of a rule into a graph, where no matches is stored as well.
+// The entries are keyed by the IDs of the rule and the graph, and the least recently used entries are evicted
+// when there are more than getConfig().dg.componentMatchCacheSize entries.
+// The matches are shared, so an evicted entry stays alive for as long as it is used.
+// The cache is not thread-safe.
+struct ComponentMatchCache {
+	using Matches = std::vector<std::vector<std::vector<std::size_t>>>; // component x match x component vertex
+public:
+	// Returns nullptr if the matches are not stored.
+	std::shared_ptr<const Matches> find(const lib::rule::Rule &r, const lib::graph::Graph &g);
+	void insert(const lib::rule::Rule &r, const lib::graph::Graph &g, std::shared_ptr<const Matches> matches);
+	const ComponentMatchCacheStats &getStats() const;
+	void printStats(std::ostream &s) const;
+private:
+	using Key = std::pair<std::size_t, std::size_t>;
+	struct Entry {
+		Key key;
+		std::shared_ptr<const Matches> matches;
+	};
+	std::list<Entry> entries; // the most recently used first
+	std::unordered_map<Key, std::list<Entry>::iterator, boost::hash<Key>> index;
+	ComponentMatchCacheStats stats;
+};
+
+} // namespace mod::lib::DG
+
+#endif // MOD_LIB_DG_COMPONENTMATCHCACHE_HPP
@@ -0,0 +1,547 @@
+#include "DirectRuleApplication.hpp"
+
+#include <mod/lib/Algorithm/ParallelFor.hpp>
+#include <mod/lib/GraphMorphism/Invariant.hpp>
+#include <mod/lib/GraphMorphism/VF2Finder.hpp>
+#include <mod/lib/RC/MatchMaker/ComponentWiseUtil.hpp>
+
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
+
+#include <boost/functional/hash.hpp>
+#include <boost/graph/adjacency_list.hpp>
+
+#include <iostream>
+#include <numeric>
+
+namespace mod::lib::DG {
+using lib::DPO::Membership;
+
+bool canApplyDirectly(const lib::rule::Rule &r, LabelSettings labelSettings) {
+	if(!getConfig().dg.directRuleApplication) return false;
+	if(labelSettings.type != LabelType::String) return false;
+	if(labelSettings.withStereo) return false;
+	// the matches are only printed by the composition
+	if(getConfig().rc.printMatches) return false;
+	return get_match_constraints(get_labelled_left(r.getDPORule())).empty();
+}
+
+std::ostream &operator<<(std::ostream &s, const DirectBinding &b) {
+	s << "{boundGraphs=[";
+	bool first = true;
+	for(const auto *g: b.boundGraphs) {
+		if(!first) s << ", ";
+		else first = false;
+		s << g->getName();
+	}
+	return s << "], numUnbound=" << b.numUnbound << ", nextGraphOffset=" << b.nextGraphOffset << "}";
+}
+
+// A binding as the combined graph of the bound rule the composition would have created:
+// the copies with the matched elements changed by the rule, the unbound elements of the rule,
+// and the right-only elements of the rule.
+// Duplicates are therefore detected exactly as for the bound rules of the composition.
+struct DirectRuleApplier::BindingState {
+	struct Prop {
+		Membership m;
+		const std::string *label, *labelRight; // nullptr if not in the side
+	};
+	using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS, Prop, Prop>;
+public:
+	static bool equalLabels(const std::string *a, const std::string *b) {
+		return a == b || (a && b && *a == *b);
+	}
+
+	static bool equalProps(const Prop &a, const Prop &b) {
+		return a.m == b.m && equalLabels(a.label, b.label) && equalLabels(a.labelRight, b.labelRight);
+	}
+
+	static std::size_t hashProp(const Prop &p) {
+		const auto hashLabel = [](const std::string *l) -> std::size_t {
+			return l ? std::hash<std::string>()(*l) : 0;
+		};
+		std::size_t h = static_cast<int>(p.m);
+		boost::hash_combine(h, hashLabel(p.label));
+		boost::hash_combine(h, hashLabel(p.labelRight));
+		return h;
+	}
+
+	std::size_t getKey() const {
+		std::size_t key = hash;
+		boost::hash_combine(key, nextGraphOffset);
+		boost::hash_range(key, graphIds.begin(), graphIds.end());
+		return key;
+	}
+
+	// See BoundRule::isomorphicTo.
+	bool isomorphicTo(const BindingState &other) const {
+		if(graphIds != other.graphIds) return false;
+		if(nextGraphOffset != other.nextGraphOffset) return false;
+		const auto &gOther = other.g;
+		const auto pred = [this, &gOther](const auto xDom, const auto xCodom) {
+			return equalProps(g[xDom], gOther[xCodom]);
+		};
+		bool found = false;
+		const auto mr = [&found](auto &&, const Graph &, const Graph &) {
+			found = true;
+			return false;
+		};
+		lib::GraphMorphism::VF2Isomorphism()(g, gOther, mr, pred, pred);
+		return found;
+	}
+public:
+	std::vector<std::size_t> graphIds; // sorted
+	int nextGraphOffset;
+	Graph g;
+	std::size_t hash;
+};
+
+DirectRuleApplier::DirectRuleApplier(const lib::rule::Rule &r, rule::GraphAsRuleCache &graphAsRuleCache,
+                                     ComponentMatchCache &componentMatchCache, LabelSettings labelSettings)
+		: r(r), graphAsRuleCache(graphAsRuleCache), componentMatchCache(componentMatchCache),
+		  labelSettings(labelSettings) {
+	assert(canApplyDirectly(r, labelSettings));
+	const auto &rDPO = r.getDPORule();
+	const auto &gCore = get_graph(rDPO);
+	const auto &lgLeft = get_labelled_left(rDPO);
+	vertexComponent.resize(num_vertices(gCore), -1);
+	vertexPosition.resize(num_vertices(gCore), -1);
+	deletedVertexDegree.resize(num_vertices(gCore), -1);
+	componentVertices.resize(get_num_connected_components(lgLeft));
+	for(std::size_t c = 0; c != componentVertices.size(); ++c) {
+		const auto gComp = get_component_graph(c, lgLeft);
+		for(const auto v: asRange(vertices(gComp))) {
+			const auto vId = get(boost::vertex_index_t(), gCore, v);
+			vertexComponent[vId] = c;
+			vertexPosition[vId] = componentVertices[c].size();
+			componentVertices[c].push_back(vId);
+		}
+	}
+	for(const auto v: asRange(vertices(gCore))) {
+		if(membership(rDPO, v) != Membership::L) continue;
+		int deg = 0;
+		for(const auto e: asRange(out_edges(v, gCore)))
+			if(membership(rDPO, e) != Membership::R) ++deg;
+		deletedVertexDegree[get(boost::vertex_index_t(), gCore, v)] = deg;
+	}
+	for(const auto e: asRange(edges(gCore))) {
+		if(membership(rDPO, e) != Membership::R) continue;
+		const auto vSrc = get(boost::vertex_index_t(), gCore, source(e, gCore));
+		const auto vTar = get(boost::vertex_index_t(), gCore, target(e, gCore));
+		if(vertexComponent[vSrc] != -1 && vertexComponent[vTar] != -1)
+			newEdgesOnOld.emplace_back(vSrc, vTar);
+	}
+}
+
+DirectRuleApplier::~DirectRuleApplier() = default;
+
+const lib::rule::Rule &DirectRuleApplier::getRule() const {
+	return r;
+}
+
+DirectBinding DirectRuleApplier::makeInitial() const {
+	const auto numComponents = componentVertices.size();
+	return DirectBinding{{}, std::vector<int>(numComponents, -1),
+	                     std::vector<const std::vector<std::size_t> *>(numComponents, nullptr),
+	                     0, static_cast<int>(numComponents)};
+}
+
+std::vector<DirectBinding> DirectRuleApplier::bindGraphs(
+		const int verbosity, IO::Logger &logger,
+		const int bindRound,
+		const std::vector<const lib::graph::Graph *> &graphs, const std::size_t numGraphs,
+		const std::vector<DirectBinding> &inputBindings,
+		const bool doRuleIsomorphism, RuleStats *stats,
+		std::function<bool(IO::Logger, const DirectBinding &)> onOutput) {
+	assert(numGraphs <= graphs.size());
+	if(verbosity >= V_RuleApplication) {
+		logger.indent() << "Bind round " << (bindRound + 1) << " with "
+		                << numGraphs << " graphs "
+		                << "and " << inputBindings.size() << " partial bindings (direct)." << std::endl;
+		++logger.indentLevel;
+	}
+	std::size_t firstGraph = numGraphs;
+	for(const DirectBinding &b: inputBindings)
+		firstGraph = std::min<std::size_t>(firstGraph, b.nextGraphOffset);
+	prepareMatches(graphs, firstGraph, numGraphs);
+
+	struct Task {
+		std::size_t inputIdx;
+		int graphOffset;
+		std::vector<DirectBinding> results;
+	};
+	std::vector<Task> tasks;
+	for(std::size_t inputIdx = 0; inputIdx != inputBindings.size(); ++inputIdx) {
+		assert(inputBindings[inputIdx].nextGraphOffset <= numGraphs);
+		for(int graphOffset = inputBindings[inputIdx].nextGraphOffset; graphOffset != numGraphs; ++graphOffset)
+			tasks.push_back(Task{inputIdx, graphOffset, {}});
+	}
+	lib::parallelFor(getConfig().common.numThreads, tasks.size(), [&](std::size_t iTask) {
+		Task &task = tasks[iTask];
+		extend(inputBindings[task.inputIdx], task.graphOffset, graphs[task.graphOffset], task.results);
+	});
+
+	int numComplete = 0;
+	int numDup = 0;
+	std::vector<DirectBinding> outputBindings;
+	// the states of outputBindings, bucketed by their keys
+	std::vector<BindingState> outputStates;
+	std::unordered_map<std::size_t, std::vector<std::size_t>> buckets;
+	const auto isDuplicate = [&](const DirectBinding &b) {
+		BindingState state = makeState(b);
+		auto &bucket = buckets[state.getKey()];
+		for(const std::size_t iStored: bucket)
+			if(outputStates[iStored].isomorphicTo(state))
+				return true;
+		bucket.push_back(outputStates.size());
+		outputStates.push_back(std::move(state));
+		return false;
+	};
+	for(Task &task: tasks) {
+		if(verbosity >= V_RuleApplication_Binding)
+			logger.indent() << "Binding " << graphs[task.graphOffset]->getName() << " to "
+			                << inputBindings[task.inputIdx] << ": "
+			                << task.results.size() << " bindings" << std::endl;
+		for(DirectBinding &b: task.results) {
+			if(b.isComplete()) ++numComplete;
+			else if(doRuleIsomorphism && isDuplicate(b)) {
+				++numDup;
+				continue;
+			} else outputBindings.push_back(b);
+			if(!onOutput(logger, b)) break;
+		}
+		task.results.clear();
+	}
+	if(stats) {
+		stats->numBoundRules += numComplete + outputBindings.size() + numDup;
+		stats->numBoundRulesDuplicate += numDup;
+	}
+	if(verbosity >= V_RuleApplication) {
+		logger.indent() << "Result of bind round " << (bindRound + 1) << ": "
+		                << numComplete << " complete + " << outputBindings.size() << " partial bindings + "
+		                << numDup << " duplicates" << std::endl;
+		--logger.indentLevel;
+	}
+	return outputBindings;
+}
+
+DirectRuleApplier::BindingState DirectRuleApplier::makeState(const DirectBinding &b) const {
+	using Prop = BindingState::Prop;
+	const auto &rDPO = r.getDPORule();
+	const auto &gCore = get_graph(rDPO);
+	const auto &pCore = get_string(rDPO);
+	const auto toPtr = [](const auto &l) -> const std::string * {
+		return l ? &*l : nullptr;
+	};
+	BindingState state;
+	for(const auto *g: b.boundGraphs)
+		state.graphIds.push_back(g->getId());
+	std::sort(state.graphIds.begin(), state.graphIds.end());
+	state.nextGraphOffset = b.nextGraphOffset;
+	auto &gState = state.g;
+	// the copies
+	std::vector<std::size_t> vOffset, eOffset;
+	std::vector<const std::string *> eLabel;
+	for(const auto *g: b.boundGraphs) {
+		const auto &gHost = g->getGraph();
+		const auto &pHost = g->getStringState();
+		vOffset.push_back(num_vertices(gState));
+		eOffset.push_back(eLabel.size());
+		for(const auto v: asRange(vertices(gHost)))
+			add_vertex(Prop{Membership::K, &pHost[v], &pHost[v]}, gState);
+		for(const auto e: asRange(edges(gHost)))
+			eLabel.push_back(&pHost[e]);
+	}
+	// the vertices of the rule, either changing the matched vertices or added
+	std::vector<std::size_t> coreToVertex(num_vertices(gCore));
+	for(const auto vCore: asRange(vertices(gCore))) {
+		const auto vId = get(boost::vertex_index_t(), gCore, vCore);
+		const auto m = membership(rDPO, vCore);
+		const auto p = pCore[vCore];
+		const auto c = vertexComponent[vId];
+		if(c == -1 || b.componentCopy[c] == -1) {
+			coreToVertex[vId] = add_vertex(Prop{m, toPtr(p.first), toPtr(p.second)}, gState);
+		} else {
+			const auto v = vOffset[b.componentCopy[c]] + (*b.componentMatch[c])[vertexPosition[vId]];
+			coreToVertex[vId] = v;
+			gState[v].m = m;
+			gState[v].labelRight = toPtr(p.second);
+		}
+	}
+	// the edges of the rule, either changing the matched edges or added
+	std::vector<Prop> matchedEdge(eLabel.size(), Prop{Membership::K, nullptr, nullptr});
+	for(const auto eCore: asRange(edges(gCore))) {
+		const auto vSrc = coreToVertex[get(boost::vertex_index_t(), gCore, source(eCore, gCore))];
+		const auto vTar = coreToVertex[get(boost::vertex_index_t(), gCore, target(eCore, gCore))];
+		const auto m = membership(rDPO, eCore);
+		const auto p = pCore[eCore];
+		const auto c = vertexComponent[get(boost::vertex_index_t(), gCore, source(eCore, gCore))];
+		if(m == Membership::R || b.componentCopy[c] == -1) {
+			add_edge(vSrc, vTar, Prop{m, toPtr(p.first), toPtr(p.second)}, gState);
+			continue;
+		}
+		// a matched edge, so both ends are in the same copy
+		const auto copy = b.componentCopy[c];
+		const auto &gHost = b.boundGraphs[copy]->getGraph();
+		const auto ep = edge(vertex(vSrc - vOffset[copy], gHost), vertex(vTar - vOffset[copy], gHost), gHost);
+		assert(ep.second);
+		const auto e = eOffset[copy] + get(boost::edge_index_t(), gHost, ep.first);
+		matchedEdge[e] = Prop{m, eLabel[e], toPtr(p.second)};
+	}
+	for(std::size_t i = 0; i != b.boundGraphs.size(); ++i) {
+		const auto &gHost = b.boundGraphs[i]->getGraph();
+		for(const auto e: asRange(edges(gHost))) {
+			const auto eId = eOffset[i] + get(boost::edge_index_t(), gHost, e);
+			const auto p = matchedEdge[eId].label ? matchedEdge[eId] : Prop{Membership::K, eLabel[eId], eLabel[eId]};
+			add_edge(vOffset[i] + get(boost::vertex_index_t(), gHost, source(e, gHost)),
+			         vOffset[i] + get(boost::vertex_index_t(), gHost, target(e, gHost)), p, gState);
+		}
+	}
+	state.hash = GraphMorphism::hashWL(gState, [&gState](const auto ve) {
+		return BindingState::hashProp(gState[ve]);
+	});
+	return state;
+}
+
+void DirectRuleApplier::prepareMatches(const std::vector<const lib::graph::Graph *> &graphs,
+                                       std::size_t first, std::size_t last) {
+	// serially create the storage and everything lazily computed, so the matching only reads shared data
+	std::vector<std::pair<const lib::graph::Graph *, const lib::rule::Rule *>> todo;
+	std::vector<std::shared_ptr<const Matches> *> storage;
+	for(std::size_t i = first; i < last; ++i) {
+		const auto *g = graphs[i];
+		const auto p = matchCache.emplace(g, nullptr);
+		if(!p.second) continue;
+		// the matches may be known from an earlier round or execution
+		p.first->second = componentMatchCache.find(r, *g);
+		if(p.first->second) continue;
+		const lib::rule::Rule &rBind = graphAsRuleCache.getBindRule(g)->getRule();
+		prepareForParallelBinding(rBind);
+		todo.emplace_back(g, &rBind);
+		storage.push_back(&p.first->second);
+	}
+	if(todo.empty()) return;
+	prepareForParallelBinding(r);
+	// the VF2 counting is per thread, so each task counts on its own
+	GraphMorphism::VF2Counters *const vf2Outer = GraphMorphism::getThreadVF2Counters();
+	std::vector<GraphMorphism::VF2Counters> vf2(vf2Outer ? todo.size() : 0);
+	std::vector<Matches> computed(todo.size());
+	lib::parallelFor(getConfig().common.numThreads, todo.size(), [&](std::size_t i) {
+		GraphMorphism::VF2CounterScope vf2Scope(vf2Outer ? &vf2[i] : nullptr);
+		computed[i] = computeMatches(todo[i].first, *todo[i].second);
+	});
+	for(const auto &c: vf2)
+		*vf2Outer += c;
+	for(std::size_t i = 0; i != todo.size(); ++i) {
+		*storage[i] = std::make_shared<const Matches>(std::move(computed[i]));
+		componentMatchCache.insert(r, *todo[i].first, *storage[i]);
+	}
+}
+
+DirectRuleApplier::Matches
+DirectRuleApplier::computeMatches(const lib::graph::Graph *g, const lib::rule::Rule &rBind) const {
+	const auto &rDPO = r.getDPORule();
+	const auto &gCore = get_graph(rDPO);
+	const auto lgLeft = get_labelled_left(rDPO);
+	const auto lgHost = get_labelled_right(rBind.getDPORule());
+	const auto &gLeft = get_graph(lgLeft);
+	const auto &gHostSide = get_graph(lgHost);
+	const auto &gHost = g->getGraph();
+	IO::Logger logger(std::cout);
+	const auto mp = RC::makeRuleRuleComponentMonomorphism(lgLeft, lgHost, true, labelSettings, false, logger);
+	Matches res(componentVertices.size());
+	for(std::size_t c = 0; c != componentVertices.size(); ++c) {
+		const auto &vsComp = componentVertices[c];
+		for(std::size_t h = 0; h != get_num_connected_components(lgHost); ++h) {
+			for(const auto &m: mp(c, h)) {
+				std::vector<std::size_t> match;
+				match.reserve(vsComp.size());
+				bool dangling = false;
+				for(const auto vId: vsComp) {
+					const auto vHostSide = get(m, gLeft, gHostSide, vertex(vId, gCore));
+					const auto vHostId = get(boost::vertex_index_t(), gHostSide, vHostSide);
+					// a deleted vertex may not have any other edges than those matched
+					if(deletedVertexDegree[vId] != -1
+					   && deletedVertexDegree[vId] != out_degree(vertex(vHostId, gHost), gHost)) {
+						dangling = true;
+						break;
+					}
+					match.push_back(vHostId);
+				}
+				if(!dangling) res[c].push_back(std::move(match));
+			}
+		}
+	}
+	return res;
+}
+
+void DirectRuleApplier::extend(const DirectBinding &bInput, const int graphOffset, const lib::graph::Graph *g,
+                               std::vector<DirectBinding> &out) const {
+	const auto &matches = *matchCache.find(g)->second;
+	const auto &gHost = g->getGraph();
+	const int copy = bInput.boundGraphs.size();
+	std::vector<std::size_t> unbound;
+	for(std::size_t c = 0; c != bInput.componentCopy.size(); ++c)
+		if(bInput.componentCopy[c] == -1)
+			unbound.push_back(c);
+	std::vector<bool> used(num_vertices(gHost), false);
+	std::vector<const std::vector<std::size_t> *> chosen(componentVertices.size(), nullptr);
+	const auto hostVertex = [&](const std::size_t vId) {
+		return vertex((*chosen[vertexComponent[vId]])[vertexPosition[vId]], gHost);
+	};
+	const auto emit = [&](const int numChosen) {
+		// a new edge may not be parallel to an existing one
+		for(const auto &[vSrc, vTar]: newEdgesOnOld) {
+			if(!chosen[vertexComponent[vSrc]] || !chosen[vertexComponent[vTar]]) continue;
+			if(edge(hostVertex(vSrc), hostVertex(vTar), gHost).second) return;
+		}
+		DirectBinding b = bInput;
+		b.boundGraphs.push_back(g);
+		b.nextGraphOffset = graphOffset;
+		b.numUnbound -= numChosen;
+		for(std::size_t c = 0; c != chosen.size(); ++c) {
+			if(!chosen[c]) continue;
+			b.componentCopy[c] = copy;
+			b.componentMatch[c] = chosen[c];
+		}
+		out.push_back(std::move(b));
+	};
+	// each unbound component is either matched into this copy, disjointly from the others, or left unbound
+	const auto rec = [&](const auto &self, const std::size_t k, const int numChosen) -> void {
+		if(k == unbound.size()) {
+			if(numChosen != 0) emit(numChosen);
+			return;
+		}
+		const auto c = unbound[k];
+		for(const auto &m: matches[c]) {
+			if(std::any_of(m.begin(), m.end(), [&used](std::size_t v) { return used[v]; }))
+				continue;
+			for(const auto v: m) used[v] = true;
+			chosen[c] = &m;
+			self(self, k + 1, numChosen + 1);
+			chosen[c] = nullptr;
+			for(const auto v: m) used[v] = false;
+		}
+		self(self, k + 1, numChosen);
+	};
+	rec(rec, 0, 0);
+}
+
+std::vector<GraphData> DirectRuleApplier::makeProducts(const DirectBinding &b) const {
+	assert(b.isComplete());
+	const auto &rDPO = r.getDPORule();
+	const auto &gCore = get_graph(rDPO);
+	const auto &pCore = get_string(rDPO);
+	const auto numCopies = b.boundGraphs.size();
+	// The derived graph is the disjoint union of the copies, where the left-only elements are removed,
+	// the context elements are relabelled, and the right-only elements are added.
+	// Its vertices and edges are indexed by the copy offset plus the index in the copy,
+	// and new vertices are after those.
+	std::vector<std::size_t> vOffset(numCopies + 1, 0), eOffset(numCopies + 1, 0);
+	for(std::size_t i = 0; i != numCopies; ++i) {
+		vOffset[i + 1] = vOffset[i] + num_vertices(b.boundGraphs[i]->getGraph());
+		eOffset[i + 1] = eOffset[i] + num_edges(b.boundGraphs[i]->getGraph());
+	}
+	// the labels, and nullptr for deleted elements
+	std::vector<const std::string *> vLabel, eLabel;
+	vLabel.reserve(vOffset.back());
+	eLabel.reserve(eOffset.back());
+	for(const auto *g: b.boundGraphs) {
+		const auto &gHost = g->getGraph();
+		const auto &pHost = g->getStringState();
+		for(const auto v: asRange(vertices(gHost)))
+			vLabel.push_back(&pHost[v]);
+		for(const auto e: asRange(edges(gHost)))
+			eLabel.push_back(&pHost[e]);
+	}
+	std::vector<std::size_t> coreToVertex(num_vertices(gCore));
+	for(const auto vCore: asRange(vertices(gCore))) {
+		const auto vId = get(boost::vertex_index_t(), gCore, vCore);
+		const auto m = membership(rDPO, vCore);
+		if(m == Membership::R) {
+			coreToVertex[vId] = vLabel.size();
+			vLabel.push_back(&*pCore[vCore].second);
+			continue;
+		}
+		const auto c = vertexComponent[vId];
+		const auto v = vOffset[b.componentCopy[c]] + (*b.componentMatch[c])[vertexPosition[vId]];
+		coreToVertex[vId] = v;
+		vLabel[v] = m == Membership::L ? nullptr : &*pCore[vCore].second;
+	}
+	std::vector<std::pair<std::size_t, std::size_t>> newEdges;
+	std::vector<const std::string *> newEdgeLabels;
+	for(const auto eCore: asRange(edges(gCore))) {
+		const auto vSrc = coreToVertex[get(boost::vertex_index_t(), gCore, source(eCore, gCore))];
+		const auto vTar = coreToVertex[get(boost::vertex_index_t(), gCore, target(eCore, gCore))];
+		const auto m = membership(rDPO, eCore);
+		if(m == Membership::R) {
+			newEdges.emplace_back(vSrc, vTar);
+			newEdgeLabels.push_back(&*pCore[eCore].second);
+			continue;
+		}
+		// a matched edge, so both ends are in the same copy
+		const auto copy = std::upper_bound(vOffset.begin(), vOffset.end(), vSrc) - vOffset.begin() - 1;
+		const auto &gHost = b.boundGraphs[copy]->getGraph();
+		const auto ep = edge(vertex(vSrc - vOffset[copy], gHost), vertex(vTar - vOffset[copy], gHost), gHost);
+		assert(ep.second);
+		const auto e = eOffset[copy] + get(boost::edge_index_t(), gHost, ep.first);
+		eLabel[e] = m == Membership::L ? nullptr : &*pCore[eCore].second;
+	}
+
+	// find the connected components
+	std::vector<std::size_t> parent(vLabel.size());
+	std::iota(parent.begin(), parent.end(), 0);
+	const auto find = [&parent](std::size_t v) {
+		while(parent[v] != v) v = parent[v] = parent[parent[v]];
+		return v;
+	};
+	const auto unite = [&](std::size_t a, std::size_t b) {
+		parent[find(a)] = find(b);
+	};
+	const auto forEachOldEdge = [&](auto f) {
+		for(std::size_t i = 0; i != numCopies; ++i) {
+			const auto &gHost = b.boundGraphs[i]->getGraph();
+			for(const auto e: asRange(edges(gHost))) {
+				const auto eId = eOffset[i] + get(boost::edge_index_t(), gHost, e);
+				if(!eLabel[eId]) continue;
+				f(vOffset[i] + get(boost::vertex_index_t(), gHost, source(e, gHost)),
+				  vOffset[i] + get(boost::vertex_index_t(), gHost, target(e, gHost)),
+				  *eLabel[eId]);
+			}
+		}
+	};
+	forEachOldEdge([&](std::size_t vSrc, std::size_t vTar, const std::string &) {
+		unite(vSrc, vTar);
+	});
+	for(const auto &[vSrc, vTar]: newEdges)
+		unite(vSrc, vTar);
+
+	std::vector<GraphData> products;
+	std::vector<int> rootToProduct(vLabel.size(), -1);
+	std::vector<int> vertexProduct(vLabel.size(), -1);
+	std::vector<lib::graph::Vertex> vertexMap(vLabel.size());
+	for(std::size_t v = 0; v != vLabel.size(); ++v) {
+		if(!vLabel[v]) continue;
+		auto &pIdx = rootToProduct[find(v)];
+		if(pIdx == -1) {
+			pIdx = products.size();
+			products.emplace_back();
+		}
+		auto &p = products[pIdx];
+		vertexProduct[v] = pIdx;
+		vertexMap[v] = add_vertex(*p.gPtr);
+		p.pStringPtr->addVertex(vertexMap[v], *vLabel[v]);
+	}
+	const auto addEdge = [&](std::size_t vSrc, std::size_t vTar, const std::string &label) {
+		assert(vLabel[vSrc] && vLabel[vTar]);
+		auto &p = products[vertexProduct[vSrc]];
+		const auto ep = add_edge(vertexMap[vSrc], vertexMap[vTar], *p.gPtr);
+		assert(ep.second);
+		p.pStringPtr->addEdge(ep.first, label);
+	};
+	forEachOldEdge(addEdge);
+	for(std::size_t i = 0; i != newEdges.size(); ++i)
+		addEdge(newEdges[i].first, newEdges[i].second, *newEdgeLabels[i]);
+	return products;
+}
+
+} // namespace mod::lib::DG
@@ -0,0 +1,100 @@
+#ifndef MOD_LIB_DG_DIRECTRULEAPPLICATION_HPP
+#define MOD_LIB_DG_DIRECTRULEAPPLICATION_HPP
+
+#include <mod/lib/DG/ComponentMatchCache.hpp>
+#include <mod/lib/DG/RuleApplicationUtils.hpp>
+
+#include <functional>
+#include <iosfwd>
+#include <unordered_map>
+#include <vector>
+
+namespace mod::lib::DG {
+
+// Rule application without composition.
+// Instead of composing bind rules of the graphs with the rule, the left-hand components
+// are matched directly into the graphs, and the products are constructed in place from
+// the matched graphs.
+// This is only done for string labels, without stereo, and for rules without match constraints.
+// In that case the resulting derivations are the same as with composition.
+// It can be disabled with getConfig().dg.directRuleApplication.
+bool canApplyDirectly(const lib::rule::Rule &r, LabelSettings labelSettings);
+
+// A (partial) application of a rule to copies of graphs.
+// Each left-hand component is either not yet bound, or matched into one of the copies.
+struct DirectBinding {
+	// the graph of each copy, in the order they were bound
+	std::vector<const lib::graph::Graph *> boundGraphs;
+	// for each left-hand component, the copy it is matched into, or -1 if it is not bound yet
+	std::vector<int> componentCopy;
+	// for each left-hand component, the host vertex index of each component vertex, or nullptr
+	std::vector<const std::vector<std::size_t> *> componentMatch;
+	int nextGraphOffset;
+	int numUnbound;
+public:
+	bool isComplete() const {
+		return numUnbound == 0;
+	}
+
+	friend std::ostream &operator<<(std::ostream &s, const DirectBinding &b);
+};
+
+struct DirectRuleApplier {
+	// Requires canApplyDirectly(r, labelSettings).
+	// The matches of the left-hand components are looked up in, and added to, componentMatchCache,
+	// which must only be used with the same label settings.
+	DirectRuleApplier(const lib::rule::Rule &r, rule::GraphAsRuleCache &graphAsRuleCache,
+	                  ComponentMatchCache &componentMatchCache, LabelSettings labelSettings);
+	~DirectRuleApplier();
+	const lib::rule::Rule &getRule() const;
+	// The binding with no graphs bound.
+	DirectBinding makeInitial() const;
+	// The counterpart to bindGraphs:
+	// each input binding is extended by matching at least one unbound component into a copy of a graph from
+	// graphs[nextGraphOffset], ..., graphs[numGraphs - 1].
+	// All new bindings are given to onOutput, which must return whether to continue the search
+	// with the current input binding and graph.
+	// The incomplete bindings are returned.
+	// As with the bound rules of the composition, if doRuleIsomorphism, then an incomplete binding
+	// equivalent to an earlier one, up to automorphisms of the rule and isomorphisms of the bound graphs,
+	// is discarded without being given to onOutput.
+	// If stats is not nullptr, then the bindings and the discarded duplicates are counted in it.
+	// If getConfig().common.numThreads > 1, then the matching is distributed over multiple threads,
+	// but the results are given to onOutput in the same order as in the serial execution.
+	[[nodiscard]] std::vector<DirectBinding> bindGraphs(
+			int verbosity, IO::Logger &logger,
+			int bindRound,
+			const std::vector<const lib::graph::Graph *> &graphs, std::size_t numGraphs,
+			const std::vector<DirectBinding> &inputBindings,
+			bool doRuleIsomorphism, RuleStats *stats,
+			std::function<bool(IO::Logger, const DirectBinding &)> onOutput);
+	// Construct the connected components of the graph derived by a complete binding.
+	std::vector<GraphData> makeProducts(const DirectBinding &b) const;
+private:
+	using Matches = ComponentMatchCache::Matches;
+	struct BindingState;
+	BindingState makeState(const DirectBinding &b) const;
+	void prepareMatches(const std::vector<const lib::graph::Graph *> &graphs, std::size_t first, std::size_t last);
+	Matches computeMatches(const lib::graph::Graph *g, const lib::rule::Rule &rBind) const;
+	void extend(const DirectBinding &bInput, int graphOffset, const lib::graph::Graph *g,
+	            std::vector<DirectBinding> &out) const;
+private:
+	const lib::rule::Rule &r;
+	rule::GraphAsRuleCache &graphAsRuleCache;
+	ComponentMatchCache &componentMatchCache;
+	const LabelSettings labelSettings;
+	// for each left-hand component, its vertices (in the combined graph of the rule)
+	std::vector<std::vector<std::size_t>> componentVertices;
+	// for each vertex in the combined graph: its left-hand component and position in it, or -1 if right-only
+	std::vector<int> vertexComponent, vertexPosition;
+	// for each vertex in the combined graph: its degree in L if it is left-only, otherwise -1
+	std::vector<int> deletedVertexDegree;
+	// the right-only edges between left-hand vertices, which are not allowed to have a host edge
+	std::vector<std::pair<std::size_t, std::size_t>> newEdgesOnOld;
+	// the matches used by this applier, the bindings point into them
+	std::unordered_map<const lib::graph::Graph *, std::shared_ptr<const Matches>> matchCache;
+};
+
+} // namespace mod::lib::DG
+
+#endif // MOD_LIB_DG_DIRECTRULEAPPLICATION_HPP
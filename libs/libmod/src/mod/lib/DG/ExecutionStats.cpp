@@ -0,0 +1,86 @@
+#include "ExecutionStats.hpp"
+
+#include <mod/lib/Rule/Rule.hpp>
+
+namespace mod::lib::DG {
+namespace {
+
+double toSeconds(StatsClock::duration d) {
+	return std::chrono::duration<double>(d).count();
+}
+
+nlohmann::json toJson(const GraphMorphism::VF2Counters &c) {
+	return {
+			{"calls",          c.numCalls},
+			{"candidatePairs", c.numCandidatePairs}
+	};
+}
+
+} // namespace
+
+RuleStats &ExecutionStats::getRuleStats(const lib::rule::Rule &r) {
+	const auto iter = ruleIndex.find(&r);
+	if(iter != ruleIndex.end()) return rules[iter->second];
+	ruleIndex.emplace(&r, rules.size());
+	rules.emplace_back();
+	rules.back().name = r.getName();
+	return rules.back();
+}
+
+nlohmann::json ExecutionStats::toJson() const {
+	nlohmann::json jRules = nlohmann::json::array();
+	for(const RuleStats &rs: rules) {
+		jRules.push_back({
+				{"name",                rs.name},
+				{"executions",          rs.numExecutions},
+				{"vf2",                 DG::toJson(rs.vf2)},
+				{"compositions",        rs.numCompositions},
+				{"boundRules",          {
+						                        {"created", rs.numBoundRules},
+						                        {"duplicates", rs.numBoundRulesDuplicate}
+				                        }},
+				{"checkIfNew",          {
+						                        {"hits", rs.numCheckIfNewHits},
+						                        {"misses", rs.numCheckIfNewMisses}
+				                        }},
+				{"predicateRejections", {
+						                        {"left", rs.numLeftPredicateRejections},
+						                        {"right", rs.numRightPredicateRejections}
+				                        }},
+				{"derivations",         rs.numDerivations},
+				{"time",                {
+						                        {"total", toSeconds(rs.timeTotal)},
+						                        {"products", toSeconds(rs.timeProducts)}
+				                        }}
+		});
+	}
+	return {
+			{"time",                toSeconds(timeTotal)},
+			{"vf2",                 DG::toJson(vf2)},
+			{"componentMatchCache", {
+					                        {"hits", componentMatchCache.numHits},
+					                        {"misses", componentMatchCache.numMisses},
+					                        {"evictions", componentMatchCache.numEvictions}
+			                        }},
+			{"rules",               std::move(jRules)}
+	};
+}
+
+RuleStatsScope::RuleStatsScope(ExecutionStats *stats, const lib::rule::Rule &r) {
+	if(!stats) return;
+	ruleStats = &stats->getRuleStats(r);
+	++ruleStats->numExecutions;
+	vf2Outer = GraphMorphism::getThreadVF2Counters();
+	vf2Scope.emplace(&vf2);
+	start = StatsClock::now();
+}
+
+RuleStatsScope::~RuleStatsScope() {
+	if(!ruleStats) return;
+	ruleStats->timeTotal += StatsClock::now() - start;
+	vf2Scope.reset();
+	ruleStats->vf2 += vf2;
+	if(vf2Outer) *vf2Outer += vf2;
+}
+
+} // namespace mod::lib::DG
@@ -0,0 +1,104 @@
+#ifndef MOD_LIB_DG_EXECUTIONSTATS_HPP
+#define MOD_LIB_DG_EXECUTIONSTATS_HPP
+
+#include <mod/lib/DG/ComponentMatchCache.hpp>
+#include <mod/lib/GraphMorphism/VF2Counters.hpp>
+#include <mod/lib/IO/Json.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace mod::lib::rule {
+struct Rule;
+} // namespace mod::lib::rule
+namespace mod::lib::DG {
+
+using StatsClock = std::chrono::steady_clock;
+
+// The statistics for all executions of a rule strategy.
+struct RuleStats {
+	std::string name;
+	unsigned int numExecutions = 0;
+	GraphMorphism::VF2Counters vf2;
+	// calls to composeFromMatchMaker when binding graphs through composition
+	std::uint64_t numCompositions = 0;
+	// bound rules (or direct bindings) created, and those discarded as duplicates
+	std::uint64_t numBoundRules = 0;
+	std::uint64_t numBoundRulesDuplicate = 0;
+	// product graphs that were found in the graph database, and those that were new
+	std::uint64_t numCheckIfNewHits = 0;
+	std::uint64_t numCheckIfNewMisses = 0;
+	std::uint64_t numLeftPredicateRejections = 0;
+	std::uint64_t numRightPredicateRejections = 0;
+	// derivations accepted by the predicates, including those already in the DG
+	std::uint64_t numDerivations = 0;
+	StatsClock::duration timeTotal{};
+	// constructing the product graphs, i.e., splitRule or the direct construction,
+	// including the checkIfNew calls
+	StatsClock::duration timeProducts{};
+};
+
+// Statistics for the execution of a strategy, collected when getConfig().dg.collectStats is true.
+// All counters are only updated from the thread executing the strategy,
+// parallel tasks count locally and are merged afterwards.
+struct ExecutionStats {
+	// The entry for the given rule, entries are ordered by their first use.
+	// Clones of a rule strategy (e.g., in different rounds of a repeat strategy) share the entry.
+	RuleStats &getRuleStats(const lib::rule::Rule &r);
+	nlohmann::json toJson() const;
+public:
+	// all VF2 searches during the execution, including those done by rule strategies
+	GraphMorphism::VF2Counters vf2;
+	// the lookups in the component match cache of the DG during the execution
+	ComponentMatchCacheStats componentMatchCache;
+	StatsClock::duration timeTotal{};
+private:
+	std::deque<RuleStats> rules; // for stable references
+	std::unordered_map<const lib::rule::Rule *, std::size_t> ruleIndex;
+};
+
+// Collects the statistics of one execution of a rule strategy.
+// With stats == nullptr nothing is collected.
+struct RuleStatsScope {
+	RuleStatsScope(ExecutionStats *stats, const lib::rule::Rule &r);
+	RuleStatsScope(const RuleStatsScope &) = delete;
+	RuleStatsScope &operator=(const RuleStatsScope &) = delete;
+	// Adds the elapsed time and the VF2 searches to the rule entry,
+	// and the VF2 searches to the enclosing counters as well.
+	~RuleStatsScope();
+	// The entry of the rule, or nullptr if no statistics are collected.
+	RuleStats *get() const {
+		return ruleStats;
+	}
+private:
+	RuleStats *ruleStats = nullptr;
+	GraphMorphism::VF2Counters *vf2Outer = nullptr;
+	GraphMorphism::VF2Counters vf2;
+	std::optional<GraphMorphism::VF2CounterScope> vf2Scope;
+	StatsClock::time_point start;
+};
+
+// Adds the time until destruction to the given duration, if it is not nullptr.
+struct StatsTimer {
+	explicit StatsTimer(StatsClock::duration *d) : d(d) {
+		if(d) start = StatsClock::now();
+	}
+
+	StatsTimer(const StatsTimer &) = delete;
+	StatsTimer &operator=(const StatsTimer &) = delete;
+
+	~StatsTimer() {
+		if(d) *d += StatsClock::now() - start;
+	}
+private:
+	StatsClock::duration *d;
+	StatsClock::time_point start;
+};
+
+} // namespace mod::lib::DG
+
+#endif // MOD_LIB_DG_EXECUTIONSTATS_HPP
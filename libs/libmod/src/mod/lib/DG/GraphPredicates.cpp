@@ -0,0 +1,344 @@
+#include "GraphPredicates.hpp"
+
+#include <mod/Derivation.hpp>
+#include <mod/Error.hpp>
+#include <mod/Function.hpp>
+#include <mod/graph/Graph.hpp>
+#include <mod/lib/Graph/Graph.hpp>
+#include <mod/lib/Graph/Properties/Molecule.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <ostream>
+
+namespace mod::lib::DG::GraphPredicates {
+
+//------------------------------------------------------------------------------
+// Value
+//------------------------------------------------------------------------------
+
+namespace {
+
+double countLabel(const std::vector<std::pair<LabelId, std::size_t>> &histogram, LabelId labelId) {
+	const auto iter = std::lower_bound(histogram.begin(), histogram.end(), labelId,
+	                                   [](const auto &p, LabelId id) {
+		                                   return p.first < id;
+	                                   });
+	if(iter == histogram.end() || iter->first != labelId) return 0;
+	return iter->second;
+}
+
+// the L1 distance between the label multisets
+double labelDistance(const std::vector<std::pair<LabelId, std::size_t>> &a,
+                     const std::vector<std::pair<LabelId, std::size_t>> &b) {
+	double res = 0;
+	auto iterA = a.begin();
+	auto iterB = b.begin();
+	while(iterA != a.end() && iterB != b.end()) {
+		if(iterA->first < iterB->first) {
+			res += iterA->second;
+			++iterA;
+		} else if(iterB->first < iterA->first) {
+			res += iterB->second;
+			++iterB;
+		} else {
+			res += std::abs(double(iterA->second) - double(iterB->second));
+			++iterA;
+			++iterB;
+		}
+	}
+	for(; iterA != a.end(); ++iterA) res += iterA->second;
+	for(; iterB != b.end(); ++iterB) res += iterB->second;
+	return res;
+}
+
+} // namespace
+
+Value::Value(Quantity quantity, std::string label)
+		: quantity(quantity), label(std::move(label)), labelId(0), targetMass(0) {
+	assert(quantity != Quantity::MassDistance && quantity != Quantity::VertexLabelDistance);
+	if(quantity == Quantity::VertexLabelCount || quantity == Quantity::EdgeLabelCount)
+		labelId = internLabel(this->label);
+}
+
+Value::Value(Quantity quantity, const lib::graph::Graph &target)
+		: quantity(quantity), label(target.getName()), labelId(0), targetMass(target.getSummary().exactMass),
+		  targetVertexLabels(target.getFingerprint().vertexLabels) {
+	assert(quantity == Quantity::MassDistance || quantity == Quantity::VertexLabelDistance);
+}
+
+double Value::operator()(const lib::graph::Graph &g) const {
+	switch(quantity) {
+	case Quantity::NumVertices: return g.getSummary().numVertices;
+	case Quantity::NumEdges: return g.getSummary().numEdges;
+	case Quantity::NumComponents: return 1; // graphs are connected
+	case Quantity::NumRings: return double(g.getSummary().numEdges) - double(g.getSummary().numVertices) + 1;
+	case Quantity::VertexLabelCount: return countLabel(g.getFingerprint().vertexLabels, labelId);
+	case Quantity::EdgeLabelCount: return countLabel(g.getFingerprint().edgeLabels, labelId);
+	case Quantity::ExactMass: return g.getSummary().exactMass;
+	case Quantity::Charge: return g.getSummary().charge;
+	case Quantity::NumChargedVertices: return g.getSummary().numChargedVertices;
+	case Quantity::NumRadicals: return g.getSummary().numRadicals;
+	case Quantity::Energy: {
+		const auto &pMol = get_molecule(g.getLabelledGraph());
+		if(!pMol.getIsMolecule()) return std::numeric_limits<double>::quiet_NaN();
+		return pMol.getEnergy();
+	}
+	case Quantity::MassDistance: return std::abs(g.getSummary().exactMass - targetMass);
+	case Quantity::VertexLabelDistance: return labelDistance(g.getFingerprint().vertexLabels, targetVertexLabels);
+	}
+	MOD_ABORT;
+}
+
+double Value::operator()(const Graphs &gs) const {
+	return std::accumulate(gs.begin(), gs.end(), 0.0, [this](double acc, const lib::graph::Graph *g) {
+		return acc + (*this)(*g);
+	});
+}
+
+std::ostream &operator<<(std::ostream &s, const Value &v) {
+	switch(v.quantity) {
+	case Quantity::NumVertices: return s << "numVertices";
+	case Quantity::NumEdges: return s << "numEdges";
+	case Quantity::NumComponents: return s << "numComponents";
+	case Quantity::NumRings: return s << "numRings";
+	case Quantity::VertexLabelCount: return s << "vertexLabelCount('" << v.label << "')";
+	case Quantity::EdgeLabelCount: return s << "edgeLabelCount('" << v.label << "')";
+	case Quantity::ExactMass: return s << "exactMass";
+	case Quantity::Charge: return s << "charge";
+	case Quantity::NumChargedVertices: return s << "numChargedVertices";
+	case Quantity::NumRadicals: return s << "numRadicals";
+	case Quantity::Energy: return s << "energy";
+	case Quantity::MassDistance: return s << "massDistance('" << v.label << "')";
+	case Quantity::VertexLabelDistance: return s << "vertexLabelDistance('" << v.label << "')";
+	}
+	MOD_ABORT;
+}
+
+//------------------------------------------------------------------------------
+// Predicate
+//------------------------------------------------------------------------------
+
+Predicate::~Predicate() = default;
+
+namespace {
+
+struct Compare : Predicate {
+	Compare(Value value, Relation relation, double constant)
+			: value(std::move(value)), relation(relation), constant(constant) {}
+
+	bool operator()(const Graphs &gs) const override {
+		// all comparisons with NaN, e.g., the mass of a non-molecule, are false, also !=
+		const double v = value(gs);
+		switch(relation) {
+		case Relation::Less: return v < constant;
+		case Relation::LessEqual: return v <= constant;
+		case Relation::Greater: return v > constant;
+		case Relation::GreaterEqual: return v >= constant;
+		case Relation::Equal: return v == constant;
+		case Relation::NotEqual: return v < constant || v > constant;
+		}
+		MOD_ABORT;
+	}
+
+	void print(std::ostream &s) const override {
+		s << value << ' ';
+		switch(relation) {
+		case Relation::Less: s << "<"; break;
+		case Relation::LessEqual: s << "<="; break;
+		case Relation::Greater: s << ">"; break;
+		case Relation::GreaterEqual: s << ">="; break;
+		case Relation::Equal: s << "=="; break;
+		case Relation::NotEqual: s << "!="; break;
+		}
+		s << ' ' << constant;
+	}
+private:
+	const Value value;
+	const Relation relation;
+	const double constant;
+};
+
+struct Binary : Predicate {
+	Binary(std::shared_ptr<const Predicate> l, std::shared_ptr<const Predicate> r, bool isAnd)
+			: l(std::move(l)), r(std::move(r)), isAnd(isAnd) {}
+
+	bool operator()(const Graphs &gs) const override {
+		if(isAnd) return (*l)(gs) && (*r)(gs);
+		else return (*l)(gs) || (*r)(gs);
+	}
+
+	void print(std::ostream &s) const override {
+		s << '(';
+		l->print(s);
+		s << (isAnd ? " && " : " || ");
+		r->print(s);
+		s << ')';
+	}
+private:
+	const std::shared_ptr<const Predicate> l, r;
+	const bool isAnd;
+};
+
+struct Not : Predicate {
+	Not(std::shared_ptr<const Predicate> p) : p(std::move(p)) {}
+
+	bool operator()(const Graphs &gs) const override {
+		return !(*p)(gs);
+	}
+
+	void print(std::ostream &s) const override {
+		s << '!';
+		p->print(s);
+	}
+private:
+	const std::shared_ptr<const Predicate> p;
+};
+
+struct Quantifier : Predicate {
+	Quantifier(std::shared_ptr<const Predicate> p, bool isAll) : p(std::move(p)), isAll(isAll) {}
+
+	bool operator()(const Graphs &gs) const override {
+		Graphs single(1);
+		const auto holds = [this, &single](const lib::graph::Graph *g) {
+			single.front() = g;
+			return (*p)(single);
+		};
+		if(isAll) return std::all_of(gs.begin(), gs.end(), holds);
+		else return std::any_of(gs.begin(), gs.end(), holds);
+	}
+
+	void print(std::ostream &s) const override {
+		s << (isAll ? "all(" : "any(");
+		p->print(s);
+		s << ')';
+	}
+private:
+	const std::shared_ptr<const Predicate> p;
+	const bool isAll;
+};
+
+} // namespace
+
+std::shared_ptr<const Predicate> makeCompare(Value value, Relation relation, double constant) {
+	return std::make_shared<Compare>(std::move(value), relation, constant);
+}
+
+std::shared_ptr<const Predicate> makeAnd(std::shared_ptr<const Predicate> l, std::shared_ptr<const Predicate> r) {
+	assert(l);
+	assert(r);
+	return std::make_shared<Binary>(std::move(l), std::move(r), true);
+}
+
+std::shared_ptr<const Predicate> makeOr(std::shared_ptr<const Predicate> l, std::shared_ptr<const Predicate> r) {
+	assert(l);
+	assert(r);
+	return std::make_shared<Binary>(std::move(l), std::move(r), false);
+}
+
+std::shared_ptr<const Predicate> makeNot(std::shared_ptr<const Predicate> p) {
+	assert(p);
+	return std::make_shared<Not>(std::move(p));
+}
+
+std::shared_ptr<const Predicate> makeAll(std::shared_ptr<const Predicate> p) {
+	assert(p);
+	return std::make_shared<Quantifier>(std::move(p), true);
+}
+
+std::shared_ptr<const Predicate> makeAny(std::shared_ptr<const Predicate> p) {
+	assert(p);
+	return std::make_shared<Quantifier>(std::move(p), false);
+}
+
+//------------------------------------------------------------------------------
+// Function objects
+//------------------------------------------------------------------------------
+
+namespace {
+
+struct FilterFunction
+		: mod::Function<bool(std::shared_ptr<mod::graph::Graph>, const dg::Strategy::GraphState &, bool)> {
+	FilterFunction(std::shared_ptr<const Predicate> p) : p(std::move(p)) {}
+
+	std::shared_ptr<mod::Function<bool(std::shared_ptr<mod::graph::Graph>, const dg::Strategy::GraphState &, bool)>>
+	clone() const override {
+		return std::make_shared<FilterFunction>(p);
+	}
+
+	void print(std::ostream &s) const override {
+		p->print(s);
+	}
+
+	bool operator()(std::shared_ptr<mod::graph::Graph> g, const dg::Strategy::GraphState &, bool) const override {
+		return (*p)(Graphs{&g->getGraph()});
+	}
+private:
+	const std::shared_ptr<const Predicate> p;
+};
+
+struct DerivationFunction : mod::Function<bool(const mod::Derivation &)> {
+	DerivationFunction(std::shared_ptr<const Predicate> p, bool onRight) : p(std::move(p)), onRight(onRight) {}
+
+	std::shared_ptr<mod::Function<bool(const mod::Derivation &)>> clone() const override {
+		return std::make_shared<DerivationFunction>(p, onRight);
+	}
+
+	void print(std::ostream &s) const override {
+		p->print(s);
+	}
+
+	bool operator()(const mod::Derivation &d) const override {
+		const auto &side = onRight ? d.right : d.left;
+		Graphs gs;
+		gs.reserve(side.size());
+		for(const auto &g : side) gs.push_back(&g->getGraph());
+		return (*p)(gs);
+	}
+private:
+	const std::shared_ptr<const Predicate> p;
+	const bool onRight;
+};
+
+struct ValueFunction : mod::Function<double(std::shared_ptr<mod::graph::Graph>)> {
+	ValueFunction(std::shared_ptr<const Value> v) : v(std::move(v)) {}
+
+	std::shared_ptr<mod::Function<double(std::shared_ptr<mod::graph::Graph>)>> clone() const override {
+		return std::make_shared<ValueFunction>(v);
+	}
+
+	void print(std::ostream &s) const override {
+		s << *v;
+	}
+
+	double operator()(std::shared_ptr<mod::graph::Graph> g) const override {
+		return (*v)(g->getGraph());
+	}
+private:
+	const std::shared_ptr<const Value> v;
+};
+
+} // namespace
+
+std::shared_ptr<mod::Function<bool(std::shared_ptr<mod::graph::Graph>, const dg::Strategy::GraphState &, bool)>>
+makeFilterFunction(std::shared_ptr<const Predicate> p) {
+	assert(p);
+	return std::make_shared<FilterFunction>(std::move(p));
+}
+
+std::shared_ptr<mod::Function<bool(const mod::Derivation &)>>
+makeDerivationFunction(std::shared_ptr<const Predicate> p, bool onRight) {
+	assert(p);
+	return std::make_shared<DerivationFunction>(std::move(p), onRight);
+}
+
+std::shared_ptr<mod::Function<double(std::shared_ptr<mod::graph::Graph>)>>
+makeValueFunction(std::shared_ptr<const Value> v) {
+	assert(v);
+	return std::make_shared<ValueFunction>(std::move(v));
+}
+
+} // namespace mod::lib::DG::GraphPredicates
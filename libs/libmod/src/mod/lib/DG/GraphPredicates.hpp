@@ -0,0 +1,77 @@
+#ifndef MOD_LIB_DG_GRAPHPREDICATES_HPP
+#define MOD_LIB_DG_GRAPHPREDICATES_HPP
+
+#include <mod/dg/Strategies.hpp>
+#include <mod/lib/StringStore.hpp>
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mod::lib::graph {
+struct Graph;
+} // namespace mod::lib::graph
+namespace mod::lib::DG::GraphPredicates {
+
+// A multiset of graphs, e.g., a side of a derivation, or a single graph being filtered.
+using Graphs = std::vector<const lib::graph::Graph *>;
+
+enum class Quantity {
+	NumVertices, NumEdges, NumComponents, NumRings,
+	VertexLabelCount, EdgeLabelCount,
+	ExactMass, Charge, NumChargedVertices, NumRadicals,
+	Energy,
+	// relative to a target graph, for use as heuristics
+	MassDistance, VertexLabelDistance
+};
+
+// A quantity of a multiset of graphs, which is the sum of the quantity over the graphs.
+// The per-graph values are from lib::graph::Graph::getSummary() and getFingerprint(), so they are computed once.
+struct Value {
+	Value(Quantity quantity, std::string label = "");
+	// For the distances, the relevant data of the target is copied.
+	Value(Quantity quantity, const lib::graph::Graph &target);
+	double operator()(const lib::graph::Graph &g) const;
+	double operator()(const Graphs &gs) const;
+	friend std::ostream &operator<<(std::ostream &s, const Value &v);
+private:
+	Quantity quantity;
+	std::string label; // for the label counts, and the name of the target for the distances
+	LabelId labelId;
+	double targetMass;
+	std::vector<std::pair<LabelId, std::size_t>> targetVertexLabels;
+};
+
+enum class Relation {
+	Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual
+};
+
+// Immutable, so nodes are shared between the predicates built from them.
+struct Predicate {
+	virtual ~Predicate();
+	virtual bool operator()(const Graphs &gs) const = 0;
+	virtual void print(std::ostream &s) const = 0;
+};
+
+std::shared_ptr<const Predicate> makeCompare(Value value, Relation relation, double constant);
+std::shared_ptr<const Predicate> makeAnd(std::shared_ptr<const Predicate> l, std::shared_ptr<const Predicate> r);
+std::shared_ptr<const Predicate> makeOr(std::shared_ptr<const Predicate> l, std::shared_ptr<const Predicate> r);
+std::shared_ptr<const Predicate> makeNot(std::shared_ptr<const Predicate> p);
+// Whether p holds for each graph, respectively for some graph, on its own.
+std::shared_ptr<const Predicate> makeAll(std::shared_ptr<const Predicate> p);
+std::shared_ptr<const Predicate> makeAny(std::shared_ptr<const Predicate> p);
+
+// Function objects for the existing strategies, which evaluate p without going through the API graph objects.
+std::shared_ptr<mod::Function<bool(std::shared_ptr<mod::graph::Graph>, const dg::Strategy::GraphState &, bool)>>
+makeFilterFunction(std::shared_ptr<const Predicate> p);
+// p is evaluated on the left, respectively the right, side of the derivation.
+std::shared_ptr<mod::Function<bool(const mod::Derivation &)>>
+makeDerivationFunction(std::shared_ptr<const Predicate> p, bool onRight);
+// The value of each graph on its own, e.g., as the score in Strategies::BestFirst.
+std::shared_ptr<mod::Function<double(std::shared_ptr<mod::graph::Graph>)>>
+makeValueFunction(std::shared_ptr<const Value> v);
+
+} // namespace mod::lib::DG::GraphPredicates
+
+#endif // MOD_LIB_DG_GRAPHPREDICATES_HPP
@@ -300,6 +300,8 @@ void Hyper::printStats(std::ostream &s) const {
 	s << "numUniqueOutOnlyReverse:               " << numUniqueOutOnlyReverse << std::endl;
 	s << "projectedNumTransitCollapseNonReverse: " << projectedNumTransitCollapseNonReverse << std::endl;
 	s << "------------------------------------------------------------------" << std::endl;
+	nonHyper.getGraphDatabase().printIndexStats(s);
+	s << "------------------------------------------------------------------" << std::endl;
 }
 
 bool Hyper::isVertexGraph(const lib::graph::Graph *g) const {
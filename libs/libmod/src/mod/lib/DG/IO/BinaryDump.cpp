@@ -0,0 +1,558 @@
+#include "BinaryDump.hpp"
+
+#include <mod/Error.hpp>
+#include <mod/Post.hpp>
+#include <mod/lib/DG/Hyper.hpp>
+#include <mod/lib/DG/NonHyper.hpp>
+#include <mod/lib/Graph/Graph.hpp>
+#include <mod/lib/Graph/Properties/Stereo.hpp>
+#include <mod/lib/Graph/Properties/String.hpp>
+#include <mod/lib/IO/Config.hpp>
+#include <mod/lib/Rule/Rule.hpp>
+#include <mod/lib/Rule/IO/Write.hpp>
+
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
+
+#include <boost/crc.hpp>
+
+#include <cstring>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <unordered_map>
+
+namespace mod::lib::DG::BinaryDump {
+namespace {
+
+constexpr char magic[8] = {'M', 'O', 'D', 'D', 'G', 'B', 'I', 'N'};
+constexpr std::size_t headerSize = sizeof(magic) + 4 + 4 + 4 + 4 * 8;
+constexpr std::size_t trailerSize = 4;
+constexpr std::uint32_t flagVerticesAreUnique = 1;
+
+struct Buffer {
+	void u8(std::uint8_t v) {
+		data.push_back(static_cast<char>(v));
+	}
+
+	void u32(std::uint32_t v) {
+		data.append(reinterpret_cast<const char *>(&v), sizeof(v));
+	}
+
+	void u64(std::uint64_t v) {
+		data.append(reinterpret_cast<const char *>(&v), sizeof(v));
+	}
+
+	void setU64(std::size_t pos, std::uint64_t v) {
+		std::memcpy(data.data() + pos, &v, sizeof(v));
+	}
+public:
+	std::string data;
+};
+
+struct StringTable {
+	std::uint32_t operator()(const std::string &s) {
+		const auto p = ids.emplace(s, strings.size());
+		if(p.second) strings.push_back(&p.first->first);
+		return p.first->second;
+	}
+public:
+	std::unordered_map<std::string, std::uint32_t> ids;
+	std::vector<const std::string *> strings;
+};
+
+} // namespace
+
+bool isBinaryDump(const char *first, const char *last) {
+	return last - first >= static_cast<std::ptrdiff_t>(sizeof(magic))
+	       && std::equal(magic, magic + sizeof(magic), first);
+}
+
+void write(const NonHyper &dgNonHyper, const std::string &file) {
+	if(dgNonHyper.getLabelSettings().withStereo)
+		throw mod::LogicError("Can not yet dump DGs with stereo data.");
+	const auto &dgHyper = dgNonHyper.getHyper();
+	const auto &dg = dgHyper.getGraph();
+
+	StringTable strings;
+	Buffer vertexRecords;
+	std::vector<std::uint64_t> vertexOffsets;
+	for(const auto v: asRange(vertices(dg))) {
+		if(dg[v].kind != HyperVertexKind::Vertex) continue;
+		const lib::graph::Graph *g = dg[v].graph;
+		assert(g);
+		const auto &graph = g->getGraph();
+		const auto &pString = g->getStringState();
+		vertexOffsets.push_back(vertexRecords.data.size());
+		vertexRecords.u32(get(boost::vertex_index_t(), dg, v));
+		vertexRecords.u32(strings(g->getName()));
+		vertexRecords.u32(num_vertices(graph));
+		vertexRecords.u32(num_edges(graph));
+		for(const auto vG: asRange(vertices(graph)))
+			vertexRecords.u32(strings(pString[vG]));
+		for(const auto eG: asRange(edges(graph))) {
+			vertexRecords.u32(get(boost::vertex_index_t(), graph, source(eG, graph)));
+			vertexRecords.u32(get(boost::vertex_index_t(), graph, target(eG, graph)));
+			vertexRecords.u32(strings(pString[eG]));
+		}
+	}
+
+	std::set<const lib::rule::Rule *, lib::rule::LessById> rules;
+	for(const auto v: asRange(vertices(dg))) {
+		if(dg[v].kind != HyperVertexKind::Edge) continue;
+		for(const auto *r: dgHyper.getRulesFromEdge(v))
+			rules.insert(r);
+	}
+	Buffer ruleSection;
+	ruleSection.u32(rules.size());
+	std::unordered_map<const lib::rule::Rule *, std::uint32_t> idFromRule;
+	for(const auto *r: rules) {
+		std::ostringstream ss;
+		rule::Write::gml(*r, false, ss);
+		const auto gml = ss.str();
+		ruleSection.u32(gml.size());
+		ruleSection.data += gml;
+		idFromRule.emplace(r, idFromRule.size());
+	}
+
+	Buffer edgeRecords;
+	std::vector<std::uint64_t> edgeOffsets;
+	for(const auto v: asRange(vertices(dg))) {
+		if(dg[v].kind != HyperVertexKind::Edge) continue;
+		const auto &edgeRules = dgHyper.getRulesFromEdge(v);
+		edgeOffsets.push_back(edgeRecords.data.size());
+		edgeRecords.u32(get(boost::vertex_index_t(), dg, v));
+		edgeRecords.u32(in_degree(v, dg));
+		edgeRecords.u32(out_degree(v, dg));
+		edgeRecords.u32(edgeRules.size());
+		for(const auto e: asRange(in_edges(v, dg)))
+			edgeRecords.u32(get(boost::vertex_index_t(), dg, source(e, dg)));
+		for(const auto e: asRange(out_edges(v, dg)))
+			edgeRecords.u32(get(boost::vertex_index_t(), dg, target(e, dg)));
+		for(const auto *r: edgeRules)
+			edgeRecords.u32(idFromRule.at(r));
+	}
+
+	// and now put it all together
+	Buffer out;
+	out.data.append(magic, sizeof(magic));
+	out.u32(version);
+	out.u32(flagVerticesAreUnique);
+	const auto ls = dgNonHyper.getLabelSettings();
+	out.u8(static_cast<std::uint8_t>(ls.type));
+	out.u8(static_cast<std::uint8_t>(ls.relation));
+	out.u8(ls.withStereo);
+	out.u8(static_cast<std::uint8_t>(ls.stereoRelation));
+	const auto sectionOffsetsPos = out.data.size();
+	for(int i = 0; i != 4; ++i) out.u64(0);
+	assert(out.data.size() == headerSize);
+
+	out.setU64(sectionOffsetsPos, out.data.size());
+	out.u32(strings.strings.size());
+	{
+		std::uint64_t offset = 0;
+		out.u64(offset);
+		for(const auto *s: strings.strings) {
+			offset += s->size();
+			out.u64(offset);
+		}
+		for(const auto *s: strings.strings)
+			out.data += *s;
+	}
+
+	out.setU64(sectionOffsetsPos + 8, out.data.size());
+	out.u32(vertexOffsets.size());
+	{
+		const std::uint64_t recordsStart = out.data.size() + vertexOffsets.size() * 8;
+		for(const auto offset: vertexOffsets)
+			out.u64(recordsStart + offset);
+		out.data += vertexRecords.data;
+	}
+
+	out.setU64(sectionOffsetsPos + 16, out.data.size());
+	out.data += ruleSection.data;
+
+	out.setU64(sectionOffsetsPos + 24, out.data.size());
+	out.u32(edgeOffsets.size());
+	{
+		const std::uint64_t recordsStart = out.data.size() + edgeOffsets.size() * 8;
+		for(const auto offset: edgeOffsets)
+			out.u64(recordsStart + offset);
+		out.data += edgeRecords.data;
+	}
+
+	boost::crc_32_type crc;
+	crc.process_bytes(out.data.data(), out.data.size());
+	out.u32(crc.checksum());
+
+	post::FileHandle s(file);
+	s.stream.write(out.data.data(), out.data.size());
+}
+
+// ===========================================================================
+
+namespace {
+
+// Bounds-checked sequential reading from the mapped data.
+struct Cursor {
+	bool u8(std::uint8_t &v) {
+		return read(v);
+	}
+
+	bool u32(std::uint32_t &v) {
+		return read(v);
+	}
+
+	bool u64(std::uint64_t &v) {
+		return read(v);
+	}
+
+	bool skip(std::uint64_t n) {
+		if(n > size - pos) return false;
+		pos += n;
+		return true;
+	}
+private:
+	template<typename T>
+	bool read(T &v) {
+		if(sizeof(T) > size - pos) return false;
+		std::memcpy(&v, data + pos, sizeof(T));
+		pos += sizeof(T);
+		return true;
+	}
+public:
+	const char *data;
+	std::size_t size;
+	std::size_t pos;
+};
+
+} // namespace
+
+std::unique_ptr<Reader> Reader::open(const std::string &file, std::ostream &err) {
+	std::unique_ptr<Reader> res(new Reader());
+	try {
+		res->ifs.open(file);
+	} catch(const BOOST_IOSTREAMS_FAILURE &e) {
+		err << "Could not open file '" << file << "':\n" << e.what();
+		return nullptr;
+	}
+	if(!isBinaryDump(res->ifs.begin(), res->ifs.end())) {
+		err << "Not a binary DG dump.";
+		return nullptr;
+	}
+	if(res->ifs.size() < headerSize + trailerSize) {
+		err << "Integrity check failed. Input too short.";
+		return nullptr;
+	}
+	res->data = res->ifs.data();
+	res->size = res->ifs.size() - trailerSize;
+	{
+		std::uint32_t checksum;
+		std::memcpy(&checksum, res->data + res->size, sizeof(checksum));
+		boost::crc_32_type crc;
+		crc.process_bytes(res->data, res->size);
+		if(checksum != crc.checksum()) {
+			err << "Integrity check failed. Wrong checksum, " << checksum << ". Actual checksum is "
+			    << crc.checksum() << ".";
+			return nullptr;
+		}
+	}
+
+	Cursor c{res->data, res->size, sizeof(magic)};
+	std::uint32_t fileVersion, flags;
+	std::uint8_t ls[4];
+	std::uint64_t sections[4];
+	if(!c.u32(fileVersion) || !c.u32(flags)
+	   || !c.u8(ls[0]) || !c.u8(ls[1]) || !c.u8(ls[2]) || !c.u8(ls[3])
+	   || !c.u64(sections[0]) || !c.u64(sections[1]) || !c.u64(sections[2]) || !c.u64(sections[3]))
+		MOD_ABORT; // the size was checked above
+	if(fileVersion != version) {
+		err << "Unknown binary DG dump version, " << fileVersion << ".";
+		return nullptr;
+	}
+	const auto isRelation = [](std::uint8_t r) {
+		return r <= static_cast<std::uint8_t>(LabelRelation::Unification);
+	};
+	if(ls[0] > static_cast<std::uint8_t>(LabelType::Term) || !isRelation(ls[1]) || ls[2] > 1 || !isRelation(ls[3])) {
+		err << "Corrupt label settings.";
+		return nullptr;
+	}
+	res->labelSettings = LabelSettings(LabelType(ls[0]), LabelRelation(ls[1]), ls[2] == 1, LabelRelation(ls[3]));
+	res->verticesAreUnique = flags & flagVerticesAreUnique;
+
+	// check that all the tables are within the data
+	const auto checkTable = [&res, &err](std::uint64_t offset, std::uint64_t entrySize,
+	                                     std::uint32_t &num, std::uint64_t &table, const char *what) {
+		Cursor c{res->data, res->size, 0};
+		if(!c.skip(offset) || !c.u32(num)) {
+			err << "Corrupt " << what << " section.";
+			return false;
+		}
+		table = c.pos;
+		if(!c.skip(std::uint64_t(num) * entrySize)) {
+			err << "Corrupt " << what << " table.";
+			return false;
+		}
+		return true;
+	};
+	if(!checkTable(sections[0], 8, res->numStrings, res->stringTable, "string")) return nullptr;
+	if(res->numStrings == std::numeric_limits<std::uint32_t>::max()) {
+		err << "Corrupt string table.";
+		return nullptr;
+	}
+	res->stringData = res->stringTable + (std::uint64_t(res->numStrings) + 1) * 8;
+	{
+		// the table has an extra entry with the end of the string data
+		if(res->stringData > res->size) {
+			err << "Corrupt string table.";
+			return nullptr;
+		}
+		std::uint64_t end;
+		std::memcpy(&end, res->data + res->stringData - 8, sizeof(end));
+		if(end > res->size - res->stringData) {
+			err << "Corrupt string data.";
+			return nullptr;
+		}
+	}
+	if(!checkTable(sections[1], 8, res->numVertices, res->vertexTable, "vertex")) return nullptr;
+	if(sections[2] > res->size) {
+		err << "Corrupt rule section.";
+		return nullptr;
+	}
+	res->ruleSection = sections[2];
+	if(!checkTable(sections[3], 8, res->numEdges, res->edgeTable, "edge")) return nullptr;
+	if(res->numVertices > std::numeric_limits<int>::max() || res->numEdges > std::numeric_limits<int>::max()) {
+		err << "Corrupt data, too many vertices or edges.";
+		return nullptr;
+	}
+	return res;
+}
+
+Reader::~Reader() = default;
+
+LabelSettings Reader::getLabelSettings() const {
+	return labelSettings;
+}
+
+bool Reader::getVerticesAreUnique() const {
+	return verticesAreUnique;
+}
+
+int Reader::getNumVertices() const {
+	return numVertices;
+}
+
+std::optional<int> Reader::getVertexId(int i, std::ostream &err) const {
+	const auto offset = getVertexOffset(i, err);
+	if(!offset) return {};
+	Cursor c{data, size, *offset};
+	std::uint32_t id;
+	if(!c.u32(id)) {
+		err << "Corrupt data for vertex number " << i << ".";
+		return {};
+	}
+	return id;
+}
+
+std::optional<std::string> Reader::getVertexName(int i, std::ostream &err) const {
+	const auto offset = getVertexOffset(i, err);
+	if(!offset) return {};
+	Cursor c{data, size, *offset};
+	std::uint32_t id, name;
+	if(!c.u32(id) || !c.u32(name)) {
+		err << "Corrupt data for vertex number " << i << ".";
+		return {};
+	}
+	return getString(name, err);
+}
+
+std::unique_ptr<lib::graph::Graph> Reader::loadGraph(int i, std::ostream &err) const {
+	auto gPtr = std::make_unique<lib::graph::GraphType>();
+	auto pStringPtr = std::make_unique<lib::graph::PropString>(*gPtr);
+	auto name = decodeGraph(i, err, *gPtr, pStringPtr.get());
+	if(!name) return nullptr;
+	auto gRes = std::make_unique<lib::graph::Graph>(std::move(gPtr), std::move(pStringPtr), nullptr);
+	gRes->setName(std::move(*name));
+	return gRes;
+}
+
+bool Reader::checkGraph(int i, std::ostream &err) const {
+	lib::graph::GraphType g;
+	return decodeGraph(i, err, g, nullptr).has_value();
+}
+
+std::optional<std::vector<std::string>> Reader::getRules(std::ostream &err) const {
+	Cursor c{data, size, ruleSection};
+	std::uint32_t num;
+	if(!c.u32(num)) {
+		err << "Corrupt rule section.";
+		return {};
+	}
+	std::vector<std::string> res;
+	for(std::uint32_t i = 0; i != num; ++i) {
+		std::uint32_t length;
+		const auto first = c.pos + 4;
+		if(!c.u32(length) || !c.skip(length)) {
+			err << "Corrupt data for rule number " << i << ".";
+			return {};
+		}
+		res.emplace_back(data + first, length);
+	}
+	return res;
+}
+
+int Reader::getNumEdges() const {
+	return numEdges;
+}
+
+std::optional<Edge> Reader::getEdge(int i, std::ostream &err) const {
+	assert(i >= 0);
+	assert(i < getNumEdges());
+	std::uint64_t offset;
+	std::memcpy(&offset, data + edgeTable + std::uint64_t(i) * 8, sizeof(offset));
+	Cursor c{data, size, 0};
+	std::uint32_t id, numSources, numTargets, numRules;
+	if(!c.skip(offset) || !c.u32(id) || !c.u32(numSources) || !c.u32(numTargets) || !c.u32(numRules)
+	   || std::uint64_t(numSources) + numTargets + numRules > (size - c.pos) / 4) {
+		err << "Corrupt data for edge number " << i << ".";
+		return {};
+	}
+	const auto readList = [&c](std::uint32_t num, std::vector<int> &list) {
+		list.resize(num);
+		for(auto &v: list) {
+			std::uint32_t vv;
+			if(!c.u32(vv)) MOD_ABORT; // the size was checked above
+			v = static_cast<int>(std::min<std::uint32_t>(vv, std::numeric_limits<int>::max()));
+		}
+	};
+	Edge e;
+	e.id = static_cast<int>(std::min<std::uint32_t>(id, std::numeric_limits<int>::max()));
+	readList(numSources, e.sources);
+	readList(numTargets, e.targets);
+	readList(numRules, e.rules);
+	return e;
+}
+
+std::optional<nlohmann::json> Reader::toJson(std::ostream &err) const {
+	nlohmann::json j;
+	j["version"] = version;
+	j["labelSettings"] = labelSettings;
+	j["verticesAreUnique"] = verticesAreUnique;
+	auto jVertices = nlohmann::json::array();
+	for(int i = 0; i != getNumVertices(); ++i) {
+		const auto id = getVertexId(i, err);
+		if(!id) return {};
+		auto g = loadGraph(i, err);
+		if(!g) return {};
+		const auto &graph = g->getGraph();
+		const auto &pString = g->getStringState();
+		auto jLabels = nlohmann::json::array();
+		for(const auto v: asRange(vertices(graph)))
+			jLabels.push_back(pString[v]);
+		auto jEdges = nlohmann::json::array();
+		for(const auto e: asRange(edges(graph))) {
+			jEdges.push_back({get(boost::vertex_index_t(), graph, source(e, graph)),
+			                  get(boost::vertex_index_t(), graph, target(e, graph)),
+			                  pString[e]});
+		}
+		jVertices.push_back({*id, g->getName(), std::move(jLabels), std::move(jEdges)});
+	}
+	j["vertices"] = std::move(jVertices);
+	auto rules = getRules(err);
+	if(!rules) return {};
+	j["rules"] = std::move(*rules);
+	auto jEdges = nlohmann::json::array();
+	for(int i = 0; i != getNumEdges(); ++i) {
+		auto e = getEdge(i, err);
+		if(!e) return {};
+		jEdges.push_back({e->id, e->sources, e->targets, e->rules});
+	}
+	j["edges"] = std::move(jEdges);
+	return j;
+}
+
+std::optional<std::uint64_t> Reader::getVertexOffset(int i, std::ostream &err) const {
+	assert(i >= 0);
+	assert(i < getNumVertices());
+	std::uint64_t offset;
+	std::memcpy(&offset, data + vertexTable + std::uint64_t(i) * 8, sizeof(offset));
+	if(offset >= size) {
+		err << "Corrupt data for vertex number " << i << ".";
+		return {};
+	}
+	return offset;
+}
+
+std::optional<std::string> Reader::getString(std::uint32_t id, std::ostream &err) const {
+	if(id >= numStrings) {
+		err << "Corrupt data, string " << id << " out of range.";
+		return {};
+	}
+	std::uint64_t first, last;
+	std::memcpy(&first, data + stringTable + std::uint64_t(id) * 8, sizeof(first));
+	std::memcpy(&last, data + stringTable + std::uint64_t(id + 1) * 8, sizeof(last));
+	// the end of the last string was checked when opening
+	std::uint64_t end;
+	std::memcpy(&end, data + stringData - 8, sizeof(end));
+	if(first > last || last > end) {
+		err << "Corrupt data, string " << id << " is malformed.";
+		return {};
+	}
+	return std::string(data + stringData + first, last - first);
+}
+
+std::optional<std::string> Reader::decodeGraph(int i, std::ostream &err,
+                                               lib::graph::GraphType &g, lib::graph::PropString *pString) const {
+	const auto offset = getVertexOffset(i, err);
+	if(!offset) return {};
+	Cursor c{data, size, *offset};
+	std::uint32_t id, nameId, n, m;
+	if(!c.u32(id) || !c.u32(nameId) || !c.u32(n) || !c.u32(m)) {
+		err << "Corrupt data for vertex number " << i << ".";
+		return {};
+	}
+	const auto corrupt = [&err, id](const char *what) -> std::optional<std::string> {
+		err << "Corrupt graph data for vertex " << id << ", " << what << ".";
+		return {};
+	};
+	if(n == 0) return corrupt("no vertices");
+	auto name = getString(nameId, err);
+	if(!name) return {};
+	for(std::uint32_t j = 0; j != n; ++j) {
+		std::uint32_t labelId;
+		if(!c.u32(labelId)) return corrupt("truncated vertex labels");
+		auto label = getString(labelId, err);
+		if(!label) return {};
+		const auto v = add_vertex(g);
+		if(pString) pString->addVertex(v, *label);
+	}
+	// union-find, to check that the graph is connected
+	std::vector<std::uint32_t> comp(n);
+	for(std::uint32_t j = 0; j != n; ++j) comp[j] = j;
+	const auto find = [&comp](std::uint32_t a) {
+		while(comp[a] != a) a = comp[a] = comp[comp[a]];
+		return a;
+	};
+	std::uint32_t numComponents = n;
+	for(std::uint32_t j = 0; j != m; ++j) {
+		std::uint32_t src, tar, labelId;
+		if(!c.u32(src) || !c.u32(tar) || !c.u32(labelId)) return corrupt("truncated edges");
+		if(src >= n || tar >= n) return corrupt("edge endpoint out of range");
+		if(src == tar) return corrupt("loop edge");
+		const auto vSrc = vertex(src, g);
+		const auto vTar = vertex(tar, g);
+		if(edge(vSrc, vTar, g).second) return corrupt("parallel edges");
+		auto label = getString(labelId, err);
+		if(!label) return {};
+		const auto e = add_edge(vSrc, vTar, g).first;
+		if(pString) pString->addEdge(e, *label);
+		const auto cSrc = find(src), cTar = find(tar);
+		if(cSrc != cTar) {
+			comp[cSrc] = cTar;
+			--numComponents;
+		}
+	}
+	if(numComponents != 1) return corrupt("the graph is not connected");
+	return name;
+}
+
+} // namespace mod::lib::DG::BinaryDump
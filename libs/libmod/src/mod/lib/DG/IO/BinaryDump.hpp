@@ -0,0 +1,101 @@
+#ifndef MOD_LIB_DG_IO_BINARYDUMP_HPP
+#define MOD_LIB_DG_IO_BINARYDUMP_HPP
+
+#include <mod/Config.hpp>
+#include <mod/lib/Graph/GraphDecl.hpp>
+#include <mod/lib/IO/Json.hpp>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mod::lib::graph {
+struct Graph;
+struct PropString;
+} // namespace mod::lib::graph
+namespace mod::lib::DG {
+struct NonHyper;
+} // namespace mod::lib::DG
+namespace mod::lib::DG::BinaryDump {
+
+// The binary DG dump format, all integers are in native byte order:
+//
+// header:
+//   char[8] magic, "MODDGBIN"
+//   u32     version
+//   u32     flags, bit 0: the graphs are pairwise non-isomorphic
+//   u8[4]   label settings: type, relation, withStereo, stereoRelation
+//   u64[4]  offsets of the string, vertex, rule, and edge sections
+// strings:  u32 num, u64[num + 1] offsets relative to the end of the table, char[] data
+// vertices: u32 num, u64[num] offsets, and for each vertex:
+//           u32 id, u32 name, u32 numVertices, u32 numEdges,
+//           u32[numVertices] vertex labels, (u32 src, u32 tar, u32 label)[numEdges]
+// rules:    u32 num, and for each rule: u32 length, char[length] GML
+// edges:    u32 num, u64[num] offsets, and for each edge:
+//           u32 id, u32 numSources, u32 numTargets, u32 numRules,
+//           u32[numSources], u32[numTargets], u32[numRules] (indices of the rules in the rule section)
+// trailer:  u32 CRC-32 of everything before it
+//
+// Names and labels refer to the string section, where each string is stored once.
+// The offset tables make it possible to read single vertices and edges directly from a mapped file.
+
+constexpr std::uint32_t version = 1;
+
+bool isBinaryDump(const char *first, const char *last);
+void write(const NonHyper &dg, const std::string &file);
+
+struct Edge {
+	int id;
+	std::vector<int> sources, targets, rules;
+};
+
+struct Reader {
+	// Maps the file into memory and checks the header, the section tables, and the checksum.
+	// Returns nullptr and writes to err if the file can not be opened or if the data is corrupt.
+	static std::unique_ptr<Reader> open(const std::string &file, std::ostream &err);
+	~Reader();
+	LabelSettings getLabelSettings() const;
+	// Whether the writer guarantees that the graphs of the vertices are pairwise non-isomorphic.
+	bool getVerticesAreUnique() const;
+	int getNumVertices() const;
+	// pre: 0 <= i < getNumVertices()
+	std::optional<int> getVertexId(int i, std::ostream &err) const;
+	std::optional<std::string> getVertexName(int i, std::ostream &err) const;
+	// Constructs the graph of the i'th vertex from the mapped data.
+	// Returns nullptr and writes to err if the data is corrupt.
+	std::unique_ptr<lib::graph::Graph> loadGraph(int i, std::ostream &err) const;
+	// Does the same checks of the data as loadGraph, but only decodes the structure of the graph.
+	// The graph is not constructed, so no graph ID is used.
+	bool checkGraph(int i, std::ostream &err) const;
+	std::optional<std::vector<std::string>> getRules(std::ostream &err) const;
+	int getNumEdges() const;
+	// pre: 0 <= i < getNumEdges()
+	std::optional<Edge> getEdge(int i, std::ostream &err) const;
+	// A textual representation, mostly for debugging.
+	std::optional<nlohmann::json> toJson(std::ostream &err) const;
+private:
+	Reader() = default;
+	std::optional<std::uint64_t> getVertexOffset(int i, std::ostream &err) const;
+	std::optional<std::string> getString(std::uint32_t id, std::ostream &err) const;
+	// Decodes the i'th vertex into g, and the labels into pString unless it is null.
+	// Returns the name of the graph, or nothing and writes to err if the data is corrupt.
+	std::optional<std::string> decodeGraph(int i, std::ostream &err,
+	                                       lib::graph::GraphType &g, lib::graph::PropString *pString) const;
+private:
+	boost::iostreams::mapped_file_source ifs;
+	const char *data;
+	std::size_t size; // excluding the trailer
+	LabelSettings labelSettings = {LabelType::String, LabelRelation::Isomorphism};
+	bool verticesAreUnique;
+	std::uint32_t numStrings, numVertices, numEdges;
+	std::uint64_t stringTable, stringData, vertexTable, ruleSection, edgeTable;
+};
+
+} // namespace mod::lib::DG::BinaryDump
+
+#endif // MOD_LIB_DG_IO_BINARYDUMP_HPP
@@ -16,6 +16,7 @@
 #include <mod/graph/Graph.hpp>
 #include <mod/rule/Rule.hpp>
 #include <mod/lib/DG/Dump.hpp>
+#include <mod/lib/DG/IO/BinaryDump.hpp>
 #include <mod/lib/DG/NonHyperBuilder.hpp>
 #include <mod/lib/Graph/Graph.hpp>
 #include <mod/lib/Graph/Properties/Stereo.hpp>
@@ -140,6 +141,18 @@ std::unique_ptr<NonHyper> dump(const std::vector<std::shared_ptr<mod::graph::Gra
 		ifs.close();
 		return Dump::load(graphDatabase, ruleDatabase, file, err);
 	}
+	if(BinaryDump::isBinaryDump(ifs.begin(), ifs.end())) {
+		ifs.close();
+		const auto dump = BinaryDump::Reader::open(file, err);
+		if(!dump) return {};
+		auto dgInternal = std::make_unique<NonHyperBuilder>(dump->getLabelSettings(), graphDatabase, graphPolicy);
+		{ // construction
+			auto b = dgInternal->build(nullptr, nullptr);
+			auto res = b.trustLoadDump(*dump, ruleDatabase, err, verbosity);
+			if(!res) return {};
+		}
+		return std::unique_ptr<NonHyper>(dgInternal.release());
+	}
 	ifs.close();
 	auto jOpt = loadDump(file, err);
 	if(!jOpt) return {};
@@ -26,12 +26,13 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/make_shared.hpp>
 
+#include <atomic>
 #include <iostream>
 #include <unordered_set>
 
 namespace mod::lib::DG {
 namespace {
-std::size_t nextDGNum = 0;
+std::atomic<std::size_t> nextDGNum(0);
 } // namespace
 
 NonHyper::NonHyper(LabelSettings labelSettings,
@@ -4,9 +4,11 @@
 #include <mod/Function.hpp>
 #include <mod/Misc.hpp>
 #include <mod/rule/Rule.hpp>
+#include <mod/lib/DG/DirectRuleApplication.hpp>
 #include <mod/lib/DG/RuleApplicationUtils.hpp>
 #include <mod/lib/DG/Strategies/GraphState.hpp>
 #include <mod/lib/DG/Strategies/Strategy.hpp>
+#include <mod/lib/DG/IO/BinaryDump.hpp>
 #include <mod/lib/DG/IO/Read.hpp>
 #include <mod/lib/Graph/IO/Read.hpp>
 #include <mod/lib/Graph/Properties/Term.hpp>
@@ -20,6 +22,16 @@
 #include <boost/lexical_cast.hpp>
 
 namespace mod::lib::DG {
+namespace {
+
+void precomputeCanonForms(const std::vector<std::shared_ptr<mod::graph::Graph>> &graphs, LabelSettings ls) {
+	std::vector<const lib::graph::Graph *> gPtrs;
+	gPtrs.reserve(graphs.size());
+	for(const auto &g: graphs) gPtrs.push_back(&g->getGraph());
+	lib::graph::Graph::precomputeCanonForms(gPtrs, ls);
+}
+
+} // namespace
 
 ExecuteResult::ExecuteResult(NonHyperBuilder *owner, int execution)
 		: owner(owner), execution(execution) {}
@@ -34,6 +46,10 @@ void ExecuteResult::list(bool withUniverse) const {
 	std::cout << std::flush;
 }
 
+const ExecutionStats *ExecuteResult::getStats() const {
+	return owner->executions[execution].stats.get();
+}
+
 // -----------------------------------------------------------------------------
 
 AddAbstractResult::AddAbstractResult(
@@ -125,8 +141,10 @@ std::pair<NonHyper::Edge, bool> Builder::addDerivation(const Derivations &d, Iso
 
 struct NonHyperBuilder::ExecutionEnv final : public Strategies::ExecutionEnv {
 	ExecutionEnv(NonHyperBuilder &owner, LabelSettings labelSettings, bool doRuleIsomorphism,
-	             rule::GraphAsRuleCache &graphAsRuleCache)
-			: Strategies::ExecutionEnv(labelSettings, doRuleIsomorphism, graphAsRuleCache), owner(owner) {}
+	             rule::GraphAsRuleCache &graphAsRuleCache, ComponentMatchCache &componentMatchCache,
+	             ExecutionStats *stats)
+			: Strategies::ExecutionEnv(labelSettings, doRuleIsomorphism, graphAsRuleCache, componentMatchCache, stats),
+			  owner(owner) {}
 
 	void tryAddGraph(std::shared_ptr<mod::graph::Graph> gCand) override {
 		owner.tryAddGraph(gCand);
@@ -144,6 +162,10 @@ struct NonHyperBuilder::ExecutionEnv final : public Strategies::ExecutionEnv {
 		return doExit_;
 	}
 
+	void requestExit() override {
+		doExit_ = true;
+	}
+
 	bool checkLeftPredicate(const mod::Derivation &d) const override {
 		for(const auto &pred: asRange(leftPredicates.rbegin(), leftPredicates.rend())) {
 			bool result = (*pred)(d);
@@ -207,11 +229,14 @@ private: // state for computation
 ExecuteResult
 Builder::execute(std::unique_ptr<Strategies::Strategy> strategy_, int verbosity, bool ignoreRuleLabelTypes) {
 	const bool doRuleIsomorphism = getConfig().dg.doRuleIsomorphismDuringBinding;
+	auto stats = getConfig().dg.collectStats ? std::make_unique<ExecutionStats>() : nullptr;
 	NonHyperBuilder::StrategyExecution exec{
 			std::make_unique<NonHyperBuilder::ExecutionEnv>(*dg, dg->getLabelSettings(), doRuleIsomorphism,
-			                                                dg->graphAsRuleCache),
+			                                                dg->graphAsRuleCache, dg->componentMatchCache,
+			                                                stats.get()),
 			std::make_unique<Strategies::GraphState>(),
-			std::move(strategy_)
+			std::move(strategy_),
+			std::move(stats)
 	};
 	exec.strategy->setExecutionEnv(*exec.env);
 
@@ -248,7 +273,19 @@ Builder::execute(std::unique_ptr<Strategies::Strategy> strategy_, int verbosity,
 		});
 	}
 
-	exec.strategy->execute(Strategies::PrintSettings(std::cout, false, verbosity), *exec.input);
+	{
+		std::optional<GraphMorphism::VF2CounterScope> vf2Scope;
+		if(exec.stats) vf2Scope.emplace(&exec.stats->vf2);
+		StatsTimer timer(exec.stats ? &exec.stats->timeTotal : nullptr);
+		const ComponentMatchCacheStats cacheBefore = dg->componentMatchCache.getStats();
+		exec.strategy->execute(Strategies::PrintSettings(std::cout, false, verbosity), *exec.input);
+		if(exec.stats) {
+			const ComponentMatchCacheStats &cacheAfter = dg->componentMatchCache.getStats();
+			exec.stats->componentMatchCache.numHits = cacheAfter.numHits - cacheBefore.numHits;
+			exec.stats->componentMatchCache.numMisses = cacheAfter.numMisses - cacheBefore.numMisses;
+			exec.stats->componentMatchCache.numEvictions = cacheAfter.numEvictions - cacheBefore.numEvictions;
+		}
+	}
 	dg->executions.push_back(std::move(exec));
 	return ExecuteResult(dg, dg->executions.size() - 1);
 }
@@ -262,6 +299,7 @@ Builder::apply(const std::vector<std::shared_ptr<mod::graph::Graph>> &graphs,
 	dg->rules.insert(rOrig);
 	switch(graphPolicy) {
 	case IsomorphismPolicy::Check:
+		precomputeCanonForms(graphs, dg->getLabelSettings());
 		for(const auto &g: graphs)
 			dg->tryAddGraph(g);
 		break;
@@ -283,8 +321,74 @@ Builder::apply(const std::vector<std::shared_ptr<mod::graph::Graph>> &graphs,
 	for(const auto &g: graphs)
 		libGraphs.push_back(&g->getGraph());
 
-	std::vector<BoundRule> resultRules;
 	const auto ls = dg->getLabelSettings();
+	std::vector<std::pair<NonHyper::Edge, bool>> res;
+	// makeProducts(checkIfNew, onDup) must return the wrapped products
+	const auto addDerivation = [this, verbosity, &logger, &res, &rOrig](
+			const std::vector<const lib::graph::Graph *> &educts, auto makeProducts) {
+		auto products = makeProducts(
+				[this](std::unique_ptr<lib::graph::Graph> gCand) {
+					return dg->checkIfNew(std::move(gCand)).first;
+				},
+				[verbosity, &logger](std::shared_ptr<mod::graph::Graph> gWrapped,
+				                     std::shared_ptr<mod::graph::Graph> gPrev) {
+					if(verbosity >= V_RuleApplication_Binding)
+						logger.indent(1) << "Discarding product " << gWrapped->getName()
+						                 << ", isomorphic to other product " << gPrev->getName()
+						                 << "." << std::endl;
+				}
+		);
+		if(products.empty()) {
+			if(verbosity >= V_RuleApplication)
+				logger.indent(1) << "Discarding derivation, empty result." << std::endl;
+			return;
+		}
+		for(const auto &p: products)
+			dg->addCreatedGraph(p);
+		std::vector<const lib::graph::Graph *> rightGraphs;
+		rightGraphs.reserve(products.size());
+		for(const auto &p: products)
+			rightGraphs.push_back(&p->getGraph());
+		lib::DG::GraphMultiset gmsLeft(educts), gmsRight(std::move(rightGraphs));
+		const auto derivationRes = dg->suggestDerivation(gmsLeft, gmsRight, &rOrig->getRule());
+		res.push_back(derivationRes);
+	};
+
+	if(canApplyDirectly(rOrig->getRule(), ls)) {
+		// the same binding scheme as below, but without composition
+		DirectRuleApplier applier(rOrig->getRule(), dg->graphAsRuleCache, dg->componentMatchCache, ls);
+		std::vector<DirectBinding> resultBindings;
+		std::vector<DirectBinding> inputBindings{applier.makeInitial()};
+		for(int round = 0; round != libGraphs.size(); ++round) {
+			const auto onOutput = [
+					isLast = round + 1 == libGraphs.size(),
+					assumeConfluence = getConfig().dg.applyAssumeConfluence,
+					&resultBindings]
+					(IO::Logger logger, const DirectBinding &b) -> bool {
+				if(isLast) {
+					if(!b.isComplete()) return true;
+					resultBindings.push_back(b);
+					return !assumeConfluence;
+				} else {
+					if(b.isComplete()) return true;
+					return !assumeConfluence;
+				}
+			};
+			inputBindings = applier.bindGraphs(verbosity, logger, round, libGraphs, round + 1, inputBindings,
+			                                   doRuleIsomorphism, nullptr, onOutput);
+			for(DirectBinding &b: inputBindings)
+				++b.nextGraphOffset;
+		}
+		for(const DirectBinding &b: resultBindings) {
+			if(getConfig().dg.applyLimit == res.size()) break;
+			addDerivation(b.boundGraphs, [&](auto checkIfNew, auto onDup) {
+				return wrapProducts(applier.makeProducts(b), ls.type, ls.withStereo, checkIfNew, onDup);
+			});
+		}
+		return res;
+	}
+
+	std::vector<BoundRule> resultRules;
 	{
 		// we must bind each graph, so increase the span of graphs one at a time,
 		// and only keep bound rules that still have left-hand components
@@ -315,6 +419,7 @@ Builder::apply(const std::vector<std::shared_ptr<mod::graph::Graph>> &graphs,
 					round,
 					firstGraph, firstGraph + round + 1, inputRules,
 					dg->graphAsRuleCache, ls, doRuleIsomorphism,
+					nullptr,
 					onOutput);
 			for(BoundRule &br: outputRules) {
 				// always go to the next graph
@@ -335,39 +440,14 @@ Builder::apply(const std::vector<std::shared_ptr<mod::graph::Graph>> &graphs,
 			delete br.rule;
 	} // end of binding
 
-	std::vector<std::pair<NonHyper::Edge, bool>> res;
 	for(const BoundRule &br: resultRules) {
 		if(getConfig().dg.applyLimit == res.size()) break;
 
 		const auto &r = *br.rule;
 		assert(r.isOnlyRightSide());
-		auto products = splitRule(
-				r.getDPORule(), ls.type, ls.withStereo,
-				[this](std::unique_ptr<lib::graph::Graph> gCand) {
-					return dg->checkIfNew(std::move(gCand)).first;
-				},
-				[verbosity, &logger](std::shared_ptr<mod::graph::Graph> gWrapped,
-				                     std::shared_ptr<mod::graph::Graph> gPrev) {
-					if(verbosity >= V_RuleApplication_Binding)
-						logger.indent(1) << "Discarding product " << gWrapped->getName()
-						                 << ", isomorphic to other product " << gPrev->getName()
-						                 << "." << std::endl;
-				}
-		);
-		if(products.empty()) {
-			if(verbosity >= V_RuleApplication)
-				logger.indent(1) << "Discarding derivation, empty result." << std::endl;
-			continue;
-		}
-		for(const auto &p: products)
-			dg->addCreatedGraph(p);
-		std::vector<const lib::graph::Graph *> rightGraphs;
-		rightGraphs.reserve(products.size());
-		for(const auto &p: products)
-			rightGraphs.push_back(&p->getGraph());
-		lib::DG::GraphMultiset gmsLeft(br.boundGraphs), gmsRight(std::move(rightGraphs));
-		const auto derivationRes = dg->suggestDerivation(gmsLeft, gmsRight, &rOrig->getRule());
-		res.push_back(derivationRes);
+		addDerivation(br.boundGraphs, [&](auto checkIfNew, auto onDup) {
+			return splitRule(r.getDPORule(), ls.type, ls.withStereo, checkIfNew, onDup);
+		});
 	}
 
 	for(const auto &br: resultRules)
@@ -385,6 +465,7 @@ Builder::applyRelaxed(const std::vector<std::shared_ptr<mod::graph::Graph>> &gra
 	dg->rules.insert(rOrig);
 	switch(graphPolicy) {
 	case IsomorphismPolicy::Check:
+		precomputeCanonForms(graphs, dg->getLabelSettings());
 		for(const auto &g: graphs)
 			dg->tryAddGraph(g);
 		break;
@@ -469,6 +550,7 @@ Builder::applyRelaxed(const std::vector<std::shared_ptr<mod::graph::Graph>> &gra
 				 round,
 				 firstGraph, lastGraph, inputRules,
 				 dg->graphAsRuleCache, ls, doRuleIsomorphism,
+				 nullptr,
 				 onOutput);
 		for(BoundRule &br: outputRules) {
 			// always go to the next graph
@@ -593,19 +675,28 @@ bool Builder::load(const std::vector<std::shared_ptr<mod::rule::Rule>> &ruleData
 		    << " Load it as a locked DG (dg::DG::load()/DG.load()) and dump it again to convert it to a newer format.";
 		return false;
 	}
+	const bool isBinary = BinaryDump::isBinaryDump(ifs.begin(), ifs.end());
 	ifs.close();
-	auto jOpt = lib::DG::Read::loadDump(file, err);
-	if(!jOpt) return {};
-	auto &j = *jOpt;
 
-	LabelSettings labelSettings = from_json(j["labelSettings"]);
-	if(labelSettings != dg->getLabelSettings()) {
+	const auto checkLabelSettings = [this, &err](LabelSettings labelSettings) {
+		if(labelSettings == dg->getLabelSettings()) return true;
 		err << "Mismatch of label settings. This DG has "
 		    << dg->getLabelSettings()
 		    << " but the dump to be loaded has "
 		    << labelSettings << ".";
 		return false;
+	};
+	if(isBinary) {
+		const auto dump = BinaryDump::Reader::open(file, err);
+		if(!dump) return false;
+		if(!checkLabelSettings(dump->getLabelSettings())) return false;
+		return trustLoadDump(*dump, ruleDatabase, err, verbosity);
 	}
+
+	auto jOpt = lib::DG::Read::loadDump(file, err);
+	if(!jOpt) return {};
+	auto &j = *jOpt;
+	if(!checkLabelSettings(from_json(j["labelSettings"]))) return false;
 	auto res = trustLoadDump(std::move(j), ruleDatabase, err, verbosity);
 	return res;
 }
@@ -614,24 +705,22 @@ bool Builder::trustLoadDump(nlohmann::json &&j,
                             const std::vector<std::shared_ptr<mod::rule::Rule>> &ruleDatabase,
                             std::ostream &err,
                             int verbosity) {
-	constexpr int V_Link = 2;
 	constexpr bool printStereoWarnings = true;
 
 	assert(j["version"].get<int>() == 3);
 
-	// first do graph wrapping against the underlying graph database
-	// we assume that the incomming graphs are all pairwise non-isomorphic
-	struct Vertex {
-		int id;
-		std::shared_ptr<mod::graph::Graph> graph;
-		bool wasNew;
+	const auto &jVertices = j["vertices"];
+	const auto &jEdges = j["edges"];
+	std::vector<std::string> rulesGML;
+	rulesGML.reserve(j["rules"].size());
+	for(const auto &jr: j["rules"])
+		rulesGML.push_back(jr.get<std::string>());
+
+	const auto vertexId = [&jVertices](int i) -> std::optional<int> {
+		return jVertices[i][0].get<int>();
 	};
-	auto &jVertices = j["vertices"];
-	std::vector<Vertex> vertices;
-	vertices.reserve(jVertices.size());
-	for(auto &jv: jVertices) {
-		Vertex v;
-		v.id = jv[0].get<int>();
+	const auto decodeGraph = [&jVertices, &err](int i) -> std::unique_ptr<lib::graph::Graph> {
+		const auto &jv = jVertices[i];
 		const std::string &gml = jv[2].get<std::string>();
 		lib::IO::Warnings warnings;
 		auto gDatasRes = lib::graph::Read::gml(warnings, gml, printStereoWarnings);
@@ -639,39 +728,78 @@ bool Builder::trustLoadDump(nlohmann::json &&j,
 		if(!gDatasRes) {
 			err << gDatasRes.extractError() << '\n';
 			err << "Error when loading graph GML in DG dump, for graph '";
-			err << jv[1].get<std::string>() << "', in vertex " << v.id << ".";
-			return false;
+			err << jv[1].get<std::string>() << "', in vertex " << jv[0].get<int>() << ".";
+			return nullptr;
 		}
 		auto gDatas = std::move(*gDatasRes);
 		if(gDatas.size() != 1) {
 			err << "Loaded graph has multiple connected components (" << gDatas.size() << "). ";
 			err << "Error when loading graph GML in DG dump, for graph '";
-			err << jv[1].get<std::string>() << "', in vertex " << v.id << ".";
-			return false;
+			err << jv[1].get<std::string>() << "', in vertex " << jv[0].get<int>() << ".";
+			return nullptr;
 		}
 		auto gCand = std::make_unique<lib::graph::Graph>(
 				std::move(gDatas.front().g), std::move(gDatas.front().pString), std::move(gDatas.front().pStereo));
 		gCand->setName(jv[1].get<std::string>());
-		auto p = dg->checkIfNew(std::move(gCand));
-		v.graph = p.first;
-		v.wasNew = p.second == nullptr;
-		vertices.push_back(std::move(v));
-	}
-	// now the vertices are ready to be added
+		return gCand;
+	};
+	const auto getEdge = [&jEdges](int i) -> std::optional<BinaryDump::Edge> {
+		const auto &e = jEdges[i];
+		return BinaryDump::Edge{e[0].get<int>(), e[1].get<std::vector<int>>(), e[2].get<std::vector<int>>(),
+		                        e[3].get<std::vector<int>>()};
+	};
+	// the whole document is in memory anyway, so the graphs are decoded while checking
+	std::vector<std::unique_ptr<lib::graph::Graph>> graphs(jVertices.size());
+	const auto checkGraph = [&graphs, &decodeGraph](int i) {
+		graphs[i] = decodeGraph(i);
+		return graphs[i] != nullptr;
+	};
+	const auto loadGraph = [&graphs](int i) {
+		return std::move(graphs[i]);
+	};
+	return trustLoadDumpData(jVertices.size(), vertexId, checkGraph, loadGraph, jEdges.size(), getEdge,
+	                         rulesGML, ruleDatabase, false, err, verbosity);
+}
+
+bool Builder::trustLoadDump(const BinaryDump::Reader &dump,
+                            const std::vector<std::shared_ptr<mod::rule::Rule>> &ruleDatabase,
+                            std::ostream &err,
+                            int verbosity) {
+	const auto rulesGML = dump.getRules(err);
+	if(!rulesGML) return false;
+	// the graphs in the dump are unique, so if there is nothing to compare them to, we skip the isomorphism checks
+	const bool trustGraphs = dump.getVerticesAreUnique() && dg->getGraphDatabase().asList().empty();
+	return trustLoadDumpData(
+			dump.getNumVertices(),
+			[&dump, &err](int i) { return dump.getVertexId(i, err); },
+			[&dump, &err](int i) { return dump.checkGraph(i, err); },
+			[&dump, &err](int i) { return dump.loadGraph(i, err); },
+			dump.getNumEdges(),
+			[&dump, &err](int i) { return dump.getEdge(i, err); },
+			*rulesGML, ruleDatabase, trustGraphs, err, verbosity);
+}
+
+template<typename VertexId, typename CheckGraph, typename LoadGraph, typename GetEdge>
+bool Builder::trustLoadDumpData(int numVertices, VertexId vertexId, CheckGraph checkGraph, LoadGraph loadGraph,
+                                int numEdges, GetEdge getEdge,
+                                const std::vector<std::string> &rulesGML,
+                                const std::vector<std::shared_ptr<mod::rule::Rule>> &ruleDatabase,
+                                bool trustGraphs, std::ostream &err, int verbosity) {
+	constexpr int V_Link = 2;
+	// Everything is read and checked before the DG is changed,
+	// so a corrupt dump does not leave a partially loaded DG behind.
 
 	// prepare the rules, we assume those in the dump are unique
-	const auto &jRules = j["rules"];
-	std::vector<std::shared_ptr<mod::rule::Rule>> rules;
-	rules.reserve(jRules.size());
+	std::vector<std::shared_ptr<mod::rule::Rule>> rules, newRules;
+	rules.reserve(rulesGML.size());
 	const auto ls = dg->getLabelSettings();
-	for(const auto &j: jRules) {
-		const std::string &jr = j.get<std::string>();
-		auto rCand = mod::rule::Rule::fromGMLString(jr, false);
+	for(const auto &gml: rulesGML) {
+		auto rCand = mod::rule::Rule::fromGMLString(gml, false);
 		const auto iter = std::find_if(ruleDatabase.begin(), ruleDatabase.end(), [rCand, ls](const auto &r) {
 			return r->isomorphism(rCand, 1, ls) == 1;
 		});
 		if(iter == end(ruleDatabase)) {
-			dg->rules.insert(rCand);
+			newRules.push_back(rCand);
 			rules.push_back(rCand);
 		} else {
 			rules.push_back(*iter);
@@ -682,75 +810,119 @@ bool Builder::trustLoadDump(nlohmann::json &&j,
 		}
 	}
 
-	// do merge of vertices and edges in order of increasing id
-	std::unordered_map<int, const lib::graph::Graph *> graphFromId;
-	const auto &jEdges = j["edges"];
-	const int numVertices = vertices.size();
-	const int numEdges = jEdges.size();
+	std::vector<int> vertexIds;
+	vertexIds.reserve(numVertices);
+	for(int i = 0; i != numVertices; ++i) {
+		const auto id = vertexId(i);
+		if(!id) return false;
+		vertexIds.push_back(*id);
+	}
+	std::vector<BinaryDump::Edge> edges;
+	edges.reserve(numEdges);
+	for(int i = 0; i != numEdges; ++i) {
+		auto e = getEdge(i);
+		if(!e) return false;
+		edges.push_back(std::move(*e));
+	}
+
+	// merge the vertices and edges in order of increasing id, and check the references
+	std::unordered_map<int, int> vertexFromId;
+	std::vector<bool> order; // whether the next element is a vertex or an edge
+	order.reserve(numVertices + numEdges);
 	int iVertices = 0;
 	int iEdges = 0;
 	for(int id = 0; id != numVertices + numEdges; ++id) {
-		if(iVertices < numVertices && vertices[iVertices].id == id) {
-			const auto &v = vertices[iVertices];
-			const bool wasNewAsVertex = dg->trustAddGraphAsVertex(v.graph);
-			graphFromId[v.id] = &v.graph->getGraph();
-			if(verbosity >= V_Link && !v.wasNew) {
-				std::cout << "DG loading: loaded graph '" << jVertices[iVertices][1].get<std::string>()
-				          << "' isomorphic to existing graph '" << v.graph->getName() << "'." << std::endl;
-			}
-			//if(wasNewAsVertex) giveProductStatus(v.graph);
-			(void) wasNewAsVertex;
+		if(iVertices < numVertices && vertexIds[iVertices] == id) {
+			if(!checkGraph(iVertices)) return false;
+			vertexFromId[id] = iVertices;
+			order.push_back(true);
 			++iVertices;
-		} else if(iEdges < numEdges && jEdges[iEdges][0].get<int>() == id) {
-			const auto &e = jEdges[iEdges];
-			std::vector<const lib::graph::Graph *> srcGraphs, tarGraphs;
-			srcGraphs.reserve(e[1].size());
-			tarGraphs.reserve(e[2].size());
-			for(int src: e[1]) {
-				auto gIter = graphFromId.find(src);
-				if(gIter == end(graphFromId)) {
-					err << "Corrupt data for edge " << e[0].get<int>() << ". Source " << src
+		} else if(iEdges < numEdges && edges[iEdges].id == id) {
+			const auto &e = edges[iEdges];
+			for(int src: e.sources) {
+				if(vertexFromId.find(src) == end(vertexFromId)) {
+					err << "Corrupt data for edge " << e.id << ". Source " << src
 					    << " is not a yet a vertex.";
 					return false;
 				}
-				srcGraphs.push_back(gIter->second);
 			}
-			for(int tar: e[2]) {
-				auto gIter = graphFromId.find(tar);
-				if(gIter == end(graphFromId)) {
-					err << "Corrupt data for edge " << e[0].get<int>() << ". Target " << tar
+			for(int tar: e.targets) {
+				if(vertexFromId.find(tar) == end(vertexFromId)) {
+					err << "Corrupt data for edge " << e.id << ". Target " << tar
 					    << " is not a yet a vertex.";
 					return false;
 				}
-				tarGraphs.push_back(gIter->second);
 			}
-			GraphMultiset gmsSrc(std::move(srcGraphs)), gmsTar(std::move(tarGraphs));
-			const auto &ruleIds = e[3];
-			if(ruleIds.empty()) {
-				dg->suggestDerivation(std::move(gmsSrc), std::move(gmsTar), nullptr);
-			} else {
-				for(const int rId: ruleIds) {
-					if(rId < 0 || rId >= rules.size()) {
-						err << "Corrupt data for edge " << e[0].get<int>() << ". Rule offset " << rId
-						    << " is not in range.";
-						return false;
-					}
-					const auto r = rules[rId];
-					dg->suggestDerivation(std::move(gmsSrc), std::move(gmsTar), &r->getRule());
+			for(const int rId: e.rules) {
+				if(rId < 0 || rId >= rules.size()) {
+					err << "Corrupt data for edge " << e.id << ". Rule index " << rId
+					    << " is not in range.";
+					return false;
 				}
 			}
+			order.push_back(false);
 			++iEdges;
 		} else {
 			err << "Corrupt data for derivation graph during addition (";
 			err << "ID: " << id;
 			err << ", vertices: " << iVertices << " of " << numVertices;
-			if(iVertices < numVertices) err << ", next vertex: " << vertices[iVertices].id;
+			if(iVertices < numVertices) err << ", next vertex: " << vertexIds[iVertices];
 			err << ", edges: " << iEdges << " of " << numEdges;
-			if(iEdges < numEdges) err << ", next edge: " << jEdges[iEdges][0].get<int>();
+			if(iEdges < numEdges) err << ", next edge: " << edges[iEdges].id;
 			err << ").";
 			return false;
 		}
 	}
+
+	// and now add it all
+	// the vertices are added one by one, and each graph is only constructed right before it is added,
+	// so the decoded graphs are not held in addition to the DG,
+	// in particular the graphs are first wrapped against the
+	// underlying graph database when they are added, which is fine as those in the dump are pairwise non-isomorphic
+	for(const auto &r: newRules)
+		dg->rules.insert(r);
+	std::vector<const lib::graph::Graph *> graphFromVertex;
+	graphFromVertex.reserve(numVertices);
+	iEdges = 0;
+	for(const bool isVertex: order) {
+		if(isVertex) {
+			auto gCand = loadGraph(graphFromVertex.size());
+			// the data was checked above
+			if(!gCand) MOD_ABORT;
+			std::shared_ptr<mod::graph::Graph> g;
+			if(trustGraphs) {
+				g = mod::graph::Graph::create(std::move(gCand));
+			} else {
+				auto p = dg->checkIfNew(std::move(gCand));
+				g = p.first;
+				if(verbosity >= V_Link && p.second) {
+					std::cout << "DG loading: loaded graph '" << p.second->getName()
+					          << "' isomorphic to existing graph '" << g->getName() << "'." << std::endl;
+				}
+			}
+			const bool wasNewAsVertex = dg->trustAddGraphAsVertex(g);
+			graphFromVertex.push_back(&g->getGraph());
+			//if(wasNewAsVertex) giveProductStatus(g);
+			(void) wasNewAsVertex;
+		} else {
+			const auto &e = edges[iEdges];
+			std::vector<const lib::graph::Graph *> srcGraphs, tarGraphs;
+			srcGraphs.reserve(e.sources.size());
+			tarGraphs.reserve(e.targets.size());
+			for(int src: e.sources)
+				srcGraphs.push_back(graphFromVertex[vertexFromId[src]]);
+			for(int tar: e.targets)
+				tarGraphs.push_back(graphFromVertex[vertexFromId[tar]]);
+			GraphMultiset gmsSrc(std::move(srcGraphs)), gmsTar(std::move(tarGraphs));
+			if(e.rules.empty()) {
+				dg->suggestDerivation(std::move(gmsSrc), std::move(gmsTar), nullptr);
+			} else {
+				for(const int rId: e.rules)
+					dg->suggestDerivation(gmsSrc, gmsTar, &rules[rId]->getRule());
+			}
+			++iEdges;
+		}
+	}
 	return true;
 }
 
@@ -775,4 +947,8 @@ Builder NonHyperBuilder::build(std::shared_ptr<Function<void(dg::DG::Vertex)>> o
 	return Builder(this, onNewVertex, onNewHyperEdge);
 }
 
+const ComponentMatchCache &NonHyperBuilder::getComponentMatchCache() const {
+	return componentMatchCache;
+}
+
 } // namespace mod::lib::DG
\ No newline at end of file
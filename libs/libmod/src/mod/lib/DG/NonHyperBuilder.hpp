@@ -2,12 +2,18 @@
 #define MOD_LIB_DG_NONHYPERBUILDER_HPP
 
 #include <mod/Derivation.hpp>
+#include <mod/lib/DG/ComponentMatchCache.hpp>
+#include <mod/lib/DG/ExecutionStats.hpp>
 #include <mod/lib/DG/Hyper.hpp>
 #include <mod/lib/DG/NonHyper.hpp>
 #include <mod/lib/IO/Json.hpp>
 #include <mod/lib/Rule/GraphAsRuleCache.hpp>
 
 namespace mod::lib::DG {
+namespace BinaryDump {
+struct Edge;
+struct Reader;
+} // namespace BinaryDump
 namespace Strategies {
 struct GraphState;
 } // namespace Strategies
@@ -16,6 +22,8 @@ struct ExecuteResult {
 	ExecuteResult(NonHyperBuilder *owner, int execution);
 	const Strategies::GraphState &getResult() const;
 	void list(bool withUniverse) const;
+	// nullptr if getConfig().dg.collectStats was false during the execution
+	const ExecutionStats *getStats() const;
 private:
 	NonHyperBuilder *owner;
 	int execution;
@@ -60,6 +68,21 @@ public:
 	bool trustLoadDump(nlohmann::json &&j,
 	                   const std::vector<std::shared_ptr<mod::rule::Rule>> &ruleDatabase,
 	                   std::ostream &err, int verbosity);
+	bool trustLoadDump(const BinaryDump::Reader &dump,
+	                   const std::vector<std::shared_ptr<mod::rule::Rule>> &ruleDatabase,
+	                   std::ostream &err, int verbosity);
+private:
+	// the format-independent part of trustLoadDump
+	// all data is first checked, with checkGraph(i) for the graph of each vertex,
+	// and then the graph of each vertex is loaded with loadGraph(i) when it is added,
+	// so loadGraph must not fail for a graph that passed checkGraph
+	// if trustGraphs, then the graphs are added without isomorphism checks
+	template<typename VertexId, typename CheckGraph, typename LoadGraph, typename GetEdge>
+	bool trustLoadDumpData(int numVertices, VertexId vertexId, CheckGraph checkGraph, LoadGraph loadGraph,
+	                       int numEdges, GetEdge getEdge,
+	                       const std::vector<std::string> &rulesGML,
+	                       const std::vector<std::shared_ptr<mod::rule::Rule>> &ruleDatabase,
+	                       bool trustGraphs, std::ostream &err, int verbosity);
 private:
 	NonHyperBuilder *dg;
 };
@@ -72,6 +95,7 @@ struct NonHyperBuilder : public NonHyper {
 	virtual std::string getType() const override;
 	Builder build(std::shared_ptr<Function<void(dg::DG::Vertex)>> onNewVertex,
 	              std::shared_ptr<Function<void(dg::DG::HyperEdge)>> onNewHyperEdge);
+	const ComponentMatchCache &getComponentMatchCache() const;
 private:
 	friend class ExecuteResult;
 	friend class Builder;
@@ -81,9 +105,11 @@ private:
 		std::unique_ptr<ExecutionEnv> env;
 		std::unique_ptr<Strategies::GraphState> input;
 		std::unique_ptr<Strategies::Strategy> strategy;
+		std::unique_ptr<ExecutionStats> stats;
 	};
 	std::vector<StrategyExecution> executions;
 	rule::GraphAsRuleCache graphAsRuleCache; // referenced by the ExecutionEnvs
+	ComponentMatchCache componentMatchCache; // referenced by the ExecutionEnvs
 };
 
 } // namespace mod::lib::DG
@@ -2,6 +2,8 @@
 #define MOD_LIB_DG_RULEAPPLICATIONUTILS_HPP
 
 #include <mod/graph/Graph.hpp>
+#include <mod/lib/Algorithm/ParallelFor.hpp>
+#include <mod/lib/DG/ExecutionStats.hpp>
 #include <mod/lib/Graph/Graph.hpp>
 #include <mod/lib/Graph/Properties/Stereo.hpp>
 #include <mod/lib/Graph/Properties/String.hpp>
@@ -11,6 +13,11 @@
 #include <mod/lib/Rule/Rule.hpp>
 #include <mod/lib/Stereo/CloneUtil.hpp>
 
+#include <boost/functional/hash.hpp>
+
+#include <sstream>
+#include <unordered_map>
+
 namespace mod::lib::DG {
 
 struct BoundRule {
@@ -45,6 +52,26 @@ public:
 	}
 };
 
+// Buckets of BoundRules for duplicate detection.
+// The key combines the (sorted) bound graphs, nextGraphOffset, and an isomorphism invariant of the rule,
+// so the full rule isomorphism check is only needed between rules in the same bucket.
+// The buckets store indices into a vector of BoundRules owned by the user.
+struct BoundRuleIndex {
+	explicit BoundRuleIndex(LabelType labelType) : labelType(labelType) {}
+
+	// pre: br.makeCanonical() must have been called.
+	std::vector<std::size_t> &getBucket(const BoundRule &br) {
+		std::size_t key = br.rule->getIsomorphismInvariant(labelType);
+		boost::hash_combine(key, br.nextGraphOffset);
+		for(const auto *g: br.boundGraphs)
+			boost::hash_combine(key, g->getId());
+		return buckets[key];
+	}
+private:
+	const LabelType labelType;
+	std::unordered_map<std::size_t, std::vector<std::size_t>> buckets;
+};
+
 constexpr int V_RuleApplication = 2;
 constexpr int V_RuleApplication_Binding = 4;
 
@@ -52,6 +79,30 @@ inline int toRCVerbosity(int verbosity) {
 	return std::max(0, verbosity - V_RuleApplication_Binding);
 }
 
+// Whether the composition of graphs into rules can be done by multiple threads.
+// The compositions only read the (pre-computed) data of the input rules,
+// except for term labels, which may intern new strings, and stereo data, which is
+// inferred lazily, so those are done serially.
+inline bool canBindInParallel(const LabelSettings labelSettings) {
+	return getConfig().common.numThreads > 1
+	       && labelSettings.type == LabelType::String
+	       && !labelSettings.withStereo
+	       && !getConfig().rc.printMatches;
+}
+
+// Compute the lazily initialised data of a rule used during composition,
+// such that threads afterwards only read from the rule.
+inline void prepareForParallelBinding(const lib::rule::Rule &r) {
+	const auto &rDPO = r.getDPORule();
+	get_string(rDPO);
+	const auto &lgLeft = get_labelled_left(rDPO);
+	for(std::size_t i = 0; i != get_num_connected_components(lgLeft); ++i)
+		get_vertex_order_component(i, lgLeft);
+	for(const auto &lg: {lgLeft, get_labelled_right(rDPO)})
+		for(std::size_t i = 0; i != get_num_connected_components(lg); ++i)
+			get_component_fingerprint(i, lg);
+}
+
 // BoundRules are given to onOutput. It must return a boolean indicating
 // whether to continue the search.
 // If a rule in a BoundRule given to onOutput is only-right-side,
@@ -59,6 +110,10 @@ inline int toRCVerbosity(int verbosity) {
 // Otherwise, if there are still left-hand elements, then
 // bindGraphs retains responsibility, and will return a list of all these.
 // This is to do isomorphism checks.
+// If canBindInParallel(labelSettings), then the compositions are distributed over
+// getConfig().common.numThreads threads, but the results are given to onOutput
+// in the same order as in the serial execution.
+// If stats is not nullptr, then the compositions and bound rules are counted in it.
 template<typename Iter, typename OnOutput>
 [[nodiscard]] std::vector<BoundRule> bindGraphs(
 		const int verbosity, IO::Logger &logger,
@@ -68,6 +123,7 @@ template<typename Iter, typename OnOutput>
 		rule::GraphAsRuleCache &graphAsRuleCache,
 		const LabelSettings labelSettings,
 		const bool doRuleIsomorphism,
+		RuleStats *stats,
 		OnOutput onOutput) {
 	if(verbosity >= V_RuleApplication) {
 		logger.indent() << "Bind round " << (bindRound + 1) << " with "
@@ -78,53 +134,141 @@ template<typename Iter, typename OnOutput>
 	int numDup = 0;
 	int numUnique = 0;
 	std::vector<BoundRule> outputRules;
-	for(const BoundRule &brInput: inputRules) {
+	BoundRuleIndex index(labelSettings.type);
+	const auto handleResult = [labelSettings, doRuleIsomorphism, &outputRules, &index, firstGraph, &onOutput, &numUnique, &numDup](
+			IO::Logger &logger, const BoundRule &brInput, const Iter iterGraph, std::unique_ptr<lib::rule::Rule> r) -> bool {
+		BoundRule brOutput{r.release(), brInput.boundGraphs,
+		                   static_cast<int>(iterGraph - firstGraph)};
+		brOutput.boundGraphs.push_back(*iterGraph);
+		if(!brOutput.rule->isOnlyRightSide()) {
+			// check if we have it already
+			brOutput.makeCanonical();
+			if(doRuleIsomorphism) {
+				auto &bucket = index.getBucket(brOutput);
+				for(const std::size_t iStored: bucket) {
+					if(outputRules[iStored].isomorphicTo(brOutput, labelSettings)) {
+						delete brOutput.rule;
+						++numDup;
+						return true;
+					}
+				}
+				bucket.push_back(outputRules.size());
+			}
+			// we store a copy of the bound info so the user can mess with their copy
+			outputRules.push_back(brOutput);
+		}
+		++numUnique;
+		return onOutput(logger, std::move(brOutput));
+	};
+	const auto logBindStart = [verbosity](IO::Logger &logger, const lib::graph::Graph *g, const BoundRule &brInput) {
+		if(verbosity >= V_RuleApplication_Binding) {
+			logger.indent() << "Trying to bind " << g->getName() << " to " << brInput << ":" << std::endl;
+			++logger.indentLevel;
+		}
+	};
+	const auto logBindEnd = [verbosity](IO::Logger &logger) {
+		if(verbosity >= V_RuleApplication_Binding)
+			--logger.indentLevel;
+	};
+	const auto logInputStart = [verbosity](IO::Logger &logger, const BoundRule &brInput) {
 		if(verbosity >= V_RuleApplication_Binding) {
 			logger.indent() << "Processing input rule " << brInput << std::endl;
 			++logger.indentLevel;
 		}
-		// try to bind with all graphs that haven't been tried yet
-		assert(brInput.nextGraphOffset <= lastGraph - firstGraph);
-		const auto brFirstGraph = firstGraph + brInput.nextGraphOffset;
-		for(auto iterGraph = brFirstGraph; iterGraph != lastGraph; ++iterGraph) {
-			const auto *g = *iterGraph;
-			if(verbosity >= V_RuleApplication_Binding) {
-				logger.indent() << "Trying to bind " << g->getName() << " to " << brInput << ":" << std::endl;
-				++logger.indentLevel;
+	};
+	const auto logInputEnd = logBindEnd;
+
+	if(!canBindInParallel(labelSettings)) {
+		for(const BoundRule &brInput: inputRules) {
+			logInputStart(logger, brInput);
+			// try to bind with all graphs that haven't been tried yet
+			assert(brInput.nextGraphOffset <= lastGraph - firstGraph);
+			const auto brFirstGraph = firstGraph + brInput.nextGraphOffset;
+			for(auto iterGraph = brFirstGraph; iterGraph != lastGraph; ++iterGraph) {
+				const auto *g = *iterGraph;
+				logBindStart(logger, g, brInput);
+				const auto reporter = [&logger, &handleResult, &brInput, iterGraph]
+						(std::unique_ptr<lib::rule::Rule> r, const lib::RC::ResultMaps &) -> bool {
+					return handleResult(logger, brInput, iterGraph, std::move(r));
+				};
+				const lib::rule::Rule &rFirst = graphAsRuleCache.getBindRule(g)->getRule();
+				const lib::rule::Rule &rSecond = *brInput.rule;
+				lib::RC::Super mm(toRCVerbosity(verbosity), logger, true, true);
+				if(stats) ++stats->numCompositions;
+				lib::RC::composeFromMatchMaker(rFirst, rSecond, mm, reporter, labelSettings);
+				logBindEnd(logger);
 			}
-			const auto reporter =
-					[labelSettings, doRuleIsomorphism, &logger, &brInput, &outputRules, firstGraph, iterGraph, onOutput, &numUnique, &numDup]
-							(std::unique_ptr<lib::rule::Rule> r, const lib::RC::ResultMaps&) -> bool {
-						BoundRule brOutput{r.release(), brInput.boundGraphs,
-						                   static_cast<int>(iterGraph - firstGraph)};
-						brOutput.boundGraphs.push_back(*iterGraph);
-						if(!brOutput.rule->isOnlyRightSide()) {
-							// check if we have it already
-							brOutput.makeCanonical();
-							if(doRuleIsomorphism) {
-								for(const BoundRule &brStored: outputRules) {
-									if(brStored.isomorphicTo(brOutput, labelSettings)) {
-										delete brOutput.rule;
-										++numDup;
-										return true;
-									}
-								}
-							}
-							// we store a copy of the bound info so the user can mess with their copy
-							outputRules.push_back(brOutput);
-						}
-						++numUnique;
-						return onOutput(logger, std::move(brOutput));
-					};
-			const lib::rule::Rule &rFirst = graphAsRuleCache.getBindRule(g)->getRule();
-			const lib::rule::Rule &rSecond = *brInput.rule;
-			lib::RC::Super mm(toRCVerbosity(verbosity), logger, true, true);
+			logInputEnd(logger);
+		}
+	} else {
+		// Phase 1: serially prepare all shared data, so the compositions only read from it.
+		const auto numGraphs = lastGraph - firstGraph;
+		std::vector<const lib::rule::Rule *> bindRules;
+		bindRules.reserve(numGraphs);
+		for(auto iterGraph = firstGraph; iterGraph != lastGraph; ++iterGraph) {
+			const lib::rule::Rule &rFirst = graphAsRuleCache.getBindRule(*iterGraph)->getRule();
+			prepareForParallelBinding(rFirst);
+			bindRules.push_back(&rFirst);
+		}
+		struct Task {
+			std::size_t inputIdx;
+			Iter iterGraph;
+			std::vector<std::unique_ptr<lib::rule::Rule>> results;
+			std::string log;
+			GraphMorphism::VF2Counters vf2;
+		};
+		std::vector<Task> tasks;
+		for(std::size_t inputIdx = 0; inputIdx != inputRules.size(); ++inputIdx) {
+			const BoundRule &brInput = inputRules[inputIdx];
+			assert(brInput.nextGraphOffset <= numGraphs);
+			prepareForParallelBinding(*brInput.rule);
+			for(auto iterGraph = firstGraph + brInput.nextGraphOffset; iterGraph != lastGraph; ++iterGraph)
+				tasks.push_back(Task{inputIdx, iterGraph, {}, {}, {}});
+		}
+		// Phase 2: compose in parallel, each task stores its results and log output.
+		const int rcVerbosity = toRCVerbosity(verbosity);
+		const int taskIndentLevel = logger.indentLevel + (verbosity >= V_RuleApplication_Binding ? 2 : 0);
+		// the VF2 counting is per thread, so each task counts on its own
+		GraphMorphism::VF2Counters *const vf2Outer = GraphMorphism::getThreadVF2Counters();
+		lib::parallelFor(getConfig().common.numThreads, tasks.size(), [&](std::size_t iTask) {
+			Task &task = tasks[iTask];
+			GraphMorphism::VF2CounterScope vf2Scope(vf2Outer ? &task.vf2 : nullptr);
+			std::ostringstream ss;
+			IO::Logger taskLogger(ss);
+			taskLogger.indentLevel = taskIndentLevel;
+			const auto reporter = [&task](std::unique_ptr<lib::rule::Rule> r, const lib::RC::ResultMaps &) -> bool {
+				task.results.push_back(std::move(r));
+				return true;
+			};
+			const lib::rule::Rule &rFirst = *bindRules[task.iterGraph - firstGraph];
+			const lib::rule::Rule &rSecond = *inputRules[task.inputIdx].rule;
+			lib::RC::Super mm(rcVerbosity, taskLogger, true, true);
 			lib::RC::composeFromMatchMaker(rFirst, rSecond, mm, reporter, labelSettings);
-			if(verbosity >= V_RuleApplication_Binding)
-				--logger.indentLevel;
+			task.log = ss.str();
+		});
+		if(stats) stats->numCompositions += tasks.size();
+		// Phase 3: merge in the order of the serial execution.
+		for(std::size_t iTask = 0; iTask != tasks.size(); ++iTask) {
+			Task &task = tasks[iTask];
+			if(vf2Outer) *vf2Outer += task.vf2;
+			const BoundRule &brInput = inputRules[task.inputIdx];
+			if(iTask == 0 || tasks[iTask - 1].inputIdx != task.inputIdx)
+				logInputStart(logger, brInput);
+			logBindStart(logger, *task.iterGraph, brInput);
+			logger.s << task.log;
+			for(auto &r: task.results) {
+				// the serial execution would have stopped the composition at this point
+				if(!handleResult(logger, brInput, task.iterGraph, std::move(r))) break;
+			}
+			task.results.clear();
+			logBindEnd(logger);
+			if(iTask + 1 == tasks.size() || tasks[iTask + 1].inputIdx != task.inputIdx)
+				logInputEnd(logger);
 		}
-		if(verbosity >= V_RuleApplication_Binding)
-			--logger.indentLevel;
+	}
+	if(stats) {
+		stats->numBoundRules += numUnique + numDup;
+		stats->numBoundRulesDuplicate += numDup;
 	}
 	if(verbosity >= V_RuleApplication) {
 		logger.indent() << "Result of bind round " << (bindRound + 1) << ": "
@@ -143,7 +287,13 @@ struct BoundRuleStorage {
 	                 const BoundRule &rule,
 	                 const lib::graph::Graph *graph)
 			: verbose(verbose), logger(logger), labelType(labelType), withStereo(withStereo),
-			  ruleStore(ruleStore), rule(rule), graph(graph) {}
+			  ruleStore(ruleStore), rule(rule), graph(graph), index(labelType) {
+		for(std::size_t i = 0; i != ruleStore.size(); ++i) {
+			if(ruleStore[i].rule->isOnlyRightSide()) continue;
+			ruleStore[i].makeCanonical();
+			index.getBucket(ruleStore[i]).push_back(i);
+		}
+	}
 
 	void add(lib::rule::Rule *r) {
 		BoundRule p{r, rule.boundGraphs, -1};
@@ -152,35 +302,16 @@ struct BoundRuleStorage {
 		const bool doBoundRulesDuplicateCheck = true;
 		// if it's only right side, we will rather split it instead
 		if(doBoundRulesDuplicateCheck && !r->isOnlyRightSide()) {
-			std::vector<const lib::graph::Graph *> &rThis = p.boundGraphs;
-
-			std::sort(begin(rThis), end(rThis), [](const lib::graph::Graph *g1, const lib::graph::Graph *g2) {
-				return g1->getId() < g2->getId();
-			});
-
-			for(BoundRule &rp: ruleStore) {
-				if(rThis.size() != rp.boundGraphs.size()) continue;
-				std::vector<const lib::graph::Graph *> &rOther = rp.boundGraphs;
-
-				std::sort(rOther.begin(), rOther.end(), [](const lib::graph::Graph *g1, const lib::graph::Graph *g2) {
-					return g1->getId() < g2->getId();
-				});
-				bool doContinue = false;
-				for(unsigned int i = 0; i < rThis.size(); i++) {
-					if(rThis[i] != rOther[i]) {
-						doContinue = true;
-						break;
-					}
-				}
-				if(doContinue) continue;
-				found = 1 == lib::rule::Rule::isomorphism(*r, *rp.rule, 1,
-				                                           {labelType, LabelRelation::Isomorphism, withStereo,
-				                                            LabelRelation::Isomorphism});
+			p.makeCanonical();
+			auto &bucket = index.getBucket(p);
+			const LabelSettings ls(labelType, LabelRelation::Isomorphism, withStereo, LabelRelation::Isomorphism);
+			for(const std::size_t iStored: bucket) {
+				found = ruleStore[iStored].isomorphicTo(p, ls);
 				if(found) break;
 			}
+			if(!found) bucket.push_back(ruleStore.size());
 		}
 		if(found) {
-			//			std::cout << "Duplicate BRP found" << std::endl;
 			delete r;
 		} else {
 			ruleStore.push_back(p);
@@ -202,6 +333,7 @@ private:
 	std::vector<BoundRule> &ruleStore;
 	const BoundRule &rule;
 	const lib::graph::Graph *graph;
+	BoundRuleIndex index;
 };
 
 
@@ -220,6 +352,36 @@ public:
 	std::vector<SideVertex> vertexMap;
 };
 
+// Wrap the product graphs, reusing isomorphic graphs from the database (through checkIfNew)
+// and from the previous products.
+template<typename CheckIfNew, typename OnDup>
+std::vector<std::shared_ptr<mod::graph::Graph>> wrapProducts(std::vector<GraphData> products,
+                                                        const LabelType labelType,
+                                                        const bool withStereo,
+                                                        CheckIfNew checkIfNew,
+                                                        OnDup onDup) {
+	std::vector<std::shared_ptr<mod::graph::Graph>> right;
+	for(auto &g: products) {
+		// check against the database
+		auto gCand = std::make_unique<lib::graph::Graph>(std::move(g.gPtr), std::move(g.pStringPtr),
+		                                                 std::move(g.pStereoPtr));
+		std::shared_ptr<mod::graph::Graph> gWrapped = checkIfNew(std::move(gCand));
+		// checkIfNew does not add the graph, so we must check against the previous products as well
+		for(auto gPrev: right) {
+			const auto ls = mod::LabelSettings(labelType, LabelRelation::Isomorphism, withStereo,
+			                                   LabelRelation::Isomorphism);
+			const bool iso = lib::graph::Graph::isomorphic(gPrev->getGraph(), gWrapped->getGraph(), ls);
+			if(iso) {
+				onDup(gWrapped, gPrev);
+				gWrapped = gPrev;
+				break;
+			}
+		}
+		right.push_back(gWrapped);
+	}
+	return right;
+}
+
 template<typename CheckIfNew, typename OnDup>
 std::vector<std::shared_ptr<mod::graph::Graph>> splitRule(const lib::rule::LabelledRule &rDPO,
                                                      const LabelType labelType,
@@ -289,27 +451,7 @@ std::vector<std::shared_ptr<mod::graph::Graph>> splitRule(const lib::rule::Label
 			p.pStereoPtr = std::make_unique<lib::graph::PropStereo>(*p.gPtr, inf);
 		} // end foreach product
 	} // end of stereo prop
-	// wrap them
-	std::vector<std::shared_ptr<mod::graph::Graph>> right;
-	for(auto &g: products) {
-		// check against the database
-		auto gCand = std::make_unique<lib::graph::Graph>(std::move(g.gPtr), std::move(g.pStringPtr),
-		                                                 std::move(g.pStereoPtr));
-		std::shared_ptr<mod::graph::Graph> gWrapped = checkIfNew(std::move(gCand));
-		// checkIfNew does not add the graph, so we must check against the previous products as well
-		for(auto gPrev: right) {
-			const auto ls = mod::LabelSettings(labelType, LabelRelation::Isomorphism, withStereo,
-			                                   LabelRelation::Isomorphism);
-			const bool iso = lib::graph::Graph::isomorphic(gPrev->getGraph(), gWrapped->getGraph(), ls);
-			if(iso) {
-				onDup(gWrapped, gPrev);
-				gWrapped = gPrev;
-				break;
-			}
-		}
-		right.push_back(gWrapped);
-	}
-	return right;
+	return wrapProducts(std::move(products), labelType, withStereo, checkIfNew, onDup);
 }
 
 } // namespace mod::lib::DG
@@ -4,6 +4,7 @@
 #include <mod/Function.hpp>
 #include <mod/graph/Graph.hpp>
 #include <mod/lib/DG/Strategies/GraphState.hpp>
+#include <mod/lib/Graph/Graph.hpp>
 
 #include <ostream>
 
@@ -90,7 +91,11 @@ void Add::executeImpl(PrintSettings settings, const GraphState &input) {
 		--settings.indentLevel;
 	}
 	switch(graphPolicy) {
-	case IsomorphismPolicy::Check:
+	case IsomorphismPolicy::Check: {
+		std::vector<const lib::graph::Graph *> gPtrs;
+		gPtrs.reserve(graphsToAdd.size());
+		for(const auto &g : graphsToAdd) gPtrs.push_back(&g->getGraph());
+		lib::graph::Graph::precomputeCanonForms(gPtrs, getExecutionEnv().labelSettings);
 		for(const std::shared_ptr<mod::graph::Graph> &g : graphsToAdd) {
 			// TODO: we need to add it as a vertex for backwards compatibility,
 			//       do this more elegantly
@@ -100,6 +105,7 @@ void Add::executeImpl(PrintSettings settings, const GraphState &input) {
 			getExecutionEnv().trustAddGraphAsVertex(g);
 		}
 		break;
+	}
 	case IsomorphismPolicy::TrustMe:
 		for(const auto &g : graphsToAdd)
 			getExecutionEnv().trustAddGraphAsVertex(g);
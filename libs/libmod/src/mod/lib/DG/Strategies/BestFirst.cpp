@@ -0,0 +1,273 @@
+#include "BestFirst.hpp"
+
+#include <mod/Derivation.hpp>
+#include <mod/Function.hpp>
+#include <mod/graph/Graph.hpp>
+#include <mod/lib/DG/Strategies/GraphState.hpp>
+#include <mod/lib/Graph/Graph.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <queue>
+#include <tuple>
+
+namespace mod::lib::DG::Strategies {
+
+namespace {
+
+// The state shared by the predicates pushed around the sub-strategies.
+struct Budget {
+	using Clock = std::chrono::steady_clock;
+public:
+	Budget(ExecutionEnv &env, const BestFirst::Limits &limits,
+	       const std::vector<std::shared_ptr<mod::graph::Graph>> &targets,
+	       std::vector<const lib::graph::Graph *> &found)
+			: env(env), limits(limits), targets(targets), found(found), start(Clock::now()) {}
+
+	bool derivationsExhausted() const {
+		return limits.maxDerivations != 0 && numDerivations >= limits.maxDerivations;
+	}
+
+	bool timeIsUp() const {
+		if(limits.timeLimit == 0) return false;
+		return std::chrono::duration<double>(Clock::now() - start).count() >= limits.timeLimit;
+	}
+
+	bool isTarget(const lib::graph::Graph &g) {
+		// the same products are derived over and over, so remember the answer by graph ID
+		if(g.getId() >= isTargetCache.size()) isTargetCache.resize(g.getId() + 1, Unknown);
+		auto &cached = isTargetCache[g.getId()];
+		if(cached == Unknown) {
+			const bool res = std::any_of(targets.begin(), targets.end(), [&](const auto &t) {
+				return lib::graph::Graph::isomorphic(g, t->getGraph(), env.labelSettings);
+			});
+			cached = res ? Yes : No;
+		}
+		return cached == Yes;
+	}
+
+	void onDerivation(const mod::Derivation &d) {
+		++numDerivations;
+		if(targets.empty()) return;
+		for(const auto &g: d.right) {
+			if(!isTarget(g->getGraph())) continue;
+			if(std::find(found.begin(), found.end(), &g->getGraph()) == found.end())
+				found.push_back(&g->getGraph());
+			env.requestExit();
+		}
+	}
+public:
+	ExecutionEnv &env;
+	const BestFirst::Limits &limits;
+	const std::vector<std::shared_ptr<mod::graph::Graph>> &targets;
+	std::vector<const lib::graph::Graph *> &found;
+	const Clock::time_point start;
+	int numDerivations = 0;
+private:
+	enum Answer : signed char {
+		Unknown, No, Yes
+	};
+	std::vector<Answer> isTargetCache;
+};
+
+// On the left side the budgets are checked before the products are constructed,
+// and on the right side the accepted derivations are counted and checked for targets.
+// The predicates are pushed before the ones of the sub-strategy, so they are checked last.
+struct BudgetPredicate : mod::Function<bool(const mod::Derivation &)> {
+	BudgetPredicate(std::shared_ptr<Budget> budget, bool onRight) : budget(std::move(budget)), onRight(onRight) {}
+
+	std::shared_ptr<mod::Function<bool(const mod::Derivation &)>> clone() const override {
+		return std::make_shared<BudgetPredicate>(budget, onRight);
+	}
+
+	void print(std::ostream &s) const override {
+		s << "BestFirst budget";
+	}
+
+	bool operator()(const mod::Derivation &d) const override {
+		if(budget->derivationsExhausted() || budget->timeIsUp()) return false;
+		if(onRight) budget->onDerivation(d);
+		return true;
+	}
+private:
+	// shared, as clones of the predicates may outlive executeImpl
+	const std::shared_ptr<Budget> budget;
+	const bool onRight;
+};
+
+// Pops the budget predicates again when the execution ends, also by an exception.
+struct BudgetPredicateScope {
+	BudgetPredicateScope(ExecutionEnv &env, const std::shared_ptr<Budget> &budget) : env(env) {
+		env.pushLeftPredicate(std::make_shared<BudgetPredicate>(budget, false));
+		env.pushRightPredicate(std::make_shared<BudgetPredicate>(budget, true));
+	}
+
+	BudgetPredicateScope(const BudgetPredicateScope &) = delete;
+	BudgetPredicateScope &operator=(const BudgetPredicateScope &) = delete;
+
+	~BudgetPredicateScope() {
+		env.popRightPredicate();
+		env.popLeftPredicate();
+	}
+private:
+	ExecutionEnv &env;
+};
+
+void printLimits(std::ostream &s, const BestFirst::Limits &limits) {
+	s << "maxExpansions = " << limits.maxExpansions
+	  << ", maxVertices = " << limits.maxVertices
+	  << ", maxDerivations = " << limits.maxDerivations
+	  << ", timeLimit = " << limits.timeLimit;
+}
+
+} // namespace
+
+BestFirst::BestFirst(std::unique_ptr<Strategy> strat, std::shared_ptr<Score> score,
+                     std::vector<std::shared_ptr<mod::graph::Graph>> targets, Limits limits)
+		: Strategy(strat->getMaxComponents()), strat(std::move(strat)), score(std::move(score)),
+		  targets(std::move(targets)), limits(limits) {
+	assert(this->score);
+	assert(limits.maxExpansions >= 0);
+	assert(limits.maxVertices >= 0);
+	assert(limits.maxDerivations >= 0);
+	assert(limits.timeLimit >= 0);
+}
+
+BestFirst::~BestFirst() = default;
+
+std::unique_ptr<Strategy> BestFirst::clone() const {
+	return std::make_unique<BestFirst>(strat->clone(), score->clone(), targets, limits);
+}
+
+void BestFirst::preAddGraphs(std::function<void(std::shared_ptr<mod::graph::Graph>, IsomorphismPolicy)> add) const {
+	strat->preAddGraphs(add);
+}
+
+void BestFirst::forEachRule(std::function<void(const lib::rule::Rule &)> f) const {
+	strat->forEachRule(f);
+}
+
+void BestFirst::printInfo(PrintSettings settings) const {
+	std::ostream &s = settings.s;
+	settings.indent() << "BestFirst, score = ";
+	score->print(s);
+	s << ", ";
+	printLimits(s, limits);
+	s << '\n';
+	++settings.indentLevel;
+	settings.indent() << "targets =";
+	for(const auto &g: targets)
+		s << " " << g->getName();
+	s << '\n';
+	for(int i = 0; i != expansions.size(); ++i) {
+		settings.indent() << "Expansion " << (i + 1) << ": " << expansions[i].g->getName()
+		                  << ", score = " << expansions[i].score
+		                  << ", new graphs = " << expansions[i].numNew << '\n';
+	}
+	settings.indent() << "stopped: " << stopReason << '\n';
+	settings.indent() << "found =";
+	for(const auto *g: found)
+		s << " " << g->getName();
+	s << '\n';
+	printBaseInfo(settings);
+}
+
+bool BestFirst::isConsumed(const lib::graph::Graph *g) const {
+	return g->getId() < consumed.size() && consumed[g->getId()];
+}
+
+void BestFirst::setExecutionEnvImpl() {
+	strat->setExecutionEnv(getExecutionEnv());
+}
+
+void BestFirst::executeImpl(PrintSettings settings, const GraphState &input) {
+	if(settings.verbosity >= PrintSettings::V_BestFirst) {
+		settings.indent() << "BestFirst, ";
+		printLimits(settings.s, limits);
+		settings.s << std::endl;
+	}
+	++settings.indentLevel;
+	const auto budget = std::make_shared<Budget>(getExecutionEnv(), limits, targets, found);
+	const BudgetPredicateScope budgetScope(getExecutionEnv(), budget);
+
+	// ordered by score and then by insertion, unscorable graphs last
+	using Entry = std::tuple<double, std::size_t, const lib::graph::Graph *>;
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> frontier;
+	std::vector<bool> seen; // indexed by graph ID
+	std::size_t numPushed = 0;
+	const auto push = [&](const lib::graph::Graph *g) {
+		if(g->getId() >= seen.size()) seen.resize(g->getId() + 1, false);
+		if(seen[g->getId()]) return false;
+		seen[g->getId()] = true;
+		double s = (*score)(g->getAPIReference());
+		if(std::isnan(s)) s = std::numeric_limits<double>::infinity();
+		frontier.emplace(s, numPushed++, g);
+		return true;
+	};
+	for(const auto *g: input.getSubset())
+		push(g);
+
+	GraphState universe(input.getUniverse());
+	const auto addConsumed = [this](const GraphState &gs, const Strategy &s) {
+		for(const auto *g: gs.getUniverse()) {
+			if(!s.isConsumed(g)) continue;
+			if(g->getId() >= consumed.size()) consumed.resize(g->getId() + 1, false);
+			consumed[g->getId()] = true;
+		}
+	};
+	while(true) {
+		if(getExecutionEnv().doExit()) stopReason = found.empty() ? "exit requested" : "target found";
+		else if(frontier.empty()) stopReason = "empty frontier";
+		else if(limits.maxExpansions != 0 && expansions.size() >= limits.maxExpansions)
+			stopReason = "expansion limit reached";
+		else if(limits.maxVertices != 0 && universe.getUniverse().size() >= limits.maxVertices)
+			stopReason = "vertex limit reached";
+		else if(budget->derivationsExhausted()) stopReason = "derivation limit reached";
+		else if(budget->timeIsUp()) stopReason = "time limit reached";
+		if(!stopReason.empty()) break;
+
+		const auto[s, order, g] = frontier.top();
+		frontier.pop();
+		GraphState stepInput(universe);
+		stepInput.addToSubset(g);
+		auto subStrat = strat->clone();
+		subStrat->setExecutionEnv(getExecutionEnv());
+		if(settings.verbosity >= PrintSettings::V_BestFirstExpansion)
+			settings.indent() << "Expansion " << (expansions.size() + 1) << ": " << g->getName()
+			                  << ", score = " << s << std::endl;
+		++settings.indentLevel;
+		subStrat->execute(settings, stepInput);
+		--settings.indentLevel;
+
+		const GraphState &stepOutput = subStrat->getOutput();
+		for(const auto *h: stepOutput.getUniverse())
+			universe.addToUniverse(h);
+		std::size_t numNew = 0;
+		for(const auto *h: stepOutput.getSubset())
+			if(push(h)) ++numNew;
+		// a consumed graph must be in the universe of the step, but the universe may have been filtered
+		addConsumed(stepInput, *subStrat);
+		addConsumed(stepOutput, *subStrat);
+		expansions.push_back({g, s, numNew});
+		if(settings.verbosity >= PrintSettings::V_BestFirstExpansion)
+			settings.indent() << "Expansion " << (expansions.size()) << ": " << numNew << " new graphs, "
+			                  << frontier.size() << " in the frontier." << std::endl;
+	}
+	if(settings.verbosity >= PrintSettings::V_BestFirst) {
+		settings.indent() << "Stopped after " << expansions.size() << " expansions: " << stopReason << "." << std::endl;
+		for(const auto *g: found)
+			settings.indent() << "Found target " << g->getName() << "." << std::endl;
+	}
+
+	// the unexpanded graphs, best first
+	output = new GraphState(universe.getUniverse());
+	for(; !frontier.empty(); frontier.pop())
+		output->addToSubset(std::get<2>(frontier.top()));
+}
+
+} // namespace mod::lib::DG::Strategies
@@ -0,0 +1,59 @@
+#ifndef MOD_LIB_DG_STRATEGIES_BESTFIRST_HPP
+#define MOD_LIB_DG_STRATEGIES_BESTFIRST_HPP
+
+#include <mod/lib/DG/Strategies/Strategy.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mod::lib::DG::Strategies {
+
+// Expands one graph at a time, always the unexpanded graph with the lowest score,
+// by executing a copy of the sub-strategy with only that graph in the subset.
+// The new graphs in the output subset of each expansion are scored and added to the frontier.
+// The search ends when the frontier is empty, a budget is exhausted, or a target graph has been derived,
+// in which case the rest of the execution is skipped through ExecutionEnv::requestExit().
+struct BestFirst : Strategy {
+	using Score = mod::Function<double(std::shared_ptr<mod::graph::Graph>)>;
+	struct Limits {
+		// 0 means no limit
+		int maxExpansions = 0;
+		int maxVertices = 0; // the size of the universe
+		int maxDerivations = 0;
+		double timeLimit = 0; // in seconds
+	};
+public:
+	// pre: the limits are non-negative
+	BestFirst(std::unique_ptr<Strategy> strat, std::shared_ptr<Score> score,
+	          std::vector<std::shared_ptr<mod::graph::Graph>> targets, Limits limits);
+	virtual ~BestFirst() override;
+	virtual std::unique_ptr<Strategy> clone() const override;
+	virtual void preAddGraphs(std::function<void(std::shared_ptr<mod::graph::Graph>, IsomorphismPolicy)> add) const override;
+	virtual void forEachRule(std::function<void(const lib::rule::Rule &)> f) const override;
+	virtual void printInfo(PrintSettings settings) const override;
+	virtual bool isConsumed(const lib::graph::Graph *g) const override;
+private:
+	virtual void setExecutionEnvImpl() override;
+	virtual void executeImpl(PrintSettings settings, const GraphState &input) override;
+private:
+	std::unique_ptr<Strategy> strat;
+	std::shared_ptr<Score> score;
+	std::vector<std::shared_ptr<mod::graph::Graph>> targets;
+	Limits limits;
+	// The sub-strategies are discarded after each expansion,
+	// so only summaries and a bitset of the consumed graphs are kept.
+	struct Expansion {
+		const lib::graph::Graph *g;
+		double score;
+		std::size_t numNew;
+	};
+	std::vector<Expansion> expansions;
+	std::vector<bool> consumed; // indexed by graph ID
+	std::vector<const lib::graph::Graph *> found;
+	std::string stopReason;
+};
+
+} // namespace mod::lib::DG::Strategies
+
+#endif // MOD_LIB_DG_STRATEGIES_BESTFIRST_HPP
\ No newline at end of file
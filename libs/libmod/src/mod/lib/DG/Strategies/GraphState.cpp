@@ -8,46 +8,42 @@ namespace mod::lib::DG::Strategies {
 GraphState::GraphState() : subset(*this) {}
 
 GraphState::GraphState(const GraphState &other)
-		: universe(other.universe), subset(*this, other.subset) {}
+		: universe(other.universe), subset(*this, other.subset),
+		  universeIndex(other.universeIndex), subsetMembership(other.subsetMembership) {}
 
 GraphState::GraphState(const std::vector<const lib::graph::Graph *> &universe)
-		: universe(universe), subset(*this) {}
+		: universe(universe), subset(*this) {
+	reindexUniverse();
+	assert(universeIndex->size() == this->universe.size());
+}
 
 GraphState::GraphState(const std::vector<const GraphState *> &resultSets) : subset(*this) {
-	// collect universe
+	// collect the universe, ordered by ID
+	// (the input universes need not be ordered, e.g., after sortUniverse, so the union is sorted once)
+	for(const GraphState *rs : resultSets)
+		for(const lib::graph::Graph *g : rs->getUniverse())
+			if(universeIndex->emplace(g->getId(), -1).second)
+				universe.push_back(g);
+	std::sort(universe.begin(), universe.end(), lib::graph::Graph::IdLess());
+	reindexUniverse();
+	// collect the subset, also ordered by ID, i.e., by index
 	for(const GraphState *rs : resultSets) {
-		GraphState::GraphList other(rs->getUniverse());
-		std::sort(other.begin(), other.end(), [](const lib::graph::Graph *g1, const lib::graph::Graph *g2) {
-			return g1->getId() < g2->getId();
-		});
-
-		GraphState::GraphList result;
-		std::set_union(universe.begin(), universe.end(), other.begin(), other.end(),
-		               std::back_inserter(result),
-		               lib::graph::Graph::IdLess());
-		std::swap(result, universe);
+		for(const lib::graph::Graph *g : rs->subset) {
+			const int index = getUniverseIndex(g);
+			assert(index != -1);
+			subsetMembership[index] = true;
+		}
 	}
-	// collect the subset
-	std::set<const lib::graph::Graph *, lib::graph::Graph::IdLess> newSubset;
-	for(const GraphState *rs : resultSets)
-		for(const lib::graph::Graph *g : rs->subset)
-			newSubset.insert(g);
-
-	using GraphToIndex = std::map<const lib::graph::Graph *, int>;
-	GraphToIndex graphToIndex;
 	for(int i = 0; i != universe.size(); i++)
-		graphToIndex[universe[i]] = i;
-
-	for(const lib::graph::Graph *g : newSubset)
-		subset.indices.push_back(graphToIndex[g]);
+		if(subsetMembership[i]) subset.indices.push_back(i);
 }
 
 GraphState::~GraphState() {}
 
 void GraphState::addToSubset(const lib::graph::Graph *g) {
 	const int gIndex = addUniverseGetIndex(g);
-	for(int index : subset.indices)
-		if(index == gIndex) return;
+	if(subsetMembership[gIndex]) return;
+	subsetMembership[gIndex] = true;
 	subset.indices.push_back(gIndex);
 }
 
@@ -64,36 +60,67 @@ const GraphState::GraphList &GraphState::getUniverse() const {
 }
 
 bool GraphState::isInUniverse(const lib::graph::Graph *g) const {
-	for(int i = 0; i != universe.size(); i++)
-		if(universe[i] == g)
-			return true;
-	return false;
+	return getUniverseIndex(g) != -1;
+}
+
+bool GraphState::isInSubset(const lib::graph::Graph *g) const {
+	const int index = getUniverseIndex(g);
+	return index != -1 && subsetMembership[index];
 }
 
 bool operator==(const GraphState &a, const GraphState &b) {
 	if(a.universe.size() != b.universe.size()) return false;
 	if(a.subset.size() != b.subset.size()) return false;
-	GraphState aCopy(a), bCopy(b);
-	std::less<const lib::graph::Graph *> comp;
-	aCopy.sortUniverse(comp);
-	bCopy.sortUniverse(comp);
-	for(int i = 0; i != a.universe.size(); i++)
-		if(aCopy.universe[i] != bCopy.universe[i])
-			return false;
-	aCopy.sortSubset(comp);
-	bCopy.sortSubset(comp);
-	for(int i = 0; i != aCopy.subset.size(); i++)
-		if(*(aCopy.subset.begin() + i) != *(bCopy.subset.begin() + i))
-			return false;
+	for(const lib::graph::Graph *g : a.universe)
+		if(!b.isInUniverse(g)) return false;
+	for(const lib::graph::Graph *g : a.subset)
+		if(!b.isInSubset(g)) return false;
 	return true;
 }
 
 int GraphState::addUniverseGetIndex(const lib::graph::Graph *g) {
-	for(int i = 0; i != universe.size(); i++)
-		if(universe[i] == g)
-			return i;
+	const int index = getUniverseIndex(g);
+	if(index != -1) return index;
+	if(universeIndex.use_count() > 1) universeIndex = std::make_shared<UniverseIndex>(*universeIndex);
+	universeIndex->emplace(g->getId(), universe.size());
 	universe.push_back(g);
+	subsetMembership.push_back(false);
 	return universe.size() - 1;
 }
 
+int GraphState::getUniverseIndex(const lib::graph::Graph *g) const {
+	const auto iter = universeIndex->find(g->getId());
+	if(iter == universeIndex->end()) return -1;
+	assert(universe[iter->second] == g);
+	return iter->second;
+}
+
+void GraphState::reindexUniverse() {
+	// a fresh index, as the old one may be shared
+	auto newIndex = std::make_shared<UniverseIndex>();
+	newIndex->reserve(universe.size());
+	for(int i = 0; i != universe.size(); i++)
+		(*newIndex)[universe[i]->getId()] = i;
+	universeIndex = std::move(newIndex);
+	subsetMembership.assign(universe.size(), false);
+	for(const int index : subset.indices)
+		subsetMembership[index] = true;
+}
+
+void GraphState::permuteUniverse(const std::vector<int> &newToOld) {
+	assert(newToOld.size() == universe.size());
+	std::vector<int> oldToNew(universe.size());
+	for(int i = 0; i != universe.size(); i++)
+		oldToNew[newToOld[i]] = i;
+	{
+		GraphList newUniverse(universe.size());
+		for(int i = 0; i != universe.size(); i++)
+			newUniverse[i] = universe[newToOld[i]];
+		std::swap(newUniverse, universe);
+	}
+	for(unsigned int i = 0; i != subset.indices.size(); i++)
+		subset.indices[i] = oldToNew[subset.indices[i]];
+	reindexUniverse();
+}
+
 } // namespace mod::lib::DG::Strategies
\ No newline at end of file
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -21,7 +22,7 @@ struct GraphState {
 		struct Transformer {
 			Transformer(const GraphList &graphs) : graphs(graphs) {}
 			GraphList::value_type operator()(int i) const {
-				assert(i < graphs.size());
+				assert(std::size_t(i) < graphs.size());
 				return graphs[i];
 			}
 		private:
@@ -76,12 +77,23 @@ public:
 	const Subset &getSubset() const;
 	const GraphList &getUniverse() const;
 	bool isInUniverse(const lib::graph::Graph *g) const;
+	bool isInSubset(const lib::graph::Graph *g) const;
 	friend bool operator==(const GraphState &a, const GraphState &b);
 private:
 	int addUniverseGetIndex(const lib::graph::Graph *g);
+	// returns -1 if g is not in the universe
+	int getUniverseIndex(const lib::graph::Graph *g) const;
+	void reindexUniverse();
+	void permuteUniverse(const std::vector<int> &newToOld);
 private:
 	GraphList universe;
 	Subset subset;
+	// For constant time lookups, the index of each graph in the universe, by graph ID,
+	// and whether each graph in the universe is in the subset, by universe index.
+	// The index is shared by copies of a state until one of them adds to its universe.
+	using UniverseIndex = std::unordered_map<std::size_t, int>;
+	std::shared_ptr<UniverseIndex> universeIndex = std::make_shared<UniverseIndex>();
+	std::vector<bool> subsetMembership;
 };
 
 template<typename T>
@@ -92,8 +104,8 @@ public:
 			: graphs(graphs), compare(compare) {}
 
 	bool operator()(int a, int b) {
-		assert(a < graphs.size());
-		assert(b < graphs.size());
+		assert(std::size_t(a) < graphs.size());
+		assert(std::size_t(b) < graphs.size());
 		assert(graphs[a]);
 		assert(graphs[b]);
 		return compare(graphs[a], graphs[b]);
@@ -105,24 +117,14 @@ public:
 template<typename T>
 void GraphState::sortUniverse(T compare) {
 	std::vector<int> newToOld(universe.size());
-	for(int i = 0; i != newToOld.size(); i++) newToOld[i] = i;
+	for(std::size_t i = 0; i != newToOld.size(); i++) newToOld[i] = i;
 	Compare<T> comp(universe, compare);
 	std::stable_sort(newToOld.begin(), newToOld.end(), comp);
-	std::vector<int> oldToNew(universe.size());
-	for(int i = 0; i != universe.size(); i++)
-		oldToNew[newToOld[i]] = i;
-	{
-		GraphList newUniverse(universe.size());
-		for(int i = 0; i != universe.size(); i++)
-			newUniverse[i] = universe[newToOld[i]];
-		std::swap(newUniverse, universe);
-	}
+	permuteUniverse(newToOld);
 	{ // TODO: remove, stupid sanity check
-		for(int i = 1; i < universe.size(); i++)
+		for(std::size_t i = 1; i < universe.size(); i++)
 			assert(!compare(universe[i], universe[i - 1]));
 	}
-	for(unsigned int i = 0; i != subset.indices.size(); i++)
-		subset.indices[i] = oldToNew[subset.indices[i]];
 }
 
 template<typename T>
@@ -2,6 +2,7 @@
 
 #include <mod/Config.hpp>
 #include <mod/lib/DG/Strategies/GraphState.hpp>
+#include <mod/lib/Graph/Graph.hpp>
 
 #include <ostream>
 
@@ -29,8 +30,12 @@ void Repeat::forEachRule(std::function<void(const lib::rule::Rule &)> f) const {
 void Repeat::printInfo(PrintSettings settings) const {
 	settings.indent() << "Repeat, limit = " << limit << '\n';
 	++settings.indentLevel;
+	for(int i = 0; i != foldedRounds.size(); i++) {
+		settings.indent() << "Round " << (i + 1) << ": details discarded, output subset size = "
+		                  << foldedRounds[i].subsetSize << ", universe size = " << foldedRounds[i].universeSize << '\n';
+	}
 	for(int i = 0; i != subStrats.size(); i++) {
-		settings.indent() << "Round " << (i + 1) << ":\n";
+		settings.indent() << "Round " << (foldedRounds.size() + i + 1) << ":\n";
 		++settings.indentLevel;
 		subStrats[i]->printInfo(settings);
 		--settings.indentLevel;
@@ -47,6 +52,7 @@ const GraphState &Repeat::getOutput() const {
 }
 
 bool Repeat::isConsumed(const lib::graph::Graph *g) const {
+	if(g->getId() < foldedConsumed.size() && foldedConsumed[g->getId()]) return true;
 	for(const auto &s : subStrats)
 		if(s->isConsumed(g)) return true;
 	return false;
@@ -60,6 +66,7 @@ void Repeat::executeImpl(PrintSettings settings, const GraphState &input) {
 	if(settings.verbosity >= PrintSettings::V_Repeat)
 		settings.indent() << "Repeat, limit = " << limit << std::endl;
 	assert(limit >= 0);
+	keepAllRounds = !getConfig().dg.repeatKeepOnlyLastRounds;
 	++settings.indentLevel;
 	for(int i = 0; i != limit; ++i) {
 		{
@@ -68,10 +75,16 @@ void Repeat::executeImpl(PrintSettings settings, const GraphState &input) {
 			if(settings.verbosity >= PrintSettings::V_Repeat)
 				settings.indent() << "Round " << (i + 1) << ":" << std::endl;
 			++settings.indentLevel;
-			if(i == 0)
+			if(i == 0) {
+				if(!keepAllRounds) subInputs.push_back(nullptr);
 				subStrat->execute(settings, input);
-			else
-				subStrat->execute(settings, subStrats[i - 1]->getOutput());
+			} else if(keepAllRounds) {
+				subStrat->execute(settings, subStrats.back()->getOutput());
+			} else {
+				// the previous round will be discarded later, so give this round its own input
+				subInputs.push_back(std::make_unique<GraphState>(subStrats.back()->getOutput()));
+				subStrat->execute(settings, *subInputs.back());
+			}
 			--settings.indentLevel;
 
 			if(settings.verbosity >= PrintSettings::V_Repeat) {
@@ -80,6 +93,7 @@ void Repeat::executeImpl(PrintSettings settings, const GraphState &input) {
 				                  << " graphs." << std::endl;
 			}
 			subStrats.push_back(std::move(subStrat));
+			if(!keepAllRounds && subStrats.size() > 2) foldFirstRound();
 		}
 		if(subStrats.back()->getOutput().getSubset().empty()) {
 			if(settings.verbosity >= PrintSettings::V_RepeatBreak)
@@ -88,7 +102,7 @@ void Repeat::executeImpl(PrintSettings settings, const GraphState &input) {
 		}
 		if(!getConfig().dg.disableRepeatFixedPointCheck) {
 			if(i > 0) {
-				if(subStrats.back()->getOutput() == subStrats[i - 1]->getOutput()) {
+				if(subStrats.back()->getOutput() == subStrats[subStrats.size() - 2]->getOutput()) {
 					if(settings.verbosity >= PrintSettings::V_RepeatBreak)
 						settings.indent() << "Round " << (i + 1) << ": Breaking repeat due to fixed point." << std::endl;
 					break;
@@ -98,4 +112,25 @@ void Repeat::executeImpl(PrintSettings settings, const GraphState &input) {
 	}
 }
 
+void Repeat::foldFirstRound() {
+	assert(!keepAllRounds);
+	assert(subStrats.size() == subInputs.size());
+	const Strategy &s = *subStrats.front();
+	const GraphState &roundInput = subInputs.front() ? *subInputs.front() : *input;
+	const GraphState &roundOutput = s.getOutput();
+	foldedRounds.push_back({roundOutput.getSubset().size(), roundOutput.getUniverse().size()});
+	// a consumed graph must be in the universe of the round, but the universe may have been filtered
+	const auto addConsumed = [&](const GraphState &gs) {
+		for(const auto *g : gs.getUniverse()) {
+			if(!s.isConsumed(g)) continue;
+			if(g->getId() >= foldedConsumed.size()) foldedConsumed.resize(g->getId() + 1, false);
+			foldedConsumed[g->getId()] = true;
+		}
+	};
+	addConsumed(roundInput);
+	addConsumed(roundOutput);
+	subStrats.erase(subStrats.begin());
+	subInputs.erase(subInputs.begin());
+}
+
 } // namespace mod::lib::DG::Strategies
\ No newline at end of file
@@ -3,6 +3,9 @@
 
 #include <mod/lib/DG/Strategies/Strategy.hpp>
 
+#include <memory>
+#include <vector>
+
 namespace mod::lib::DG::Strategies {
 
 struct Repeat : Strategy {
@@ -18,10 +21,21 @@ struct Repeat : Strategy {
 private:
 	virtual void setExecutionEnvImpl() override;
 	virtual void executeImpl(PrintSettings settings, const GraphState &input) override;
+	void foldFirstRound();
 private:
 	std::unique_ptr<Strategy> strat;
 	int limit;
+	// With getConfig().dg.repeatKeepOnlyLastRounds only the last two rounds are kept,
+	// each with its own copy of the input, and the earlier rounds are folded into
+	// summaries and a bitset of the graphs they consumed.
+	bool keepAllRounds = true;
+	std::vector<std::unique_ptr<GraphState>> subInputs; // nullptr for the first round
 	std::vector<std::unique_ptr<Strategy>> subStrats;
+	struct RoundSummary {
+		std::size_t subsetSize, universeSize;
+	};
+	std::vector<RoundSummary> foldedRounds;
+	std::vector<bool> foldedConsumed; // indexed by graph ID
 };
 
 } // namespace mod::lib::DG::Strategies
@@ -4,6 +4,8 @@
 #include <mod/Derivation.hpp>
 #include <mod/Misc.hpp>
 #include <mod/rule/Rule.hpp>
+#include <mod/lib/DG/DirectRuleApplication.hpp>
+#include <mod/lib/DG/ExecutionStats.hpp>
 #include <mod/lib/DG/RuleApplicationUtils.hpp>
 #include <mod/lib/DG/Strategies/GraphState.hpp>
 #include <mod/lib/IO/IO.hpp>
@@ -60,47 +62,49 @@ struct Context {
 	ExecutionEnv &executionEnv;
 	GraphState *output;
 	std::unordered_set<const lib::graph::Graph *> &consumedGraphs;
+	RuleStats *stats; // nullptr if no statistics are collected
 };
 
-void handleBoundRulePair(int verbosity, IO::Logger logger, Context context, const BoundRule &brp) {
-	assert(brp.rule);
-	// TODO: use a smart pointer so the rule for sure is deallocated, even though we do a 'continue'
-	const lib::rule::Rule &r = *brp.rule;
-	const auto &rDPO = r.getDPORule();
-	assert(r.isOnlyRightSide()); // otherwise, it should have been deallocated.
-	// All max component results should be only right side
+// makeProducts(checkIfNew, onDup) must return the wrapped products.
+template<typename MakeProducts>
+void handleDerivation(int verbosity, IO::Logger logger, Context context,
+                      const std::string &name, const std::vector<const lib::graph::Graph *> &educts,
+                      MakeProducts makeProducts) {
+	// the bindings are still enumerated, but no more products are made
+	if(context.executionEnv.doExit()) return;
 	mod::Derivation d;
 	d.r = context.r;
-	for(const lib::graph::Graph *g: brp.boundGraphs) d.left.push_back(g->getAPIReference());
+	for(const lib::graph::Graph *g: educts) d.left.push_back(g->getAPIReference());
 	{ // left predicate
 		bool result = context.executionEnv.checkLeftPredicate(d);
 		if(!result) {
+			if(context.stats) ++context.stats->numLeftPredicateRejections;
 			if(verbosity >= PrintSettings::V_DerivationPredicatesFail)
-				logger.indent() << "Skipping " << r.getName() << " due to leftPredicate" << std::endl;
+				logger.indent() << "Skipping " << name << " due to leftPredicate" << std::endl;
 			return;
 		}
 	}
-	if(verbosity >= PrintSettings::V_RuleApplication) {
-		logger.indent() << "Splitting " << r.getName() << " into "
-		                << get_num_connected_components(get_labelled_right(rDPO))
-		                << " graphs" << std::endl;
-		++logger.indentLevel;
+	{
+		StatsTimer timer(context.stats ? &context.stats->timeProducts : nullptr);
+		d.right = makeProducts(
+				[&context](std::unique_ptr<lib::graph::Graph> gCand) {
+					const lib::graph::Graph *gCandRaw = gCand.get();
+					auto g = context.executionEnv.checkIfNew(std::move(gCand));
+					if(context.stats) {
+						// a new graph is wrapped around the candidate itself
+						if(&g->getGraph() == gCandRaw) ++context.stats->numCheckIfNewMisses;
+						else ++context.stats->numCheckIfNewHits;
+					}
+					return g;
+				},
+				[verbosity, &logger](std::shared_ptr<mod::graph::Graph> gWrapped,
+				                     std::shared_ptr<mod::graph::Graph> gPrev) {
+					if(verbosity >= PrintSettings::V_RuleApplication)
+						logger.indent() << "Discarding product " << gWrapped->getName()
+						                << ", isomorphic to other product " << gPrev->getName()
+						                << "." << std::endl;
+				});
 	}
-	const std::vector<const lib::graph::Graph *> &educts = brp.boundGraphs;
-	d.right = splitRule(
-			rDPO, context.executionEnv.labelSettings.type, context.executionEnv.labelSettings.withStereo,
-			[&context](std::unique_ptr<lib::graph::Graph> gCand) {
-				return context.executionEnv.checkIfNew(std::move(gCand));
-			},
-			[verbosity, &logger](std::shared_ptr<mod::graph::Graph> gWrapped, std::shared_ptr<mod::graph::Graph> gPrev) {
-				if(verbosity >= PrintSettings::V_RuleApplication)
-					logger.indent() << "Discarding product " << gWrapped->getName()
-					                << ", isomorphic to other product " << gPrev->getName()
-					                << "." << std::endl;
-			}
-	);
-	if(verbosity >= PrintSettings::V_RuleApplication)
-		--logger.indentLevel;
 	if(d.right.empty()) {
 		if(verbosity >= V_RuleApplication)
 			logger.indent(1) << "Discarding derivation, empty result." << std::endl;
@@ -110,11 +114,13 @@ void handleBoundRulePair(int verbosity, IO::Logger logger, Context context, cons
 	{ // right predicates
 		bool result = context.executionEnv.checkRightPredicate(d);
 		if(!result) {
+			if(context.stats) ++context.stats->numRightPredicateRejections;
 			if(verbosity >= PrintSettings::V_DerivationPredicatesFail)
-				logger.indent() << "Skipping " << r.getName() << " due to rightPredicate" << std::endl;
+				logger.indent() << "Skipping " << name << " due to rightPredicate" << std::endl;
 			return;
 		}
 	}
+	if(context.stats) ++context.stats->numDerivations;
 	{ // now the derivation is good, so add the products to output
 		if(getConfig().dg.putAllProductsInSubset) {
 			for(const auto &g: d.right)
@@ -139,6 +145,47 @@ void handleBoundRulePair(int verbosity, IO::Logger logger, Context context, cons
 	}
 }
 
+void handleBoundRulePair(int verbosity, IO::Logger logger, Context context, const BoundRule &brp) {
+	assert(brp.rule);
+	const lib::rule::Rule &r = *brp.rule;
+	const auto &rDPO = r.getDPORule();
+	assert(r.isOnlyRightSide()); // otherwise, it should have been deallocated.
+	// All max component results should be only right side
+	handleDerivation(verbosity, logger, context, r.getName(), brp.boundGraphs,
+	                 [&](auto checkIfNew, auto onDup) {
+		                 if(verbosity >= PrintSettings::V_RuleApplication) {
+			                 logger.indent() << "Splitting " << r.getName() << " into "
+			                                 << get_num_connected_components(get_labelled_right(rDPO))
+			                                 << " graphs" << std::endl;
+			                 ++logger.indentLevel;
+		                 }
+		                 auto right = splitRule(rDPO, context.executionEnv.labelSettings.type,
+		                                        context.executionEnv.labelSettings.withStereo, checkIfNew, onDup);
+		                 if(verbosity >= PrintSettings::V_RuleApplication)
+			                 --logger.indentLevel;
+		                 return right;
+	                 });
+}
+
+void handleDirectBinding(int verbosity, IO::Logger logger, Context context,
+                         const DirectRuleApplier &applier, const DirectBinding &b) {
+	assert(b.isComplete());
+	const auto &name = applier.getRule().getName();
+	handleDerivation(verbosity, logger, context, name, b.boundGraphs,
+	                 [&](auto checkIfNew, auto onDup) {
+		                 auto products = applier.makeProducts(b);
+		                 if(verbosity >= PrintSettings::V_RuleApplication) {
+			                 logger.indent() << "Constructed " << products.size() << " graphs from "
+			                                 << name << " " << b << std::endl;
+			                 ++logger.indentLevel;
+		                 }
+		                 auto right = wrapProducts(std::move(products), LabelType::String, false, checkIfNew, onDup);
+		                 if(verbosity >= PrintSettings::V_RuleApplication)
+			                 --logger.indentLevel;
+		                 return right;
+	                 });
+}
+
 template<typename GraphRange>
 unsigned int bindGraphs(PrintSettings settings, Context context,
                         const GraphRange &graphRange,
@@ -243,9 +290,31 @@ void Rule::executeImpl(PrintSettings settings, const GraphState &input) {
 	}
 	assert(subsetEnd - graphs.begin() == subset.size());
 
-	Context context{r, getExecutionEnv(), output, consumedGraphs};
+	RuleStatsScope statsScope(getExecutionEnv().stats, *rRaw);
+	Context context{r, getExecutionEnv(), output, consumedGraphs, statsScope.get()};
+	const auto numComponents = get_num_connected_components(get_labelled_left(rRaw->getDPORule()));
+	if(canApplyDirectly(*rRaw, getExecutionEnv().labelSettings)) {
+		DirectRuleApplier applier(*rRaw, getExecutionEnv().graphAsRuleCache, getExecutionEnv().componentMatchCache,
+		                          getExecutionEnv().labelSettings);
+		std::vector<DirectBinding> inputBindings{applier.makeInitial()};
+		for(int round = 0; round != numComponents; ++round) {
+			const auto numGraphs = round == 0 ? subset.size() : graphs.size();
+			const auto onOutput = [verbosity = settings.verbosity, context, &applier]
+					(IO::Logger logger, const DirectBinding &b) -> bool {
+				if(b.isComplete())
+					handleDirectBinding(verbosity, logger, context, applier, b);
+				return true;
+			};
+			inputBindings = applier.bindGraphs(
+					settings.ruleApplicationVerbosity(), settings,
+					round, graphs, numGraphs, inputBindings,
+					getExecutionEnv().doRuleIsomorphism, context.stats, onOutput);
+		}
+		assert(inputBindings.empty());
+		return;
+	}
 	std::vector<BoundRule> inputRules{{rRaw, {}, 0}};
-	for(int round = 0; round != get_num_connected_components(get_labelled_left(rRaw->getDPORule())); ++round) {
+	for(int round = 0; round != numComponents; ++round) {
 		const auto firstGraph = graphs.begin();
 		const auto lastGraph = round == 0 ? subsetEnd : graphs.end();
 
@@ -264,6 +333,7 @@ void Rule::executeImpl(PrintSettings settings, const GraphState &input) {
 				getExecutionEnv().graphAsRuleCache,
 				getExecutionEnv().labelSettings,
 				getExecutionEnv().doRuleIsomorphism,
+				context.stats,
 				onOutput);
 		if(round != 0) {
 			// in round 0 the inputRules is the actual original input rule, so don't delete it
@@ -9,18 +9,27 @@
 #include <iosfwd>
 #include <vector>
 
+namespace mod::lib::DG {
+struct ComponentMatchCache;
+struct ExecutionStats;
+} // namespace mod::lib::DG
 namespace mod::lib::DG::Strategies {
 class GraphState;
 
 struct ExecutionEnv {
-	ExecutionEnv(LabelSettings labelSettings, bool doRuleIsomorphism, rule::GraphAsRuleCache &graphAsRuleCache)
-			: labelSettings(labelSettings), doRuleIsomorphism(doRuleIsomorphism), graphAsRuleCache(graphAsRuleCache) {}
+	ExecutionEnv(LabelSettings labelSettings, bool doRuleIsomorphism, rule::GraphAsRuleCache &graphAsRuleCache,
+	             ComponentMatchCache &componentMatchCache, ExecutionStats *stats)
+			: labelSettings(labelSettings), doRuleIsomorphism(doRuleIsomorphism), graphAsRuleCache(graphAsRuleCache),
+			  componentMatchCache(componentMatchCache), stats(stats) {}
 	virtual ~ExecutionEnv() {};
 	// May throw LogicError if exists.
 	virtual void tryAddGraph(std::shared_ptr<mod::graph::Graph> g) = 0;
 	virtual bool trustAddGraph(std::shared_ptr<mod::graph::Graph> g) = 0;
 	virtual bool trustAddGraphAsVertex(std::shared_ptr<mod::graph::Graph> g) = 0;
 	virtual bool doExit() const = 0;
+	// After this, doExit() is true for the rest of the execution,
+	// so the remaining rule applications are skipped.
+	virtual void requestExit() = 0;
 	// the right side is always empty
 	virtual bool checkLeftPredicate(const mod::Derivation &d) const = 0;
 	// but here everything is defined
@@ -39,6 +48,8 @@ public:
 	const LabelSettings labelSettings;
 	const bool doRuleIsomorphism;
 	rule::GraphAsRuleCache &graphAsRuleCache;
+	ComponentMatchCache &componentMatchCache;
+	ExecutionStats *const stats; // nullptr if no statistics are collected
 };
 
 struct PrintSettings : IO::Logger {
@@ -55,6 +66,8 @@ public: // constants for verbosity 'levels'
 	static constexpr int
 			V_Repeat = 2,
 			V_RepeatBreak = 4,
+			V_BestFirst = V_Repeat,
+			V_BestFirstExpansion = V_RepeatBreak,
 			V_Sequence = V_RepeatBreak,
 			V_Revive = V_RepeatBreak,
 			V_Parallel = V_RepeatBreak,
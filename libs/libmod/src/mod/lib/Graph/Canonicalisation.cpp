@@ -1,7 +1,12 @@
 #include "Canonicalisation.hpp"
 
+#include <mod/Error.hpp>
+#include <mod/lib/GraphMorphism/LabelledMorphism.hpp>
 #include <mod/lib/Graph/Properties/Molecule.hpp>
+#include <mod/lib/Graph/Properties/Stereo.hpp>
 #include <mod/lib/Graph/Properties/String.hpp>
+#include <mod/lib/Graph/Properties/Term.hpp>
+#include <mod/lib/StringStore.hpp>
 
 #include <graph_canon/aut/implicit_size_2.hpp>
 #include <graph_canon/aut/pruner_basic.hpp>
@@ -22,9 +27,12 @@
 #include <perm_group/permutation/built_in.hpp>
 
 #include <jla_boost/graph/PairToRangeAdaptor.hpp>
+#include <jla_boost/graph/morphism/models/InvertibleVector.hpp>
 
 #include <boost/graph/graph_utility.hpp> // for boost::print_graph
 
+#include <algorithm>
+#include <numeric>
 #include <vector>
 
 namespace mod::lib::graph {
@@ -531,10 +539,9 @@ private:
 	const LabelledGraph &lg;
 };
 
-template<typename EdgeHandler>
-auto getCanonForm(const Graph &g, EdgeHandler eHandler, LabelType labelType, bool withStereo) {
+template<typename EdgeHandler, typename VertexLess>
+auto canonicalise(const GraphType &graph, EdgeHandler eHandler, VertexLess vLess) {
 	auto can = graph_canon::canonicalizer<int, EdgeHandler, false, false>(eHandler);
-	const auto &graph = get_graph(g.getLabelledGraph());
 	const auto idx = get(boost::vertex_index_t(), graph);
 	const auto vis = graph_canon::make_visitor(
 			graph_canon::traversal_bfs_exp(), graph_canon::target_cell_flm(), graph_canon::refine_WL_1(),
@@ -543,13 +550,7 @@ auto getCanonForm(const Graph &g, EdgeHandler eHandler, LabelType labelType, boo
 			//			, debug_visitor(g.getLabelledGraph())
 			, graph_canon::stats_visitor()
 	);
-	const auto &str = get_string(g.getLabelledGraph());
-	const auto vLess = [&str](Vertex a, Vertex b) {
-		return str[a] < str[b];
-	};
-
 	auto res = can(graph, idx, vLess, vis);
-	std::vector<int> perm = std::move(res.first);
 	const auto &stats = get(graph_canon::stats_visitor::result_t(), res.second);
 	if(getConfig().canon.printStats) {
 		//		std::ofstream tree("tree.dot");
@@ -559,41 +560,199 @@ auto getCanonForm(const Graph &g, EdgeHandler eHandler, LabelType labelType, boo
 		//				eInv);
 		std::cout << stats;
 	}
+	return std::make_pair(std::move(res.first),
+	                      std::move(get(graph_canon::aut_pruner_basic::result_t(), res.second)));
+}
 
-	auto eLess = [&str](Edge lhs, Edge rhs) {
-		MOD_ABORT; // should never be called, as we don't have parallel edges or loops
-		return str[lhs] < str[rhs];
+// Ground terms are ordered by their structure, with the function symbols ordered by their strings,
+// so the order does not depend on the order the symbols were interned in.
+int compareTerms(const lib::Term::Wam &m1, lib::Term::Address a1, const lib::Term::Wam &m2, lib::Term::Address a2) {
+	a1 = m1.deref(a1);
+	a2 = m2.deref(a2);
+	const auto *c1 = &m1.getCell(a1);
+	const auto *c2 = &m2.getCell(a2);
+	if(c1->tag == lib::Term::Cell::Tag::STR) {
+		a1 = c1->STR.addr;
+		c1 = &m1.getCell(a1);
+	}
+	if(c2->tag == lib::Term::Cell::Tag::STR) {
+		a2 = c2->STR.addr;
+		c2 = &m2.getCell(a2);
+	}
+	assert(c1->tag == lib::Term::Cell::Tag::Structure); // only ground terms
+	assert(c2->tag == lib::Term::Cell::Tag::Structure);
+	if(c1->Structure.name != c2->Structure.name) {
+		const auto &strings = lib::Term::getStrings();
+		return strings.getString(c1->Structure.name).compare(strings.getString(c2->Structure.name));
+	}
+	if(c1->Structure.arity != c2->Structure.arity)
+		return c1->Structure.arity - c2->Structure.arity;
+	for(int i = 1; i <= c1->Structure.arity; ++i) {
+		const int c = compareTerms(m1, a1 + i, m2, a2 + i);
+		if(c != 0) return c;
+	}
+	return 0;
+}
+
+// The rank of each element in the total preorder given by cmp, i.e., equal elements get equal ranks.
+template<typename Compare>
+std::vector<int> rankBy(std::size_t n, Compare cmp) {
+	std::vector<std::size_t> order(n);
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&cmp](std::size_t a, std::size_t b) {
+		return cmp(a, b) < 0;
+	});
+	std::vector<int> rank(n);
+	int r = 0;
+	for(std::size_t i = 0; i != n; ++i) {
+		if(i != 0 && cmp(order[i - 1], order[i]) != 0) ++r;
+		rank[order[i]] = r;
+	}
+	return rank;
+}
+
+// Isomorphism invariant colours of the vertices and edges, from their labels and,
+// with stereo, their geometry, lone pairs, radical, and edge category.
+// The full stereo embeddings are checked when canonical forms are compared.
+std::pair<std::vector<int>, std::vector<int>> getColours(const LabelledGraph &lg, LabelType labelType, bool withStereo) {
+	const auto &g = get_graph(lg);
+	const auto &str = get_string(lg);
+	std::vector<Vertex> vs(num_vertices(g));
+	for(const auto v: asRange(vertices(g)))
+		vs[get(boost::vertex_index_t(), g, v)] = v;
+	std::vector<Edge> es(num_edges(g));
+	for(const auto e: asRange(edges(g)))
+		es[get(boost::edge_index_t(), g, e)] = e;
+
+	const auto labelCmp = [&](const auto a, const auto b) -> int {
+		if(labelType == LabelType::String) {
+			if(getLabelId(str, a) == getLabelId(str, b)) return 0;
+			return str[a].compare(str[b]);
+		} else {
+			const auto &term = get_term(lg);
+			return compareTerms(getMachine(term), {lib::Term::AddressType::Heap, term[a]},
+			                    getMachine(term), {lib::Term::AddressType::Heap, term[b]});
+		}
 	};
-	Graph::CanonIdxMap ordIdx(perm.begin(), idx);
-	auto form = std::make_unique<Graph::CanonForm>(graph, ordIdx, eLess);
-	auto autPtr = std::move(get(graph_canon::aut_pruner_basic::result_t(), res.second));
-	auto autPtrRes = std::make_unique<Graph::AutGroup>(autPtr->degree());
-	auto gens = autPtr->generators(); // skip the first, it should be the identity
-	for(const auto &p : asRange(++begin(gens), end(gens)))
-		autPtrRes->add_generator(p);
-	return std::make_tuple(std::move(perm), std::move(form), std::move(autPtrRes));
+	auto vColour = rankBy(vs.size(), [&](std::size_t a, std::size_t b) -> int {
+		const auto va = vs[a], vb = vs[b];
+		const int c = labelCmp(va, vb);
+		if(c != 0 || !withStereo) return c;
+		const auto &ca = *get_stereo(lg)[va];
+		const auto &cb = *get_stereo(lg)[vb];
+		if(ca.getGeometryVertex() != cb.getGeometryVertex())
+			return ca.getGeometryVertex() < cb.getGeometryVertex() ? -1 : 1;
+		if(ca.getNumLonePairs() != cb.getNumLonePairs())
+			return ca.getNumLonePairs() - cb.getNumLonePairs();
+		return static_cast<int>(ca.getHasRadical()) - static_cast<int>(cb.getHasRadical());
+	});
+	auto eColour = rankBy(es.size(), [&](std::size_t a, std::size_t b) -> int {
+		const auto ea = es[a], eb = es[b];
+		const int c = labelCmp(ea, eb);
+		if(c != 0 || !withStereo) return c;
+		return static_cast<int>(get_stereo(lg)[ea]) - static_cast<int>(get_stereo(lg)[eb]);
+	});
+	return {std::move(vColour), std::move(eColour)};
 }
 
 } // namespace
 
 std::tuple<std::vector<int>, std::unique_ptr<Graph::CanonForm>, std::unique_ptr<Graph::AutGroup> >
 getCanonForm(const Graph &g, LabelType labelType, bool withStereo) {
-	if(labelType != LabelType::String)
-		throw LogicError("Can only canonicalise with label type string.");
-	if(withStereo)
-		throw LogicError("Can not canonicalise stereo.");
-	const auto &mol = get_molecule(g.getLabelledGraph());
-	const auto es = edges(g.getGraph());
+	const auto &lg = g.getLabelledGraph();
+	const auto &graph = get_graph(lg);
+	const auto idx = get(boost::vertex_index_t(), graph);
+	const auto n = num_vertices(graph);
+	if(labelType == LabelType::Term) {
+		const auto &term = get_term(lg);
+		if(!isValid(term)) {
+			std::string msg = "Parsing failed for graph '" + g.getName() + "'. " + term.getParsingError();
+			throw TermParsingError(std::move(msg));
+		}
+		if(term.getHasVariables()) {
+			std::string msg = "Can not canonicalise term labels with variables.\n";
+			msg += "Graph is '" + g.getName() + "', with graphDFS: " + g.getGraphDFS().first;
+			throw LogicError(std::move(msg));
+		}
+	}
+
+	std::vector<int> perm;
+	std::vector<std::vector<int>> gens;
+	const auto &mol = get_molecule(lg);
+	const auto es = edges(graph);
 	const bool isMol = std::all_of(es.first, es.second, [&](const auto &e) {
 		return mol[e] != BondType::Invalid;
 	});
-	if(isMol) {
-		return getCanonForm(g, edge_handler_bond(g), labelType, withStereo);
+	if(labelType == LabelType::String && !withStereo && isMol) {
+		const auto &str = get_string(lg);
+		// equal labels are detected by their IDs, but the order must be by the strings
+		// so the canonical form does not depend on the order the labels were interned in
+		const auto vLess = [&str](Vertex a, Vertex b) {
+			if(getLabelId(str, a) == getLabelId(str, b)) return false;
+			return str[a] < str[b];
+		};
+		auto res = canonicalise(graph, edge_handler_bond(g), vLess);
+		perm = std::move(res.first);
+		for(const auto &p: res.second->generators()) {
+			gens.emplace_back(n);
+			for(std::size_t i = 0; i != n; ++i)
+				gens.back()[i] = perm_group::get(p, i);
+		}
 	} else {
-		std::string msg = "Can not canonicalise arbitrary edge labels.\n";
-		msg += "Graph is '" + g.getName() + "', with graphDFS: " + g.getGraphDFS().first;
-		throw LogicError(std::move(msg));
+		// Arbitrary edge labels are handled by subdividing each edge with a vertex carrying its colour,
+		// and canonicalising the subdivided graph with all edges equal.
+		// The original vertices come first, so restricting to them gives a canonical order
+		// and the automorphisms of the original graph.
+		const auto colours = getColours(lg, labelType, withStereo);
+		const auto &vColour = colours.first;
+		const auto &eColour = colours.second;
+		const auto m = num_edges(graph);
+		GraphType gSub;
+		for(std::size_t i = 0; i != n + m; ++i)
+			add_vertex(gSub);
+		for(const auto e: asRange(es)) {
+			const auto eId = get(boost::edge_index_t(), graph, e);
+			const auto vSub = vertex(n + eId, gSub);
+			add_edge(vertex(idx[source(e, graph)], gSub), vSub, gSub);
+			add_edge(vSub, vertex(idx[target(e, graph)], gSub), gSub);
+		}
+		const auto idxSub = get(boost::vertex_index_t(), gSub);
+		const auto colour = [&](Vertex v) {
+			const auto i = idxSub[v];
+			return i < n ? std::make_pair(0, vColour[i]) : std::make_pair(1, eColour[i - n]);
+		};
+		const auto vLess = [&colour](Vertex a, Vertex b) {
+			return colour(a) < colour(b);
+		};
+		auto res = canonicalise(gSub, graph_canon::edge_handler_all_equal(), vLess);
+		perm.resize(n);
+		std::vector<std::size_t> order(n);
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&res](std::size_t a, std::size_t b) {
+			return res.first[a] < res.first[b];
+		});
+		for(std::size_t i = 0; i != n; ++i)
+			perm[order[i]] = i;
+		for(const auto &p: res.second->generators()) {
+			gens.emplace_back(n);
+			for(std::size_t i = 0; i != n; ++i) {
+				const std::size_t img = perm_group::get(p, i);
+				assert(img < n);
+				gens.back()[i] = img;
+			}
+		}
 	}
+
+	auto eLess = [](Edge lhs, Edge rhs) -> bool {
+		MOD_ABORT; // should never be called, as we don't have parallel edges or loops
+	};
+	Graph::CanonIdxMap ordIdx(perm.begin(), idx);
+	auto form = std::make_unique<Graph::CanonForm>(graph, ordIdx, eLess);
+	auto autPtrRes = std::make_unique<Graph::AutGroup>(n);
+	// skip the first, it should be the identity
+	for(std::size_t i = 1; i < gens.size(); ++i)
+		autPtrRes->add_generator(gens[i]);
+	return std::make_tuple(std::move(perm), std::move(form), std::move(autPtrRes));
 }
 
 namespace {
@@ -671,23 +830,83 @@ PrintVisitor<LGraph, Graph, Idx> makePrintVisitor(const LGraph &lg1,
 bool canonicalCompare(const Graph &g1, const Graph &g2, LabelType labelType, bool withStereo) {
 	const auto &ord1 = g1.getCanonForm(labelType, withStereo);
 	const auto &ord2 = g2.getCanonForm(labelType, withStereo);
-	if(withStereo) throw LogicError("Can not currently compare canonical forms with stereo information.");
 	const auto &gl1 = g1.getLabelledGraph();
 	const auto &gl2 = g2.getLabelledGraph();
 	const auto visitor = graph_canon::graph_compare_null_visitor();
 	//	const auto visitor = makePrintVisitor(g1.getLabelledGraph(), g2.getLabelledGraph(), ord1, ord2, ord1.get_index_map(), ord2.get_index_map());
+	// the local stereo data is compared as part of the labels,
+	// and the embeddings are checked afterwards on the isomorphism given by the canonical orders
+	const auto stereoVertexEqual = [&gl1, &gl2, withStereo](Vertex v1, Vertex v2) {
+		if(!withStereo) return true;
+		const auto &c1 = *get_stereo(gl1)[v1];
+		const auto &c2 = *get_stereo(gl2)[v2];
+		return c1.getGeometryVertex() == c2.getGeometryVertex()
+		       && c1.getNumLonePairs() == c2.getNumLonePairs()
+		       && c1.getHasRadical() == c2.getHasRadical();
+	};
+	const auto stereoEdgeEqual = [&gl1, &gl2, withStereo](Edge e1, Edge e2) {
+		return !withStereo || get_stereo(gl1)[e1] == get_stereo(gl2)[e2];
+	};
+	bool equal = false;
 	switch(labelType) {
 	case LabelType::String:
-		return graph_canon::ordered_graph_equal(ord1, ord2,
-															 [&gl1, &gl2](Vertex v1, Vertex v2) -> bool {
-																 return get_string(gl1)[v1] == get_string(gl2)[v2];
-															 },
-															 [&gl1, &gl2](Edge e1, Edge e2) -> bool {
-																 return get_string(gl1)[e1] == get_string(gl2)[e2];
-															 }, visitor);
-	case LabelType::Term: throw LogicError("Can not currently compare canonical forms with term labels.");
-	}
-	MOD_ABORT;
+		equal = graph_canon::ordered_graph_equal(ord1, ord2,
+		                                         [&](Vertex v1, Vertex v2) -> bool {
+			                                         return getLabelId(get_string(gl1), v1) == getLabelId(get_string(gl2), v2)
+			                                                && stereoVertexEqual(v1, v2);
+		                                         },
+		                                         [&](Edge e1, Edge e2) -> bool {
+			                                         return getLabelId(get_string(gl1), e1) == getLabelId(get_string(gl2), e2)
+			                                                && stereoEdgeEqual(e1, e2);
+		                                         }, visitor);
+		break;
+	case LabelType::Term: {
+		const auto &t1 = get_term(gl1);
+		const auto &t2 = get_term(gl2);
+		const auto termEqual = [&t1, &t2](std::size_t a1, std::size_t a2) {
+			return compareTerms(getMachine(t1), {lib::Term::AddressType::Heap, a1},
+			                    getMachine(t2), {lib::Term::AddressType::Heap, a2}) == 0;
+		};
+		equal = graph_canon::ordered_graph_equal(ord1, ord2,
+		                                         [&](Vertex v1, Vertex v2) -> bool {
+			                                         return termEqual(t1[v1], t2[v2]) && stereoVertexEqual(v1, v2);
+		                                         },
+		                                         [&](Edge e1, Edge e2) -> bool {
+			                                         return termEqual(t1[e1], t2[e2]) && stereoEdgeEqual(e1, e2);
+		                                         }, visitor);
+		break;
+	}
+	}
+	if(!equal || !withStereo) return equal;
+
+	const auto &graph1 = get_graph(gl1);
+	const auto &graph2 = get_graph(gl2);
+	std::vector<Vertex> atPosition2(num_vertices(graph2));
+	for(const auto v2: asRange(vertices(graph2)))
+		atPosition2[get(ord2.get_index_map(), v2)] = v2;
+	jla_boost::GraphMorphism::InvertibleVectorVertexMap<GraphType, GraphType> m(graph1, graph2);
+	for(const auto v1: asRange(vertices(graph1)))
+		put(m, graph1, graph2, v1, atPosition2[get(ord1.get_index_map(), v1)]);
+	const auto ls = LabelSettings(labelType, LabelRelation::Isomorphism, true, LabelRelation::Isomorphism);
+	bool isStereoIso = false;
+	lib::GraphMorphism::matchSelectByLabelSettings(
+			gl1, gl2, std::move(m), ls,
+			[&isStereoIso](auto &&, const auto &, const auto &) {
+				isStereoIso = true;
+				return false;
+			});
+	if(isStereoIso) return true;
+	// The other isomorphisms are the ones composed with an automorphism,
+	// so if there are none, then the graphs are not isomorphic.
+	const auto &gens = g1.getAutGroup(labelType, withStereo).generators();
+	const auto n = num_vertices(graph1);
+	const bool onlyIdentity = std::all_of(gens.begin(), gens.end(), [n](const auto &p) {
+		for(std::size_t i = 0; i != n; ++i)
+			if(static_cast<std::size_t>(perm_group::get(p, i)) != i) return false;
+		return true;
+	});
+	if(onlyIdentity) return false;
+	return Graph::isomorphismVF2(g1, g2, 1, ls) != 0;
 }
 
 } // namespace mod::lib::graph
\ No newline at end of file
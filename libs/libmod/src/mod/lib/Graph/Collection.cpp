@@ -2,6 +2,10 @@
 
 #include <mod/Error.hpp>
 #include <mod/lib/Graph/Graph.hpp>
+#include <mod/lib/Graph/Properties/Molecule.hpp>
+#include <mod/lib/Graph/Properties/String.hpp>
+
+#include <iostream>
 
 namespace mod::lib::graph {
 namespace {
@@ -11,12 +15,13 @@ inline CollectionStats getStats(const lib::graph::Graph *g) {
 	return {num_vertices(graph), num_edges(graph)};
 }
 
-
 } // namespace
 
 struct Collection::Store {
-	bool trustInsert(const lib::graph::Graph *g) {
-		return graphs.insert(g).second;
+	bool trustInsert(const lib::graph::Graph *g, std::size_t invariant) {
+		const bool res = graphs.insert(g).second;
+		if(res) byInvariant[invariant].push_back(g);
+		return res;
 	}
 
 	auto end() const {
@@ -27,37 +32,34 @@ struct Collection::Store {
 		return graphs.find(g);
 	}
 
-	std::shared_ptr<mod::graph::Graph> findIsomorphic(const lib::graph::Graph *g, LabelSettings ls) const {
-		for(const auto &gCand : graphs) {
-			const bool iso = lib::graph::Graph::isomorphic(*g, *gCand, ls);
-			if(iso) return gCand->getAPIReference();
-			// if iso:
-			//			if(getConfig().dg.calculateDetailsVerbose) {
-			//				std::cout << "Discarding product " << gCand->getName() << ", isomorphic to " << g->getName() << std::endl;
-			//				std::cout << "\tLabelSettings: withStereo=" << std::boolalpha << this->labelSettings.withStereo << std::endl;
-			//				mod::postSection("Discarded");
-			//				mod::lib::IO::Graph::Write::Options opts, optsGraph;
-			//				opts.edgesAsBonds = opts.withIndex = true;
-			//				optsGraph.collapseHydrogens = optsGraph.edgesAsBonds = optsGraph.raiseCharges = true;
-			//				optsGraph.simpleCarbons = optsGraph.withColour = optsGraph.withIndex = true;
-			//				mod::lib::graph::IO::Write::summary(*gCand, optsGraph, optsGraph);
-			//				std::shared_ptr<mod::graph::Graph> gCandWrapped = graph::Graph::makeGraph(std::move(gCand));
-			//				for(auto v : gCandWrapped->vertices()) {
-			//					if(v.getStringLabel() == "C")
-			//						v.printStereo();
-			//				}
-			//			}
+	std::shared_ptr<mod::graph::Graph> findIsomorphic(const lib::graph::Graph *g, std::size_t invariant,
+	                                                  LabelSettings ls, CollectionIndexStats &stats) const {
+		const auto iter = byInvariant.find(invariant);
+		if(iter != byInvariant.end()) {
+			for(const auto *gCand: iter->second) {
+				const bool iso = lib::graph::Graph::isomorphic(*g, *gCand, ls);
+				if(iso) {
+					++stats.numHits;
+					return gCand->getAPIReference();
+				}
+				++stats.numCollisions;
+			}
 		}
+		++stats.numMisses;
 		return nullptr;
 	}
-
 private:
 	std::unordered_set<const lib::graph::Graph *> graphs;
+	std::unordered_map<std::size_t, std::vector<const lib::graph::Graph *>> byInvariant;
 };
 
 Collection::Collection(LabelSettings ls, Config::IsomorphismAlg alg)
 		: ls(ls.type, LabelRelation::Isomorphism,
-			  ls.withStereo, LabelRelation::Isomorphism) {}
+		     ls.withStereo, LabelRelation::Isomorphism),
+		  // canonical SMILES ignore stereo and non-string labels, and are only canonical with the right algorithm
+		  useSmilesInvariant(alg == Config::IsomorphismAlg::SmilesCanonVF2
+		                     && ls.type == LabelType::String && !ls.withStereo
+		                     && !getConfig().graph.useWrongSmilesCanonAlg) {}
 
 Collection::~Collection() = default;
 
@@ -78,33 +80,39 @@ std::shared_ptr<mod::graph::Graph> Collection::findIsomorphic(std::shared_ptr<mo
 	const auto *gLib = &g->getGraph();
 	const auto stats = getStats(gLib);
 	const auto iterStore = graphStore.find(stats);
-	if(iterStore == end(graphStore)) return nullptr;
+	if(iterStore == end(graphStore)) {
+		++indexStats.numMisses;
+		return nullptr;
+	}
 	const auto iterGraph = iterStore->second->find(gLib);
-	if(iterGraph != iterStore->second->end()) return g;
-	return iterStore->second->findIsomorphic(gLib, ls);
+	if(iterGraph != iterStore->second->end()) {
+		++indexStats.numHits;
+		return g;
+	}
+	return iterStore->second->findIsomorphic(gLib, getInvariant(gLib), ls, indexStats);
 }
 
 std::shared_ptr<mod::graph::Graph> Collection::findIsomorphic(lib::graph::Graph *g) const {
 	const auto stats = getStats(g);
 	const auto iterStore = graphStore.find(stats);
-	if(iterStore == end(graphStore)) return nullptr;
-	return iterStore->second->findIsomorphic(g, ls);
+	if(iterStore == end(graphStore)) {
+		++indexStats.numMisses;
+		return nullptr;
+	}
+	return iterStore->second->findIsomorphic(g, getInvariant(g), ls, indexStats);
 }
 
 bool Collection::trustInsert(std::shared_ptr<mod::graph::Graph> g) {
 	const auto *gLib = &g->getGraph();
 	const auto stats = getStats(gLib);
 	auto iterStore = graphStore.find(stats);
-	if(iterStore == end(graphStore)) {
+	if(iterStore == end(graphStore))
 		iterStore = graphStore.emplace(stats, std::make_unique<Store>()).first;
-		iterStore->second->trustInsert(gLib);
-		graphs.push_back(g);
-		return true;
-	} else {
-		const bool res = iterStore->second->trustInsert(gLib);
-		if(res) graphs.push_back(g);
-		return res;
-	}
+	else if(iterStore->second->find(gLib) != iterStore->second->end())
+		return false;
+	iterStore->second->trustInsert(gLib, getInvariant(gLib));
+	graphs.push_back(g);
+	return true;
 }
 
 std::pair<std::shared_ptr<mod::graph::Graph>, bool> Collection::tryInsert(std::shared_ptr<mod::graph::Graph> g) {
@@ -114,4 +122,31 @@ std::pair<std::shared_ptr<mod::graph::Graph>, bool> Collection::tryInsert(std::s
 	return {g, true};
 }
 
-} // namespace mod::lib::graph
\ No newline at end of file
+const CollectionIndexStats &Collection::getIndexStats() const {
+	return indexStats;
+}
+
+void Collection::printIndexStats(std::ostream &s) const {
+	s << "Graph database index (" << (useSmilesInvariant ? "SMILES" : "WL") << "):" << std::endl;
+	s << "numGraphs:     " << graphs.size() << std::endl;
+	s << "numBuckets:    " << graphStore.size() << std::endl;
+	s << "numHits:       " << indexStats.numHits << std::endl;
+	s << "numMisses:     " << indexStats.numMisses << std::endl;
+	s << "numCollisions: " << indexStats.numCollisions << std::endl;
+}
+
+std::size_t Collection::getInvariant(const lib::graph::Graph *g) const {
+	// only molecules have canonical SMILES, the rest are hashed by their labelled structure,
+	// and the two kinds are tagged so they can never be mixed up
+	if(useSmilesInvariant && get_molecule(g->getLabelledGraph()).getIsMolecule()) {
+		std::size_t res = 1;
+		boost::hash_combine(res, g->getSmiles(false));
+		return res;
+	} else {
+		std::size_t res = 2;
+		boost::hash_combine(res, g->getWLHash(ls.type));
+		return res;
+	}
+}
+
+} // namespace mod::lib::graph
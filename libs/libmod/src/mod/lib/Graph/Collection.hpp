@@ -4,8 +4,11 @@
 #include <mod/Config.hpp>
 #include <mod/graph/Graph.hpp>
 
+#include <atomic>
+#include <iosfwd>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <boost/functional/hash.hpp>
 
@@ -33,6 +36,21 @@ struct std::hash<mod::lib::graph::CollectionStats> {
 
 namespace mod::lib::graph {
 
+// Counters for the invariant index of a Collection.
+// A hit is a lookup where an isomorphic graph was found,
+// a miss is a lookup where none was found,
+// and a collision is a candidate with the same invariant which turned out not to be isomorphic.
+// The lookups are const, and may be done concurrently, so the counters are atomic.
+struct CollectionIndexStats {
+	std::atomic<std::size_t> numHits{0};
+	std::atomic<std::size_t> numMisses{0};
+	std::atomic<std::size_t> numCollisions{0};
+};
+
+// Graphs are first bucketed by (numVertices, numEdges) and then indexed by a strong isomorphism invariant:
+// the canonical SMILES string when the graph is a molecule and the label settings allow it,
+// and otherwise a Weisfeiler-Lehman colour refinement hash of the labelled graph.
+// A full isomorphism check is only done for graphs with the same invariant.
 struct Collection {
 	explicit Collection(LabelSettings ls, Config::IsomorphismAlg alg);
 	~Collection();
@@ -56,9 +74,16 @@ public:
 	// If inserted, return g, otherwise return an isomorphic graph.
 	// Note: if the same graph object is already present, the return value is <g, false>.
 	std::pair<std::shared_ptr<mod::graph::Graph>, bool> tryInsert(std::shared_ptr<mod::graph::Graph> g);
+public:
+	const CollectionIndexStats &getIndexStats() const;
+	void printIndexStats(std::ostream &s) const;
+private:
+	std::size_t getInvariant(const lib::graph::Graph *g) const;
 private:
 	struct Store;
 	const LabelSettings ls;
+	const bool useSmilesInvariant;
+	mutable CollectionIndexStats indexStats;
 	std::unordered_map<CollectionStats, std::unique_ptr<Store>> graphStore;
 	// owning part
 	std::vector<std::shared_ptr<mod::graph::Graph>> graphs;
@@ -4,6 +4,7 @@
 #include <mod/VertexMap.hpp>
 #include <mod/graph/Graph.hpp>
 #include <mod/graph/GraphInterface.hpp>
+#include <mod/lib/Algorithm/ParallelFor.hpp>
 #include <mod/lib/Chem/MoleculeUtil.hpp>
 #include <mod/lib/Chem/Smiles.hpp>
 #include <mod/lib/Graph/Canonicalisation.hpp>
@@ -14,8 +15,9 @@
 #include <mod/lib/Graph/Properties/Stereo.hpp>
 #include <mod/lib/Graph/Properties/String.hpp>
 #include <mod/lib/Graph/Properties/Term.hpp>
+#include <mod/lib/GraphMorphism/Invariant.hpp>
 #include <mod/lib/GraphMorphism/LabelledMorphism.hpp>
-#include <mod/lib/GraphMorphism/VF2Finder.hpp>
+#include <mod/lib/GraphMorphism/VF2PPFinder.hpp>
 #include <mod/lib/IO/IO.hpp>
 #include <mod/lib/LabelledGraph.hpp>
 #include <mod/lib/Random.hpp>
@@ -30,11 +32,14 @@
 #include <boost/graph/graph_traits.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <atomic>
+#include <mutex>
+
 namespace mod::lib::graph {
 BOOST_CONCEPT_ASSERT((LabelledGraphConcept<LabelledGraph>));
 
 namespace {
-std::size_t nextGraphNum = 0;
+std::atomic<std::size_t> nextGraphNum(0);
 
 const std::string getGraphName(unsigned int id) {
 	return "g_{" + boost::lexical_cast<std::string>(id) + "}";
@@ -94,6 +99,19 @@ Graph::Graph(std::unique_ptr<GraphType> g, std::unique_ptr<PropString> pString,
 	}
 }
 
+Graph::Graph(Graph &&other)
+		: g(std::move(other.g)), id(other.id), apiReference(std::move(other.apiReference)),
+		  name(std::move(other.name)),
+		  dfs(std::move(other.dfs)), dfsWithIds(std::move(other.dfsWithIds)),
+		  dfsHasNonSmilesRingClosure(other.dfsHasNonSmilesRingClosure),
+		  smiles(std::move(other.smiles)), smilesWithIds(std::move(other.smilesWithIds)),
+		  vertexOrder(std::move(other.vertexOrder)),
+		  canonData(std::move(other.canonData)),
+		  depictionData(std::move(other.depictionData)),
+		  fingerprint(std::move(other.fingerprint)),
+		  summary(std::move(other.summary)),
+		  wlHash(std::move(other.wlHash)) {}
+
 Graph::~Graph() {}
 
 const LabelledGraph &Graph::getLabelledGraph() const {
@@ -124,40 +142,47 @@ void Graph::setName(std::string name) {
 }
 
 const std::pair<const std::string &, bool> Graph::getGraphDFS() const {
-	if(!dfs) std::tie(dfs, dfsHasNonSmilesRingClosure) = Write::dfs(getLabelledGraph(), false);
+	std::call_once(dfsFlag, [this]() {
+		if(!dfs) std::tie(dfs, dfsHasNonSmilesRingClosure) = Write::dfs(getLabelledGraph(), false);
+	});
 	return std::pair<const std::string &, bool>(*dfs, dfsHasNonSmilesRingClosure);
 }
 
 const std::string &Graph::getGraphDFSWithIds() const {
-	if(!dfsWithIds) dfsWithIds = Write::dfs(getLabelledGraph(), true).first;
+	std::call_once(dfsWithIdsFlag, [this]() {
+		if(!dfsWithIds) dfsWithIds = Write::dfs(getLabelledGraph(), true).first;
+	});
 	return *dfsWithIds;
 }
 
 const std::string &Graph::getSmiles(bool withIds) const {
 	auto &res = withIds ? smilesWithIds : smiles;
-	if(res) return res->first;
-
-	auto innerRes = [this, withIds]() {
-		if(getConfig().graph.useWrongSmilesCanonAlg) {
-			return Chem::getSmiles(getGraph(), get_string(getLabelledGraph()), get_molecule(getLabelledGraph()),
-			                       nullptr, withIds);
+	// if the generation fails the flag is not set, so the next call will try again and throw again
+	std::call_once(withIds ? smilesWithIdsFlag : smilesFlag, [this, withIds, &res]() {
+		if(res) return;
+
+		auto innerRes = [this, withIds]() {
+			if(getConfig().graph.useWrongSmilesCanonAlg) {
+				return Chem::getSmiles(getGraph(), get_string(getLabelledGraph()), get_molecule(getLabelledGraph()),
+				                       nullptr, withIds);
+			} else {
+				getCanonForm(LabelType::String, false); // TODO: make the withStereo a parameter
+				return Chem::getSmiles(getGraph(), get_string(getLabelledGraph()), get_molecule(getLabelledGraph()),
+				                       &canonData[0].perm, withIds);
+			}
+		}();
+		if(innerRes) {
+			res = std::make_pair(std::move(innerRes->str), innerRes->isAbstract);
 		} else {
-			getCanonForm(LabelType::String, false); // TODO: make the withStereo a parameter
-			return Chem::getSmiles(getGraph(), get_string(getLabelledGraph()), get_molecule(getLabelledGraph()),
-			                       &canon_perm_string, withIds);
+			std::string text;
+			text += "Can not generate SMILES string of graph " + boost::lexical_cast<std::string>(getId()) +
+			        " with name '" + getName() + "'.\n";
+			text += innerRes.extractError();
+			text += "\nGraphDFS is\n\t" + getGraphDFS().first + "\n";
+			throw LogicError(std::move(text));
 		}
-	}();
-	if(innerRes) {
-		res = std::make_pair(std::move(innerRes->str), innerRes->isAbstract);
-		return res->first;
-	} else {
-		std::string text;
-		text += "Can not generate SMILES string of graph " + boost::lexical_cast<std::string>(getId()) +
-		        " with name '" + getName() + "'.\n";
-		text += innerRes.extractError();
-		text += "\nGraphDFS is\n\t" + getGraphDFS().first + "\n";
-		throw LogicError(std::move(text));
-	}
+	});
+	return res->first;
 }
 
 unsigned int Graph::getVertexLabelCount(const std::string &label) const {
@@ -181,15 +206,62 @@ unsigned int Graph::getEdgeLabelCount(const std::string &label) const {
 }
 
 Write::DepictionData &Graph::getDepictionData() {
-	if(!depictionData) depictionData.reset(new Write::DepictionData(getLabelledGraph()));
-	return *depictionData;
+	return const_cast<Write::DepictionData &>(static_cast<const Graph &>(*this).getDepictionData());
 }
 
 const Write::DepictionData &Graph::getDepictionData() const {
-	if(!depictionData) depictionData.reset(new Write::DepictionData(getLabelledGraph()));
+	std::call_once(depictionFlag, [this]() {
+		if(!depictionData) depictionData.reset(new Write::DepictionData(getLabelledGraph()));
+	});
 	return *depictionData;
 }
 
+const GraphMorphism::Fingerprint &Graph::getFingerprint() const {
+	std::call_once(fingerprintFlag, [this]() {
+		if(!fingerprint) fingerprint = GraphMorphism::makeFingerprint(getGraph(), getStringState());
+	});
+	return *fingerprint;
+}
+
+const Summary &Graph::getSummary() const {
+	std::call_once(summaryFlag, [this]() {
+		if(!summary) summary = makeSummary(g);
+	});
+	return *summary;
+}
+
+std::size_t Graph::getWLHash(LabelType labelType) const {
+	const int i = labelType == LabelType::Term ? 1 : 0;
+	std::call_once(wlHashFlags[i], [this, labelType, i]() {
+		if(wlHash[i]) return;
+		const auto &graph = getGraph();
+		switch(labelType) {
+		case LabelType::String: {
+			const auto &pString = get_string(g);
+			wlHash[i] = GraphMorphism::hashWL(graph, [&](const auto ve) {
+				return std::size_t(getLabelId(pString, ve));
+			});
+			return;
+		}
+		case LabelType::Term: {
+			const auto &pTerm = get_term(g);
+			// an invalid term can not be isomorphic to anything, so just use the structure
+			if(!isValid(pTerm)) {
+				wlHash[i] = GraphMorphism::hashWL(graph, [](const auto) { return std::size_t(0); });
+				return;
+			}
+			const auto &machine = getMachine(pTerm);
+			wlHash[i] = GraphMorphism::hashWL(graph, [&](const auto ve) {
+				return GraphMorphism::hashTermModuloRenaming(machine, {lib::Term::AddressType::Heap, pTerm[ve]});
+			});
+			return;
+		}
+		}
+		MOD_ABORT;
+	});
+	return *wlHash[i];
+}
+
 // Labelled Graph Interface
 //------------------------------------------------------------------------------
 
@@ -206,25 +278,23 @@ const PropMolecule &Graph::getMoleculeState() const {
 }
 
 const Graph::CanonForm &Graph::getCanonForm(LabelType labelType, bool withStereo) const {
-	if(labelType != LabelType::String)
-		throw LogicError("Can only canonicalise with label type string.");
-	// TODO: when Terms are supported, remember to check if the state is valid, else throw TermParsingError
-	if(withStereo)
-		throw LogicError("Can not canonicalise stereo.");
-	if(!canon_form_string) {
-		assert(!aut_group_string);
-		std::tie(canon_perm_string, canon_form_string, aut_group_string) = lib::graph::getCanonForm(*this, labelType,
-		                                                                                            withStereo);
-	}
-	assert(canon_form_string);
-	assert(aut_group_string);
-	return *canon_form_string;
+	const int i = (labelType == LabelType::Term ? 2 : 0) + (withStereo ? 1 : 0);
+	auto &data = canonData[i];
+	std::call_once(canonFlags[i], [this, labelType, withStereo, &data]() {
+		if(data.form) return;
+		assert(!data.autGroup);
+		std::tie(data.perm, data.form, data.autGroup) = lib::graph::getCanonForm(*this, labelType, withStereo);
+	});
+	assert(data.form);
+	assert(data.autGroup);
+	return *data.form;
 }
 
 const Graph::AutGroup &Graph::getAutGroup(LabelType labelType, bool withStereo) const {
 	getCanonForm(labelType, withStereo);
-	assert(aut_group_string);
-	return *aut_group_string;
+	const int i = (labelType == LabelType::Term ? 2 : 0) + (withStereo ? 1 : 0);
+	assert(canonData[i].autGroup);
+	return *canonData[i].autGroup;
 }
 
 //------------------------------------------------------------------------------
@@ -256,6 +326,22 @@ std::size_t morphismMax(const Graph &gDomain,
 	return mr.getNumHits();
 }
 
+// Whether isomorphism with the given label settings is equality of the labels and the stereo data,
+// and can therefore be decided by comparing canonical forms.
+bool canUseCanonForms(const Graph &g, LabelSettings labelSettings) {
+	if(labelSettings.withStereo && labelSettings.stereoRelation != LabelRelation::Isomorphism) return false;
+	if(labelSettings.type == LabelType::String) return true;
+	const auto &term = get_term(g.getLabelledGraph());
+	return isValid(term) && !term.getHasVariables();
+}
+
+// The counter is a plain setting, but the isomorphism checks may be done by multiple threads.
+void countIsomorphismCall() {
+	static std::mutex mtx;
+	std::scoped_lock lock(mtx);
+	++getConfig().graph.numIsomorphismCalls;
+}
+
 std::size_t isomorphismSmilesOrCanonOrVF2(const Graph &gDom, const Graph &gCodom, LabelSettings labelSettings) {
 	const auto &ggDom = gDom.getLabelledGraph();
 	const auto &ggCodom = gCodom.getLabelledGraph();
@@ -266,17 +352,8 @@ std::size_t isomorphismSmilesOrCanonOrVF2(const Graph &gDom, const Graph &gCodom
 		return gDom.getSmiles(false) == gCodom.getSmiles(false) ? 1 : 0;
 
 	// otherwise maybe we can still do canonical form comparison
-	if(!labelSettings.withStereo
-	   && get_molecule(ggDom).getHasOnlyChemicalBonds()
-	   && get_molecule(ggCodom).getHasOnlyChemicalBonds()) {
-		if(labelSettings.type == LabelType::String) {
-			return canonicalCompare(gDom, gCodom, labelSettings.type, false) ? 1 : 0;
-		} else {
-			assert(labelSettings.type == LabelType::Term);
-			if(!get_term(ggDom).getHasVariables() && !get_term(ggCodom).getHasVariables())
-				return canonicalCompare(gDom, gCodom, LabelType::String, false) ? 1 : 0;
-		}
-	}
+	if(canUseCanonForms(gDom, labelSettings) && canUseCanonForms(gCodom, labelSettings))
+		return canonicalCompare(gDom, gCodom, labelSettings.type, labelSettings.withStereo) ? 1 : 0;
 
 	// otherwise, we have no choice but to use VF2
 	return Graph::isomorphismVF2(gDom, gCodom, 1, labelSettings);
@@ -286,11 +363,11 @@ std::size_t isomorphismSmilesOrCanonOrVF2(const Graph &gDom, const Graph &gCodom
 
 std::size_t Graph::isomorphismVF2(const Graph &gDom, const Graph &gCodom, std::size_t maxNumMatches,
                                   LabelSettings labelSettings) {
-	return morphismMax(gDom, gCodom, maxNumMatches, labelSettings, GM_MOD::VF2Isomorphism());
+	return morphismMax(gDom, gCodom, maxNumMatches, labelSettings, GM_MOD::ConfiguredIsomorphism());
 }
 
 bool Graph::isomorphic(const Graph &gDom, const Graph &gCodom, LabelSettings labelSettings) {
-	++getConfig().graph.numIsomorphismCalls;
+	countIsomorphismCall();
 	const auto nDom = num_vertices(gDom.getGraph());
 	const auto nCodom = num_vertices(gCodom.getGraph());
 	if(nDom != nCodom) return false; // early bail-out
@@ -310,7 +387,7 @@ bool Graph::isomorphic(const Graph &gDom, const Graph &gCodom, LabelSettings lab
 
 std::size_t
 Graph::isomorphism(const Graph &gDom, const Graph &gCodom, std::size_t maxNumMatches, LabelSettings labelSettings) {
-	++getConfig().graph.numIsomorphismCalls;
+	countIsomorphismCall();
 	if(maxNumMatches == 1)
 		return isomorphic(gDom, gCodom, labelSettings) ? 1 : 0;
 	// this hax with name comparing is basically to make abstract derivation graphs
@@ -325,7 +402,10 @@ Graph::isomorphism(const Graph &gDom, const Graph &gCodom, std::size_t maxNumMat
 
 std::size_t
 Graph::monomorphism(const Graph &gDom, const Graph &gCodom, std::size_t maxNumMatches, LabelSettings labelSettings) {
-	return morphismMax(gDom, gCodom, maxNumMatches, labelSettings, GM_MOD::VF2Monomorphism());
+	if(getConfig().rc.useComponentFingerprints
+	   && !GM_MOD::mayHaveMonomorphism(gDom.getFingerprint(), gCodom.getFingerprint(), labelSettings.type))
+		return 0;
+	return morphismMax(gDom, gCodom, maxNumMatches, labelSettings, GM_MOD::ConfiguredMonomorphism());
 }
 
 namespace {
@@ -370,17 +450,49 @@ auto makeMorphismEnumerationCallback(const Graph &gDom, const Graph &gCodom,
 void Graph::enumerateIsomorphisms(const Graph &gDom, const Graph &gCodom,
                                   std::function<bool(VertexMap<mod::graph::Graph, mod::graph::Graph>)> callback,
                                   LabelSettings labelSettings) {
-	morphism(gDom, gCodom, labelSettings, GM_MOD::VF2Isomorphism(),
+	morphism(gDom, gCodom, labelSettings, GM_MOD::ConfiguredIsomorphism(),
 	         makeMorphismEnumerationCallback(gDom, gCodom, callback));
 }
 
 void Graph::enumerateMonomorphisms(const Graph &gDom, const Graph &gCodom,
                                    std::function<bool(VertexMap<mod::graph::Graph, mod::graph::Graph>)> callback,
                                    LabelSettings labelSettings) {
-	morphism(gDom, gCodom, labelSettings, GM_MOD::VF2Monomorphism(),
+	if(getConfig().rc.useComponentFingerprints
+	   && !GM_MOD::mayHaveMonomorphism(gDom.getFingerprint(), gCodom.getFingerprint(), labelSettings.type))
+		return;
+	morphism(gDom, gCodom, labelSettings, GM_MOD::ConfiguredMonomorphism(),
 	         makeMorphismEnumerationCallback(gDom, gCodom, callback));
 }
 
+void Graph::precomputeCanonForms(const std::vector<const Graph *> &graphs, LabelSettings labelSettings) {
+	// Stereo data and terms are computed lazily and serially, so only plain string labels are handled.
+	if(labelSettings.withStereo) return;
+	// only compute the form that isomorphic() will compare with the configured algorithm
+	const auto alg = getConfig().graph.isomorphismAlg;
+	switch(alg) {
+	case Config::IsomorphismAlg::VF2: return;
+	case Config::IsomorphismAlg::SmilesCanonVF2:
+		if(labelSettings.type != LabelType::String || getConfig().graph.useWrongSmilesCanonAlg) return;
+		break;
+	case Config::IsomorphismAlg::Canon:
+		if(labelSettings.type != LabelType::String || labelSettings.relation != LabelRelation::Isomorphism) return;
+		break;
+	}
+	lib::parallelFor(getConfig().common.numThreads, graphs.size(), [&](std::size_t i) {
+		const Graph &g = *graphs[i];
+		try {
+			if(alg == Config::IsomorphismAlg::SmilesCanonVF2) {
+				if(get_molecule(g.getLabelledGraph()).getIsMolecule())
+					g.getSmiles(false);
+			} else {
+				g.getCanonForm(LabelType::String, false);
+			}
+		} catch(const LogicError &) {
+			// leave it for the lazy computation to report
+		}
+	});
+}
+
 bool Graph::nameLess(const Graph *g1, const Graph *g2) {
 	if(g1->getName().size() != g2->getName().size())
 		return g1->getName().size() < g2->getName().size();
@@ -5,6 +5,8 @@
 #include <mod/graph/ForwardDecl.hpp>
 #include <mod/lib/Graph/GraphDecl.hpp>
 #include <mod/lib/Graph/LabelledGraph.hpp>
+#include <mod/lib/Graph/Summary.hpp>
+#include <mod/lib/GraphMorphism/Fingerprint.hpp>
 
 #include <graph_canon/ordered_graph.hpp>
 
@@ -12,7 +14,9 @@
 #include <perm_group/group/generated.hpp>
 #include <perm_group/permutation/built_in.hpp>
 
+#include <array>
 #include <iosfwd>
+#include <mutex>
 #include <optional>
 #include <string>
 
@@ -36,7 +40,9 @@ public:
 	// pStereo may be null
 	Graph(std::unique_ptr<GraphType> g, std::unique_ptr<PropString> pString, std::unique_ptr<PropStereo> pStereo);
 public:
-	Graph(Graph &&) = default;
+	// Only the caches are moved, the once-flags of the new graph are fresh,
+	// so g must not be used concurrently while being moved from.
+	Graph(Graph &&other);
 	~Graph();
 	const LabelledGraph &getLabelledGraph() const;
 	std::size_t getId() const;
@@ -51,11 +57,21 @@ public:
 	unsigned int getEdgeLabelCount(const std::string &label) const;
 	Write::DepictionData &getDepictionData();
 	const Write::DepictionData &getDepictionData() const;
+	// The summary used for rejecting monomorphisms from this graph before running VF2.
+	const GraphMorphism::Fingerprint &getFingerprint() const;
+	// The values used by the native graph predicates.
+	const Summary &getSummary() const;
+	// A Weisfeiler-Lehman hash of the labelled graph, i.e., isomorphic graphs have the same hash.
+	// Stereo information is ignored.
+	std::size_t getWLHash(LabelType labelType) const;
 public: // deprecated interface
 	const GraphType &getGraph() const;
 	const PropString &getStringState() const;
 	const PropMolecule &getMoleculeState() const;
 public:
+	// With term labels the graph must not have variables.
+	// With stereo, the form and group are of the graph where the vertices and edges are additionally
+	// labelled by their geometry, lone pairs, radical, and edge category, see canonicalCompare.
 	const CanonForm &getCanonForm(LabelType labelType, bool withStereo) const;
 	const AutGroup &getAutGroup(LabelType labelType, bool withStereo) const;
 private:
@@ -67,11 +83,30 @@ private:
 	mutable bool dfsHasNonSmilesRingClosure;
 	mutable std::optional<std::pair<std::string, bool>> smiles, smilesWithIds; // str x isAbstract
 	mutable std::unique_ptr<std::vector<Vertex>> vertexOrder;
-	mutable std::vector<int> canon_perm_string;
-	mutable std::unique_ptr<const CanonForm> canon_form_string;
-	mutable std::unique_ptr<const AutGroup> aut_group_string;
+	struct CanonData {
+		std::vector<int> perm;
+		std::unique_ptr<const CanonForm> form;
+		std::unique_ptr<const AutGroup> autGroup;
+	};
+	// for each label type, without and with stereo
+	mutable std::array<CanonData, 4> canonData;
+	mutable std::array<std::once_flag, 4> canonFlags;
 	mutable std::unique_ptr<Write::DepictionData> depictionData;
+	mutable std::optional<GraphMorphism::Fingerprint> fingerprint;
+	mutable std::optional<Summary> summary;
+	// for each label type
+	mutable std::array<std::optional<std::size_t>, 2> wlHash;
+	mutable std::array<std::once_flag, 2> wlHashFlags;
+	// each lazily computed cache is initialised under its own flag,
+	// so concurrent readers block until the first one has published it
+	mutable std::once_flag dfsFlag, dfsWithIdsFlag, smilesFlag, smilesWithIdsFlag, depictionFlag, fingerprintFlag,
+			summaryFlag;
 public:
+	// Compute the canonical SMILES strings or canonical forms used by isomorphic() with the given label settings
+	// and getConfig().graph.isomorphismAlg, for all the graphs, distributed over getConfig().common.numThreads threads.
+	// Nothing is computed when the algorithm does not compare such forms.
+	// Graphs where the computation fails are skipped, and will fail again when the data is requested.
+	static void precomputeCanonForms(const std::vector<const Graph *> &graphs, LabelSettings labelSettings);
 	static std::size_t
 	isomorphismVF2(const Graph &gDom, const Graph &gCodom, std::size_t maxNumMatches, LabelSettings labelSettings);
 	static bool isomorphic(const Graph &gDom, const Graph &gCodom, LabelSettings labelSettings);
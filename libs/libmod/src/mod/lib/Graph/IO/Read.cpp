@@ -510,6 +510,51 @@ Result<std::vector<Data>> dfs(lib::IO::Warnings &warnings, std::string_view src)
 	return std::move(datas); // TODO: remove std::move when C++20/P1825R0 is available
 }
 
+namespace {
+
+// Returns the line, without the line break, and removes it from src.
+std::string_view popLine(std::string_view &src) {
+	const auto end = src.find('\n');
+	auto line = src.substr(0, end);
+	src.remove_prefix(end == std::string_view::npos ? src.size() : end + 1);
+	if(!line.empty() && line.back() == '\r') line.remove_suffix(1);
+	return line;
+}
+
+bool isBlank(std::string_view line) {
+	return line.find_first_not_of(" \t\r") == std::string_view::npos;
+}
+
+} // namespace
+
+std::vector<Record> splitLines(std::string_view src) {
+	std::vector<Record> res;
+	for(int lineNum = 1; !src.empty(); ++lineNum) {
+		const auto line = popLine(src);
+		if(!isBlank(line)) res.push_back({line, lineNum});
+	}
+	return res;
+}
+
+std::vector<Record> splitSDRecords(std::string_view src) {
+	std::vector<Record> res;
+	const char *first = src.data();
+	int firstLine = 1;
+	bool blank = true;
+	for(int lineNum = 1; !src.empty(); ++lineNum) {
+		const auto line = popLine(src);
+		blank = blank && isBlank(line);
+		if(line == "$$$$") {
+			res.push_back({std::string_view(first, src.data() - first), firstLine});
+			first = src.data();
+			firstLine = lineNum + 1;
+			blank = true;
+		}
+	}
+	if(!blank) res.push_back({std::string_view(first, src.data() - first), firstLine});
+	return res;
+}
+
 Result<std::vector<Data>> smiles(lib::IO::Warnings &warnings, std::string_view src, bool printStereoWarnings,
                                  bool allowAbstract, SmilesClassPolicy classPolicy) {
 	return lib::Chem::readSmiles(warnings, printStereoWarnings, src, allowAbstract, classPolicy);
@@ -8,6 +8,7 @@
 #include <ostream>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace mod {
 enum class SmilesClassPolicy;
@@ -39,6 +40,19 @@ struct RXNFileData {
 	// std::vector<std::vector<std::pair<int, int>>> aamap;
 };
 
+// A part of a larger input that can be parsed independently,
+// e.g., a line of a SMILES file or a MOL entry of an SD file.
+struct Record {
+	std::string_view src;
+	int firstLine; // 1-based
+};
+
+// Each non-blank line is a record.
+std::vector<Record> splitLines(std::string_view src);
+// Each record ends with a '$$$$' line, except possibly the last one.
+// Trailing blank lines are not a record.
+std::vector<Record> splitSDRecords(std::string_view src);
+
 lib::IO::Result<std::vector<Data>> gml(lib::IO::Warnings &warnings, std::string_view src, bool printStereoWarnings);
 lib::IO::Result<std::vector<Data>> dfs(lib::IO::Warnings &warnings, std::string_view src);
 lib::IO::Result<std::vector<Data>>
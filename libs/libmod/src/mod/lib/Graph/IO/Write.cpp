@@ -21,10 +21,16 @@
 #include <cassert>
 #include <iostream>
 #include <map>
+#include <mutex>
+#include <sstream>
 
 namespace mod::lib::graph::Write {
 namespace {
 
+// Guards the caches of the files written so far.
+// The depictions are built from each other, so the same thread may lock it several times.
+std::recursive_mutex cacheMutex;
+
 // returns the filename _without_ extension
 
 std::string getFilePrefix(const std::size_t gId) {
@@ -63,6 +69,7 @@ void gml(const LabelledGraph &gLabelled, const DepictionData &depict, const std:
 
 std::string gml(const Graph &g, bool withCoords) {
 	static std::map<std::pair<std::size_t, bool>, std::string> cache;
+	std::scoped_lock lock(cacheMutex);
 	const auto iter = cache.find({g.getId(), withCoords});
 	if(iter != end(cache)) return iter->second;
 
@@ -365,11 +372,11 @@ public:
 
 std::string dot(const LabelledGraph &gLabelled, const std::size_t gId, const Options &options) {
 	static std::map<DotCacheEntry, std::string> cache;
+	std::scoped_lock lock(cacheMutex);
 	const auto iter = cache.find({gId, options.graphvizPrefix});
 	if(iter != end(cache)) return iter->second;
 
-	// use _gv suffix so a coord file will not clash with non-gv coord files
-	post::FileHandle s(getFilePrefix(gId) + "_gv.dot");
+	std::ostringstream s;
 	const auto &g = get_graph(gLabelled);
 	const auto &pString = get_string(gLabelled);
 	s << "graph G {\n";
@@ -397,8 +404,11 @@ std::string dot(const LabelledGraph &gLabelled, const std::size_t gId, const Opt
 		}
 	}
 	s << "}\n";
-	cache[{gId, options.graphvizPrefix}] = s;
-	return s;
+	// use _gv suffix so a coord file will not clash with non-gv coord files
+	// identical dot files are shared, and with them the coordinates computed from them
+	std::string file = lib::IO::writeDeduplicated(getFilePrefix(gId) + "_gv.dot", s.str());
+	cache[{gId, options.graphvizPrefix}] = file;
+	return file;
 }
 
 namespace {
@@ -419,6 +429,7 @@ public:
 
 std::string coords(const LabelledGraph &gLabelled, const DepictionData &depict,
                    const std::size_t gId, const Options &options) {
+	std::scoped_lock lock(cacheMutex);
 	if(options.withGraphvizCoords || !depict.getHasCoordinates()) {
 		// we map 1-to-1 a dot file to a coord file, so cache by the dot filename
 		static std::map<std::string, std::string> cache;
@@ -444,7 +455,7 @@ std::string coords(const LabelledGraph &gLabelled, const DepictionData &depict,
 		if(options.collapseHydrogens) f += "_mol";
 		if(options.rotation != 0) f += "_r" + std::to_string(options.rotation);
 		if(options.mirror) f += "_m" + std::to_string(options.mirror);
-		post::FileHandle s(f + "_coord.tex");
+		std::ostringstream s;
 		s << "% dummy\n";
 		for(const auto v: asRange(vertices(g))) {
 			const auto vId = get(boost::vertex_index_t(), g, v);
@@ -460,7 +471,7 @@ std::string coords(const LabelledGraph &gLabelled, const DepictionData &depict,
 			s << "\\coordinate[overlay] (\\modIdPrefix v-coord-" << vId << ") at ("
 			  << std::fixed << x << ", " << y << ") {};\n";
 		}
-		std::string file = s;
+		std::string file = lib::IO::writeDeduplicated(f + "_coord.tex", s.str());
 		cache[{gId, options.collapseHydrogens, options.rotation, options.mirror}] = file;
 		return file;
 	}
@@ -488,6 +499,7 @@ tikz(const LabelledGraph &gLabelled, const DepictionData &depict, const std::siz
      const Options &options,
      bool asInline, const std::string &idPrefix) {
 	static std::map<TikzCacheEntry, std::string> cache;
+	std::scoped_lock lock(cacheMutex);
 
 	std::string strOptions = options.getStringEncoding();
 	std::string fileCoordsExt = coords(gLabelled, depict, gId, options);
@@ -498,8 +510,10 @@ tikz(const LabelledGraph &gLabelled, const DepictionData &depict, const std::siz
 	std::string file = getFilePrefix(gId) + "_" + strOptions;
 	if(asInline) file += "i";
 	file += ".tex";
-	post::FileHandle s(file);
+	std::ostringstream s;
 	tikz(s, options, get_graph(gLabelled), depict, fileCoordsExt, asInline, idPrefix);
+	// with shared coordinates, identical figures get the same file, and thus only a single PDF
+	file = lib::IO::writeDeduplicated(file, s.str());
 
 	cache[{gId, fileCoordsExt, strOptions, asInline, idPrefix}] = file;
 	return std::pair(file, fileCoordsExt);
@@ -508,6 +522,7 @@ tikz(const LabelledGraph &gLabelled, const DepictionData &depict, const std::siz
 std::string
 pdf(const LabelledGraph &gLabelled, const DepictionData &depict, const std::size_t gId,
     const Options &options) {
+	std::scoped_lock lock(cacheMutex);
 	{ // user-specified depiction
 		static std::map<std::size_t, std::string> userCache;
 		auto iter = userCache.find(gId);
@@ -547,6 +562,7 @@ std::string svg(const LabelledGraph &gLabelled, const DepictionData &depict, con
                 const Options &options) {
 	// maps 1-to-1 a PDF to an SVG
 	static std::map<std::string, std::string> cache;
+	std::scoped_lock lock(cacheMutex);
 
 	std::string pdfFile = pdf(gLabelled, depict, gId, options);
 
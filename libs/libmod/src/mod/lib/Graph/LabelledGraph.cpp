@@ -52,13 +52,19 @@ const LabelledGraph::PropStringType &get_string(const LabelledGraph &g) {
 
 LabelledGraph::PropTermType &get_term(LabelledGraph &g) {
 	assert(g.pString || g.pTerm);
-	if(!g.pTerm) g.pTerm.reset(new LabelledGraph::PropTermType(get_graph(g), get_string(g), lib::Term::getStrings()));
+	std::call_once(g.termFlag, [&g]() {
+		if(!g.pTerm)
+			g.pTerm.reset(new LabelledGraph::PropTermType(get_graph(g), get_string(g), lib::Term::getStrings()));
+	});
 	return *g.pTerm;
 }
 
 const LabelledGraph::PropTermType &get_term(const LabelledGraph &g) {
 	assert(g.pString || g.pTerm);
-	if(!g.pTerm) g.pTerm.reset(new LabelledGraph::PropTermType(get_graph(g), get_string(g), lib::Term::getStrings()));
+	std::call_once(g.termFlag, [&g]() {
+		if(!g.pTerm)
+			g.pTerm.reset(new LabelledGraph::PropTermType(get_graph(g), get_string(g), lib::Term::getStrings()));
+	});
 	return *g.pTerm;
 }
 
@@ -67,7 +73,9 @@ bool has_stereo(const LabelledGraph &g) {
 }
 
 const LabelledGraph::PropStereoType &get_stereo(const LabelledGraph &g) {
-	if(!has_stereo(g)) {
+	// if the deduction fails the flag is not set, so the next call will throw again
+	std::call_once(g.stereoFlag, [&g]() {
+		if(has_stereo(g)) return;
 		auto inference = lib::Stereo::Inference(get_graph(g), get_molecule(g), false);
 		lib::IO::Warnings warnings;
 		const bool printWarnings = true;
@@ -77,23 +85,22 @@ const LabelledGraph::PropStereoType &get_stereo(const LabelledGraph &g) {
 		std::cout << warnings;
 		result.throwIfError<StereoDeductionError>();
 		g.pStereo.reset(new PropStereo(get_graph(g), std::move(inference)));
-	}
+	});
 	return *g.pStereo;
 }
 
 const LabelledGraph::PropMoleculeType &get_molecule(const LabelledGraph &g) {
-	// this makes some GCC versions generate better code than having the unlikely branch in the if
-	if(g.pMolecule)
-		return *g.pMolecule;
-	g.pMolecule.reset(new LabelledGraph::PropMoleculeType(get_graph(g), get_string(g)));
+	std::call_once(g.moleculeFlag, [&g]() {
+		g.pMolecule.reset(new LabelledGraph::PropMoleculeType(get_graph(g), get_string(g)));
+	});
 	return *g.pMolecule;
 }
 
 const std::vector<typename boost::graph_traits<GraphType>::vertex_descriptor> &
 get_vertex_order(const LabelledGraph &g) {
-	if(g.vertex_order.empty()) {
+	std::call_once(g.vertexOrderFlag, [&g]() {
 		g.vertex_order = get_vertex_order(mod::lib::GraphMorphism::DefaultFinderArgsProvider(), get_graph(g));
-	}
+	});
 	return g.vertex_order;
 }
 
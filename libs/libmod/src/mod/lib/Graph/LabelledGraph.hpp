@@ -3,6 +3,8 @@
 
 #include <mod/lib/Graph/GraphDecl.hpp>
 
+#include <mutex>
+
 namespace mod::lib::graph {
 struct PropMolecule;
 struct PropStereo;
@@ -43,6 +45,8 @@ private: // views
 	mutable std::unique_ptr<PropMoleculeType> pMolecule;
 private: // optimisation
 	mutable std::vector<typename boost::graph_traits<GraphType>::vertex_descriptor> vertex_order;
+private: // guards for the lazily computed members above
+	mutable std::once_flag termFlag, stereoFlag, moleculeFlag, vertexOrderFlag;
 };
 
 } // namespace mod::lib::graph
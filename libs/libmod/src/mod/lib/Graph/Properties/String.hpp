@@ -2,6 +2,7 @@
 #define MOD_LIB_GRAPH_PROP_LABEL_HPP
 
 #include <mod/lib/Graph/Properties/Property.hpp>
+#include <mod/lib/StringStore.hpp>
 
 namespace mod::lib::graph {
 
@@ -12,9 +13,33 @@ public:
 		Base::verify(&g);
 	}
 
-	PropString(const PropString &other, const GraphType &g) : Base(other, g) {
+	PropString(const PropString &other, const GraphType &g)
+			: Base(other, g), vertexIds(other.vertexIds), edgeIds(other.edgeIds) {
 		Base::verify(&g);
 	}
+
+	void addVertex(Vertex v, const std::string &label) {
+		Base::addVertex(v, label);
+		vertexIds.push_back(internLabel(label));
+	}
+
+	void addEdge(Edge e, const std::string &label) {
+		Base::addEdge(e, label);
+		edgeIds.push_back(internLabel(label));
+	}
+
+	// The index of the label in getLabelStrings().
+	friend LabelId getLabelId(const PropString &p, Vertex v) {
+		assert(get(boost::vertex_index_t(), *p.g, v) < p.vertexIds.size());
+		return p.vertexIds[get(boost::vertex_index_t(), *p.g, v)];
+	}
+
+	friend LabelId getLabelId(const PropString &p, Edge e) {
+		assert(get(boost::edge_index_t(), *p.g, e) < p.edgeIds.size());
+		return p.edgeIds[get(boost::edge_index_t(), *p.g, e)];
+	}
+private:
+	std::vector<LabelId> vertexIds, edgeIds;
 };
 
 } // namespace mod::lib::graph
@@ -0,0 +1,29 @@
+#include "Summary.hpp"
+
+#include <mod/lib/Graph/LabelledGraph.hpp>
+#include <mod/lib/Graph/Properties/Molecule.hpp>
+
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
+
+#include <limits>
+
+namespace mod::lib::graph {
+
+Summary makeSummary(const LabelledGraph &g) {
+	const auto &gg = get_graph(g);
+	const auto &pMol = get_molecule(g);
+	Summary res;
+	res.numVertices = num_vertices(gg);
+	res.numEdges = num_edges(gg);
+	res.exactMass = pMol.getIsMolecule() ? pMol.getExactMass() : std::numeric_limits<double>::quiet_NaN();
+	for(const Vertex v: asRange(vertices(gg))) {
+		const AtomData &ad = pMol[v];
+		const int charge = ad.getCharge();
+		res.charge += charge;
+		if(charge != 0) ++res.numChargedVertices;
+		if(ad.getRadical()) ++res.numRadicals;
+	}
+	return res;
+}
+
+} // namespace mod::lib::graph
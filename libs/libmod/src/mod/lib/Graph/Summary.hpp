@@ -0,0 +1,25 @@
+#ifndef MOD_LIB_GRAPH_SUMMARY_HPP
+#define MOD_LIB_GRAPH_SUMMARY_HPP
+
+#include <cstddef>
+
+namespace mod::lib::graph {
+struct LabelledGraph;
+
+// Whole-graph values for the native graph predicates, see mod::dg::GraphPredicate.
+// The chemical values are from the decoded vertex labels, i.e., from PropMolecule.
+struct Summary {
+	std::size_t numVertices = 0;
+	std::size_t numEdges = 0;
+	// NaN when the graph is not a molecule
+	double exactMass = 0;
+	int charge = 0;
+	std::size_t numChargedVertices = 0;
+	std::size_t numRadicals = 0;
+};
+
+Summary makeSummary(const LabelledGraph &g);
+
+} // namespace mod::lib::graph
+
+#endif // MOD_LIB_GRAPH_SUMMARY_HPP
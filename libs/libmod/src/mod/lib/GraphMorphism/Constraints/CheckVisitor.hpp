@@ -3,12 +3,17 @@
 
 #include <mod/lib/GraphMorphism/Constraints/AllVisitor.hpp>
 
+#include <memory>
+
 namespace mod::lib::GraphMorphism::Constraints {
 
 template<typename GraphDom, typename LabelledGraphCodom, typename Morphism>
 struct CheckVisitor : AllVisitor<GraphDom> {
-	CheckVisitor(const GraphDom &gDom, const LabelledGraphCodom &lgCodom, Morphism &m, const LabelSettings ls)
-			: gDom(gDom), lgCodom(lgCodom), m(m), ls(ls) {}
+	using Distances = ShortestPathDistances<typename LabelledGraphTraits<LabelledGraphCodom>::GraphType>;
+public:
+	CheckVisitor(const GraphDom &gDom, const LabelledGraphCodom &lgCodom, Morphism &m, const LabelSettings ls,
+	             Distances *distances)
+			: gDom(gDom), lgCodom(lgCodom), m(m), ls(ls), distances(distances) {}
 
 	virtual void operator()(const VertexAdjacency <GraphDom> &c) override {
 		result = c.matches(*this, gDom, lgCodom, m, ls);
@@ -26,18 +31,25 @@ public:
 	const LabelledGraphCodom &lgCodom;
 	Morphism &m;
 	const LabelSettings ls;
+	Distances *distances;
 	bool result;
 };
 
+// The distances in the codomain used for ShortestPath constraints are computed when first needed,
+// and may be shared with other checkers with the same codomain.
 template<typename ConstraintRange, typename LabelledGraphCodom, typename Next>
 struct Checker {
-	Checker(ConstraintRange constraints, const LabelledGraphCodom &lgCodom, LabelSettings ls, Next next)
-			: constraints(constraints), lgCodom(lgCodom), ls(ls), next(next) {}
+	using Distances = ShortestPathDistances<typename LabelledGraphTraits<LabelledGraphCodom>::GraphType>;
+public:
+	Checker(ConstraintRange constraints, const LabelledGraphCodom &lgCodom, LabelSettings ls, Next next,
+	        std::shared_ptr<Distances> distances)
+			: constraints(constraints), lgCodom(lgCodom), ls(ls), next(next), distances(std::move(distances)) {}
 
 	template<typename Morphism, typename GraphDom, typename GraphCodom>
 	bool operator()(Morphism &&m, const GraphDom &gDom, const GraphCodom &gCodom) const {
 		assert(&gCodom == &get_graph(lgCodom));
-		CheckVisitor<GraphDom, LabelledGraphCodom, Morphism> visitor(gDom, lgCodom, m, ls);
+		if(!distances) distances = std::make_shared<Distances>(get_graph(lgCodom));
+		CheckVisitor<GraphDom, LabelledGraphCodom, Morphism> visitor(gDom, lgCodom, m, ls, distances.get());
 		for(const auto &c: constraints) {
 			c->accept(visitor);
 			if(!visitor.result) return true;
@@ -49,13 +61,16 @@ private:
 	const LabelledGraphCodom &lgCodom;
 	LabelSettings ls;
 	Next next;
+	mutable std::shared_ptr<Distances> distances;
 };
 
 template<typename ConstraintRange, typename LabelledGraphCodom, typename Next = jla_boost::AlwaysTrue>
 Checker<ConstraintRange, LabelledGraphCodom, Next>
 makeChecker(ConstraintRange constraints, const LabelledGraphCodom &lgCodom, LabelSettings ls,
-            Next next = jla_boost::AlwaysTrue()) {
-	return Checker<ConstraintRange, LabelledGraphCodom, Next>(constraints, lgCodom, ls, next);
+            Next next = jla_boost::AlwaysTrue(),
+            std::shared_ptr<ShortestPathDistances<typename LabelledGraphTraits<LabelledGraphCodom>::GraphType>>
+            distances = nullptr) {
+	return Checker<ConstraintRange, LabelledGraphCodom, Next>(constraints, lgCodom, ls, next, std::move(distances));
 }
 
 } // namespace mod::lib::GraphMorphism::Constraints
@@ -0,0 +1,127 @@
+#ifndef MOD_LIB_GRAPHMORPHISM_PARTIALCHECKER_HPP
+#define MOD_LIB_GRAPHMORPHISM_PARTIALCHECKER_HPP
+
+#include <mod/lib/GraphMorphism/Constraints/AllVisitor.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace mod::lib::GraphMorphism::Constraints {
+
+// The constraints compiled for checking them on partial morphisms during a VF2 search,
+// such that a branch is rejected as soon as the constrained vertices are mapped,
+// instead of after enumerating all the complete morphisms in it.
+// Only the domain vertices accepted by the inDomain predicate given to the constructor are mapped by the search.
+// The checks are necessary conditions of those done by a Checker on the complete morphisms, so it must still be used:
+// - VertexAdjacency, with string labels: checked when the constrained vertex is mapped.
+// - ShortestPath, with both vertices in the domain: checked when the second of them is mapped.
+// - LabelAny, with string labels: it does not depend on the morphism, so it is evaluated once, see isUnsatisfiable().
+// The rest require the term data of complete morphisms.
+template<typename GraphDom, typename LabelledGraphCodom>
+struct PartialChecker {
+	using GraphCodom = typename LabelledGraphTraits<LabelledGraphCodom>::GraphType;
+	using VertexDom = typename boost::graph_traits<GraphDom>::vertex_descriptor;
+	using VertexCodom = typename boost::graph_traits<GraphCodom>::vertex_descriptor;
+	using Distances = ShortestPathDistances<GraphCodom>;
+private:
+	struct PathCheck {
+		const ShortestPath<GraphDom> *c;
+		VertexDom vOther;
+		bool isSrc;
+	};
+
+	struct VertexChecks {
+		std::vector<const VertexAdjacency<GraphDom> *> adjacency;
+		std::vector<PathCheck> paths;
+	};
+
+	template<typename InDomain>
+	struct CompileVisitor : AllVisitor<GraphDom> {
+		CompileVisitor(PartialChecker &pc, InDomain inDomain) : pc(pc), inDomain(inDomain) {}
+
+		virtual void operator()(const VertexAdjacency<GraphDom> &c) override {
+			if(pc.ls.type != LabelType::String) return;
+			if(!inDomain(c.vConstrained)) return;
+			pc.getChecks(c.vConstrained).adjacency.push_back(&c);
+		}
+
+		virtual void operator()(const LabelAny<GraphDom> &c) override {
+			if(pc.ls.type != LabelType::String) return;
+			if(std::find(c.labels.begin(), c.labels.end(), c.label) == c.labels.end())
+				pc.unsatisfiable = true;
+		}
+
+		virtual void operator()(const ShortestPath<GraphDom> &c) override {
+			if(!inDomain(c.vSrc) || !inDomain(c.vTar)) return;
+			pc.getChecks(c.vSrc).paths.push_back(PathCheck{&c, c.vTar, true});
+			if(c.vTar != c.vSrc)
+				pc.getChecks(c.vTar).paths.push_back(PathCheck{&c, c.vSrc, false});
+		}
+	public:
+		PartialChecker &pc;
+		InDomain inDomain;
+	};
+public:
+	template<typename ConstraintRange, typename InDomain>
+	PartialChecker(ConstraintRange constraints, const GraphDom &gDom, const LabelledGraphCodom &lgCodom,
+	               LabelSettings ls, std::shared_ptr<Distances> distances, InDomain inDomain)
+			: gDom(gDom), lgCodom(lgCodom), ls(ls), distances(std::move(distances)) {
+		CompileVisitor<InDomain> visitor(*this, inDomain);
+		for(const auto &c: constraints)
+			c->accept(visitor);
+	}
+
+	// Whether no morphism can satisfy the constraints.
+	bool isUnsatisfiable() const {
+		return unsatisfiable;
+	}
+
+	// Whether the pair (v, w) may be added to the partial morphism m, see vf2_subgraph_mono.
+	template<typename VertexMap, typename GraphDomInner, typename GraphCodomInner>
+	bool operator()(VertexDom v, VertexCodom w, const VertexMap &m,
+	                const GraphDomInner &gDomInner, const GraphCodomInner &gCodomInner) const {
+		if(checks.empty()) return true;
+		const VertexChecks &vChecks = checks[get(boost::vertex_index_t(), gDom, v)];
+		for(const auto *c: vChecks.adjacency)
+			if(!c->checkCount(c->countString(lgCodom, w))) return false;
+		for(const PathCheck &pc: vChecks.paths) {
+			VertexCodom wOther = w;
+			if(pc.vOther != v) {
+				wOther = get(m, gDomInner, gCodomInner, pc.vOther);
+				if(wOther == boost::graph_traits<GraphCodomInner>::null_vertex()) continue;
+			}
+			const int length = pc.isSrc ? (*distances)(w, wOther) : (*distances)(wOther, w);
+			if(!pc.c->checkLength(length)) return false;
+		}
+		return true;
+	}
+private:
+	VertexChecks &getChecks(VertexDom v) {
+		if(checks.empty()) checks.resize(num_vertices(gDom));
+		return checks[get(boost::vertex_index_t(), gDom, v)];
+	}
+private:
+	const GraphDom &gDom;
+	const LabelledGraphCodom &lgCodom;
+	const LabelSettings ls;
+	std::shared_ptr<Distances> distances;
+	bool unsatisfiable = false;
+	std::vector<VertexChecks> checks; // by domain vertex index, empty if nothing to check
+};
+
+// A copyable reference to a PartialChecker, for giving it to the VF2 search.
+template<typename PC>
+struct PartialCheckerRef {
+	template<typename VertexDom, typename VertexCodom, typename VertexMap, typename GraphDomInner, typename GraphCodomInner>
+	bool operator()(VertexDom v, VertexCodom w, const VertexMap &m,
+	                const GraphDomInner &gDomInner, const GraphCodomInner &gCodomInner) const {
+		return (*pc)(v, w, m, gDomInner, gCodomInner);
+	}
+public:
+	const PC *pc;
+};
+
+} // namespace mod::lib::GraphMorphism::Constraints
+
+#endif // MOD_LIB_GRAPHMORPHISM_PARTIALCHECKER_HPP
@@ -5,12 +5,49 @@
 #include <mod/lib/LabelledGraph.hpp>
 #include <mod/lib/GraphMorphism/Constraints/Constraint.hpp>
 
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
 #include <jla_boost/graph/morphism/Concepts.hpp>
 
-#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <limits>
+#include <vector>
 
 namespace mod::lib::GraphMorphism::Constraints {
 
+// The lengths of the shortest paths in an unweighted graph, where each row is computed by a breadth-first search
+// the first time a path from the source vertex is requested.
+// Unreachable vertices have the length std::numeric_limits<int>::max().
+// It is not thread-safe, and the graph must outlive it.
+template<typename Graph>
+struct ShortestPathDistances {
+	using Vertex = typename boost::graph_traits<Graph>::vertex_descriptor;
+public:
+	explicit ShortestPathDistances(const Graph &g) : g(g), rows(num_vertices(g)) {}
+
+	int operator()(Vertex vSrc, Vertex vTar) {
+		auto &row = rows[get(boost::vertex_index_t(), g, vSrc)];
+		if(row.empty()) {
+			row.resize(num_vertices(g), std::numeric_limits<int>::max());
+			std::vector<Vertex> queue{vSrc};
+			row[get(boost::vertex_index_t(), g, vSrc)] = 0;
+			for(std::size_t i = 0; i != queue.size(); ++i) {
+				const auto v = queue[i];
+				const int dist = row[get(boost::vertex_index_t(), g, v)] + 1;
+				for(const auto e: asRange(out_edges(v, g))) {
+					const auto vAdj = target(e, g);
+					int &distAdj = row[get(boost::vertex_index_t(), g, vAdj)];
+					if(distAdj != std::numeric_limits<int>::max()) continue;
+					distAdj = dist;
+					queue.push_back(vAdj);
+				}
+			}
+		}
+		return row[get(boost::vertex_index_t(), g, vTar)];
+	}
+private:
+	const Graph &g;
+	std::vector<std::vector<int>> rows;
+};
+
 template<typename Graph>
 struct ShortestPath : Constraint<Graph> {
 	MOD_VISITABLE();
@@ -28,6 +65,24 @@ public:
 		return "ShortestPath";
 	}
 
+	bool checkLength(int length) const {
+		switch(op) {
+		case Operator::EQ:
+			return length == this->length;
+		case Operator::LT:
+			return length < this->length;
+		case Operator::GT:
+			return length > this->length;
+		case Operator::LEQ:
+			return length <= this->length;
+		case Operator::GEQ:
+			return length >= this->length;
+		}
+		assert(false);
+		std::abort();
+	}
+
+	// The visitor must provide the distances in the codomain graph as vis.distances.
 	template<typename Visitor, typename LabelledGraphCodom, typename VertexMap>
 	bool matches(Visitor &vis, const Graph &gDom, const LabelledGraphCodom &lgCodom, const VertexMap &m,
 	             const LabelSettings ls) const {
@@ -45,40 +100,15 @@ public:
 			assert(std::find(vs.first, vs.second, vTar) != vs.second);
 #endif
 		}
-		const auto check = [this](int length) -> bool {
-			switch(op) {
-			case Operator::EQ:
-				return length == this->length;
-			case Operator::LT:
-				return length < this->length;
-			case Operator::GT:
-				return length > this->length;
-			case Operator::LEQ:
-				return length <= this->length;
-			case Operator::GEQ:
-				return length >= this->length;
-			}
-			assert(false);
-			std::abort();
-		};
 		const auto vSrcCodom = get(m, gDom, gCodom, vSrc);
 		const auto vTarCodom = get(m, gDom, gCodom, vTar);
 		const auto vRightNull = boost::graph_traits<GraphCodom>::null_vertex();
 		if(vSrcCodom == vRightNull && vTarCodom == vRightNull) return true;
 		if(vSrcCodom == vRightNull || vTarCodom == vRightNull) {
-			return check(std::numeric_limits<int>::max());
+			return checkLength(std::numeric_limits<int>::max());
 		}
-		using VertexCodom = typename boost::graph_traits<GraphCodom>::vertex_descriptor;
-		using EdgeCodom = typename boost::graph_traits<GraphCodom>::edge_descriptor;
-		std::vector<int> distance(num_vertices(gCodom));
-		std::vector<VertexCodom> predesc(num_vertices(gCodom));
-		auto distanceMap = boost::make_iterator_property_map(distance.begin(), get(boost::vertex_index_t(), gCodom));
-		auto predescMap = boost::make_iterator_property_map(predesc.begin(), get(boost::vertex_index_t(), gCodom));
-
-		boost::dijkstra_shortest_paths(gCodom, vSrcCodom, distance_map(distanceMap).predecessor_map(predescMap)
-				.weight_map(boost::make_constant_property<EdgeCodom>(1)));
-		const auto length = distance[get(boost::vertex_index_t(), gCodom, vTarCodom)];
-		return check(length);
+		assert(vis.distances);
+		return checkLength((*vis.distances)(vSrcCodom, vTarCodom));
 	}
 public:
 	Vertex vSrc, vTar;
@@ -36,14 +36,11 @@ public:
 	virtual std::string name() const override {
 		return "VertexAdjacency";
 	}
-private:
-	template<typename Visitor, typename LabelledGraphCodom, typename VertexMap>
-	int matchesImpl(Visitor &vis, const Graph &gDom, const LabelledGraphCodom &lgCodom, VertexMap &m,
-					const LabelSettings ls, std::false_type) const {
-		assert(ls.type == LabelType::String); // otherwise someone forgot to add the TermData prop
-		using GraphCodom = typename LabelledGraphTraits<LabelledGraphCodom>::GraphType;
-		const GraphCodom &gCodom = get_graph(lgCodom);
-		const auto vCodom = get(m, gDom, gCodom, vConstrained);
+public:
+	// The number of neighbours of vCodom counted by the constraint, with string labels.
+	template<typename LabelledGraphCodom, typename VertexCodom>
+	int countString(const LabelledGraphCodom &lgCodom, VertexCodom vCodom) const {
+		const auto &gCodom = get_graph(lgCodom);
 		int count = 0;
 		const auto &string = get_string(lgCodom);
 		for(const auto eOutCodom: asRange(out_edges(vCodom, gCodom))) {
@@ -60,6 +57,31 @@ private:
 		return count;
 	}
 
+	bool checkCount(int count) const {
+		switch(op) {
+		case Operator::EQ:
+			return count == this->count;
+		case Operator::LT:
+			return count < this->count;
+		case Operator::GT:
+			return count > this->count;
+		case Operator::LEQ:
+			return count <= this->count;
+		case Operator::GEQ:
+			return count >= this->count;
+		}
+		assert(false);
+		std::abort();
+	}
+private:
+	template<typename Visitor, typename LabelledGraphCodom, typename VertexMap>
+	int matchesImpl(Visitor &vis, const Graph &gDom, const LabelledGraphCodom &lgCodom, VertexMap &m,
+					const LabelSettings ls, std::false_type) const {
+		assert(ls.type == LabelType::String); // otherwise someone forgot to add the TermData prop
+		const auto &gCodom = get_graph(lgCodom);
+		return countString(lgCodom, get(m, gDom, gCodom, vConstrained));
+	}
+
 	template<typename Visitor, typename LabelledGraphCodom, typename VertexMap>
 	int matchesImpl(Visitor &vis, const Graph &gDom, const LabelledGraphCodom &lgCodom, VertexMap &m,
 					const LabelSettings ls, std::true_type) const {
@@ -157,20 +179,7 @@ public:
 			}() << " " << this->count << " hasTerm=" << std::boolalpha << HasTerm::value << std::endl;
 		}
 #endif
-		switch(op) {
-		case Operator::EQ:
-			return count == this->count;
-		case Operator::LT:
-			return count < this->count;
-		case Operator::GT:
-			return count > this->count;
-		case Operator::LEQ:
-			return count <= this->count;
-		case Operator::GEQ:
-			return count >= this->count;
-		}
-		assert(false);
-		std::abort();
+		return checkCount(count);
 	}
 public:
 	Vertex vConstrained;
@@ -1,6 +1,8 @@
 #ifndef MOD_LIB_GRAPH_MORPHISM_FINDER_HPP
 #define MOD_LIB_GRAPH_MORPHISM_FINDER_HPP
 
+#include <jla_boost/Functional.hpp>
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
 #include <jla_boost/graph/morphism/VertexOrderByMult.hpp>
 
 namespace mod::lib::GraphMorphism {
@@ -99,6 +101,12 @@ struct DefaultFinderArgsProvider {
 		else
 			return vertex_order_by_max_connectivity(g);
 	}
+
+	// The predicate on candidate pairs and the current partial morphism, see vf2_subgraph_mono.
+	template<typename Graph>
+	friend jla_boost::AlwaysTrue get_partial_map_predicate(const DefaultFinderArgsProvider &, const Graph &g) {
+		return {};
+	}
 };
 
 } // namespace mod::lib::GraphMorphism
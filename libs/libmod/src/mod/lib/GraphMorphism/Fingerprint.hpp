@@ -0,0 +1,88 @@
+#ifndef MOD_LIB_GRAPHMORPHISM_FINGERPRINT_HPP
+#define MOD_LIB_GRAPHMORPHISM_FINGERPRINT_HPP
+
+#include <mod/Config.hpp>
+#include <mod/lib/StringStore.hpp>
+
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace mod::lib::GraphMorphism {
+
+// A summary of a labelled graph for rejecting pairs of graphs that can not have a monomorphism between them,
+// before running a morphism finder.
+// The label histograms are of the string label IDs, and are only compared for LabelType::String,
+// where the labels of matched elements must be equal for all label relations.
+// Term labels may contain variables, so for them only the sizes and the maximum degree are compared.
+struct Fingerprint {
+	std::size_t numVertices = 0;
+	std::size_t numEdges = 0;
+	std::size_t maxDegree = 0;
+	// (label ID, count), sorted by label ID
+	std::vector<std::pair<LabelId, std::size_t>> vertexLabels, edgeLabels;
+};
+
+namespace detail {
+
+inline std::vector<std::pair<LabelId, std::size_t>> makeLabelHistogram(std::vector<LabelId> &ids) {
+	std::sort(ids.begin(), ids.end());
+	std::vector<std::pair<LabelId, std::size_t>> res;
+	for(const LabelId id: ids) {
+		if(res.empty() || res.back().first != id) res.emplace_back(id, 1);
+		else ++res.back().second;
+	}
+	return res;
+}
+
+// Whether each label in dom occurs at least as many times in codom.
+inline bool isDominatedBy(const std::vector<std::pair<LabelId, std::size_t>> &dom,
+                          const std::vector<std::pair<LabelId, std::size_t>> &codom) {
+	auto iterCodom = codom.begin();
+	for(const auto &p: dom) {
+		while(iterCodom != codom.end() && iterCodom->first < p.first) ++iterCodom;
+		if(iterCodom == codom.end() || iterCodom->first != p.first) return false;
+		if(iterCodom->second < p.second) return false;
+		++iterCodom;
+	}
+	return true;
+}
+
+} // namespace detail
+
+// The fingerprint of g, where getLabelId(pString, v) and getLabelId(pString, e) must give the label IDs.
+template<typename Graph, typename PropString>
+Fingerprint makeFingerprint(const Graph &g, const PropString &pString) {
+	Fingerprint res;
+	std::vector<LabelId> ids;
+	for(const auto v: asRange(vertices(g))) {
+		++res.numVertices;
+		res.maxDegree = std::max<std::size_t>(res.maxDegree, out_degree(v, g));
+		ids.push_back(getLabelId(pString, v));
+	}
+	res.vertexLabels = detail::makeLabelHistogram(ids);
+	ids.clear();
+	for(const auto e: asRange(edges(g))) {
+		++res.numEdges;
+		ids.push_back(getLabelId(pString, e));
+	}
+	res.edgeLabels = detail::makeLabelHistogram(ids);
+	return res;
+}
+
+// Whether a monomorphism from a graph with the fingerprint fDom into a graph with the fingerprint fCodom may exist.
+// A false result is definite, while a true result must be checked by a morphism finder.
+inline bool mayHaveMonomorphism(const Fingerprint &fDom, const Fingerprint &fCodom, LabelType labelType) {
+	if(fDom.numVertices > fCodom.numVertices) return false;
+	if(fDom.numEdges > fCodom.numEdges) return false;
+	if(fDom.maxDegree > fCodom.maxDegree) return false;
+	if(labelType != LabelType::String) return true;
+	return detail::isDominatedBy(fDom.vertexLabels, fCodom.vertexLabels)
+	       && detail::isDominatedBy(fDom.edgeLabels, fCodom.edgeLabels);
+}
+
+} // namespace mod::lib::GraphMorphism
+
+#endif // MOD_LIB_GRAPHMORPHISM_FINGERPRINT_HPP
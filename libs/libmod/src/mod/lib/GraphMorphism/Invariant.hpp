@@ -0,0 +1,68 @@
+#ifndef MOD_LIB_GRAPHMORPHISM_INVARIANT_HPP
+#define MOD_LIB_GRAPHMORPHISM_INVARIANT_HPP
+
+#include <mod/Error.hpp>
+#include <mod/lib/Term/WAM.hpp>
+
+#include <jla_boost/graph/PairToRangeAdaptor.hpp>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace mod::lib::GraphMorphism {
+
+// Hash of a term where all variables hash equal, so it is invariant under variable renaming.
+inline std::size_t hashTermModuloRenaming(const lib::Term::Wam &machine, lib::Term::Address addr) {
+	addr = machine.deref(addr);
+	const auto &cell = machine.getCell(addr);
+	switch(cell.tag) {
+	case lib::Term::Cell::Tag::REF:
+		return 1;
+	case lib::Term::Cell::Tag::STR:
+		return hashTermModuloRenaming(machine, cell.STR.addr);
+	case lib::Term::Cell::Tag::Structure: {
+		std::size_t res = cell.Structure.name;
+		boost::hash_combine(res, cell.Structure.arity);
+		for(int i = 1; i <= cell.Structure.arity; ++i)
+			boost::hash_combine(res, hashTermModuloRenaming(machine, addr + i));
+		return res;
+	}
+	}
+	MOD_ABORT;
+}
+
+// A Weisfeiler-Lehman hash of an undirected graph, i.e., isomorphic graphs have the same hash
+// as long as labelHash(v)/labelHash(e) are invariant under isomorphism.
+template<typename Graph, typename LabelHash>
+std::size_t hashWL(const Graph &g, LabelHash labelHash) {
+	constexpr int numRounds = 3;
+	const auto n = num_vertices(g);
+	std::vector<std::size_t> colour(n), colourNext(n);
+	for(const auto v: asRange(vertices(g)))
+		colour[get(boost::vertex_index_t(), g, v)] = labelHash(v);
+	std::vector<std::size_t> nbrs;
+	for(int round = 0; round != numRounds; ++round) {
+		for(const auto v: asRange(vertices(g))) {
+			nbrs.clear();
+			for(const auto e: asRange(out_edges(v, g))) {
+				std::size_t h = labelHash(e);
+				boost::hash_combine(h, colour[get(boost::vertex_index_t(), g, target(e, g))]);
+				nbrs.push_back(h);
+			}
+			std::sort(nbrs.begin(), nbrs.end());
+			const auto vId = get(boost::vertex_index_t(), g, v);
+			std::size_t h = colour[vId];
+			boost::hash_range(h, nbrs.begin(), nbrs.end());
+			colourNext[vId] = h;
+		}
+		colour.swap(colourNext);
+	}
+	std::sort(colour.begin(), colour.end());
+	return boost::hash_range(colour.begin(), colour.end());
+}
+
+} // namespace mod::lib::GraphMorphism
+
+#endif // MOD_LIB_GRAPHMORPHISM_INVARIANT_HPP
@@ -57,6 +57,16 @@ decltype(auto) get_vertex_order_impl(const OuterGraph &gOuter, ... /* worse than
 	return get_vertex_order(DefaultFinderArgsProvider(), get_graph(gOuter));
 }
 
+template<typename OuterGraph>
+auto get_partial_map_predicate_impl(const OuterGraph &gOuter, int) -> decltype(get_partial_map_predicate(gOuter)) {
+	return get_partial_map_predicate(gOuter);
+}
+
+template<typename OuterGraph>
+auto get_partial_map_predicate_impl(const OuterGraph &gOuter, ... /* worse than everything */) {
+	return get_partial_map_predicate(DefaultFinderArgsProvider(), get_graph(gOuter));
+}
+
 template<typename OuterGraph>
 struct ArgsProvider {
 	using GraphType = typename LabelledGraphTraits<OuterGraph>::GraphType;
@@ -67,6 +77,11 @@ struct ArgsProvider {
 		assert(&g == &get_graph(arp.gOuter));
 		return get_vertex_order_impl(arp.gOuter, int());
 	}
+
+	friend auto get_partial_map_predicate(const ArgsProvider &arp, const GraphType &g) {
+		assert(&g == &get_graph(arp.gOuter));
+		return get_partial_map_predicate_impl(arp.gOuter, int());
+	}
 private:
 	const OuterGraph &gOuter;
 };
@@ -112,14 +127,14 @@ bool matchFinallyDoIt(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain
 template<typename LabGraphDom, typename LabGraphCodom, typename MR, typename Finder, typename PredWrapper, typename MRWrapper, typename TermFilter>
 bool morphismCreateTermRelation(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain, Finder finder,
                                 MR mr, PredWrapper predWrapper, MRWrapper mrWrapper, TermFilter termFilter) {
-	auto mrFinal = makeToTermVertexMap(gDomain, gCodomain, GM::makeFilter(termFilter, mr));
+	auto mrFinal = makeToTermVertexMap(gDomain, gCodomain, termFilter, mr);
 	return morphismFinallyDoIt(gDomain, gCodomain, finder, mrFinal, predWrapper, mrWrapper);
 }
 
 template<typename LabGraphDom, typename LabGraphCodom, typename VertexMap, typename MR, typename MRWrapper, typename TermFilter>
 bool matchCreateTermRelation(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain, VertexMap &&map,
                              MR mr, MRWrapper mrWrapper, TermFilter termFilter) {
-	auto mrFinal = makeToTermVertexMap(gDomain, gCodomain, GM::makeFilter(termFilter, mr));
+	auto mrFinal = makeToTermVertexMap(gDomain, gCodomain, termFilter, mr);
 	return matchFinallyDoIt(gDomain, gCodomain, std::forward<VertexMap>(map), mrFinal, mrWrapper);
 }
 
@@ -161,6 +176,40 @@ bool matchSelectTermRelation(const LabGraphDom &gDomain, const LabGraphCodom &gC
 
 //------------------------------------------------------------------------------
 
+// Compares string labels by their index in getLabelStrings() when both properties provide it,
+// and otherwise by the strings.
+template<typename PropDom, typename PropCodom, typename Next>
+struct LabelIdPredicateEq {
+	LabelIdPredicateEq(PropDom pDom, PropCodom pCodom, Next next) : pDom(pDom), pCodom(pCodom), next(next) {}
+
+	template<typename VEDom, typename VECodom, typename ...Args>
+	bool operator()(const VEDom &veDom, const VECodom &veCodom, Args &&... args) const {
+		return equal(veDom, veCodom, 0) && next(veDom, veCodom, std::forward<Args>(args)...);
+	}
+private:
+	template<typename VEDom, typename VECodom>
+	auto equal(const VEDom &veDom, const VECodom &veCodom, int) const
+	-> decltype(getLabelId(std::declval<const std::decay_t<PropDom> &>(), veDom)
+	            == getLabelId(std::declval<const std::decay_t<PropCodom> &>(), veCodom)) {
+		return getLabelId(pDom, veDom) == getLabelId(pCodom, veCodom);
+	}
+
+	template<typename VEDom, typename VECodom>
+	bool equal(const VEDom &veDom, const VECodom &veCodom, ... /* worse than everything */) const {
+		return get(pDom, veDom) == get(pCodom, veCodom);
+	}
+private:
+	PropDom pDom;
+	PropCodom pCodom;
+	Next next;
+};
+
+template<typename PropDom, typename PropCodom, typename Next>
+auto makeLabelIdPredicateEq(PropDom &&pDom, PropCodom &&pCodom, Next next) {
+	return LabelIdPredicateEq<PropDom, PropCodom, Next>(std::forward<PropDom>(pDom), std::forward<PropCodom>(pCodom),
+	                                                    next);
+}
+
 template<typename PredWrapper>
 struct StringLabelPredWrapper {
 	PredWrapper predWrapper;
@@ -170,7 +219,7 @@ public:
 	template<typename LabGraphDom, typename LabGraphCodom, typename Pred>
 	auto operator()(const LabGraphDom &gDomain, const LabGraphCodom &gCodomain, Pred pred) const {
 		return predWrapper(gDomain, gCodomain,
-		                   GM::makePropertyPredicateEq(get_string(gDomain), get_string(gCodomain), pred));
+		                   makeLabelIdPredicateEq(get_string(gDomain), get_string(gCodomain), pred));
 	}
 };
 
@@ -17,6 +17,7 @@
 #include <mod/lib/Term/IO/Write.hpp>
 
 #include <iostream>
+#include <optional>
 
 namespace mod::lib::GraphMorphism {
 
@@ -155,10 +156,14 @@ struct TermAssociationHandlerUnify {
 	}
 };
 
-template<typename LabGraphDom, typename LabGraphCodom, typename Next>
+// Unifies the terms of each morphism, and if the result is accepted by the term filter,
+// gives the morphism to next with a copy of the machine and the MGU as TermData.
+// A single machine is used for all morphisms, and the unification is undone afterwards,
+// so only the accepted morphisms require a copy of the machine.
+template<typename LabGraphDom, typename LabGraphCodom, typename TermFilter, typename Next>
 struct ToTermVertexMap {
-	ToTermVertexMap(const LabGraphDom &gDom, const LabGraphCodom &gCodom, Next next)
-			: lgDom(gDom), lgCodom(gCodom), next(next) {
+	ToTermVertexMap(const LabGraphDom &gDom, const LabGraphCodom &gCodom, TermFilter termFilter, Next next)
+			: lgDom(gDom), lgCodom(gCodom), termFilter(termFilter), next(next) {
 		if(!isValid(get_term(gDom))) MOD_ABORT;
 		if(!isValid(get_term(gCodom))) MOD_ABORT;
 	}
@@ -175,9 +180,27 @@ struct ToTermVertexMap {
 		assert(isValid(pDomain));
 		assert(isValid(pCodomain));
 
-		Term::Wam machine(getMachine(pCodomain));
-		machine.setTemp(getMachine(pDomain));
-		Term::MGU mgu(machine.getHeap().size());
+		if(!machine) {
+			machine = getMachine(pCodomain);
+			machine->setTemp(getMachine(pDomain));
+			mgu = Term::MGU(machine->getHeap().size());
+		}
+		const auto mark = machine->mark(*mgu);
+		const auto ok = unify(m, gDom, gCodom, pDomain, pCodomain) && termFilter(*machine, *mgu);
+		if(!ok) {
+			machine->undo(*mgu, mark);
+			return true;
+		}
+		TermData data{*machine, *mgu};
+		machine->undo(*mgu, mark);
+		return next(GM::addProp(std::move(m), TermDataT(), std::move(data)), gDom, gCodom);
+	}
+private:
+	template<typename VertexMap, typename GraphDom, typename GraphCodom, typename PropDom, typename PropCodom>
+	bool unify(const VertexMap &m, const GraphDom &gDom, const GraphCodom &gCodom,
+	           const PropDom &pDomain, const PropCodom &pCodomain) const {
+		auto &machine = *this->machine;
+		auto &mgu = *this->mgu;
 		using Handler = typename LabGraphDom::PropTermType::Handler;
 		for(const auto vDom: asRange(vertices(gDom))) {
 			const auto vCodom = get(m, gDom, gCodom, vDom);
@@ -187,7 +210,7 @@ struct ToTermVertexMap {
 					Handler::fmap2(get(pDomain, vDom), get(pCodomain, vCodom), lgDom, lgCodom,
 					               TermAssociationHandlerUnify(), machine, mgu
 					));
-			if(!ok) return true;
+			if(!ok) return false;
 		}
 		for(const auto eDom: asRange(edges(gDom))) {
 			const auto vDomSrc = source(eDom, gDom);
@@ -205,46 +228,37 @@ struct ToTermVertexMap {
 					Handler::fmap2(get(pDomain, eDom), get(pCodomain, eCodom), lgDom, lgCodom,
 					               TermAssociationHandlerUnify(), machine, mgu
 					));
-			if(!ok) return true;
+			if(!ok) return false;
 		}
-		TermData data{std::move(machine), std::move(mgu)};
-		return next(GM::addProp(std::move(m), TermDataT(), std::move(data)), gDom, gCodom);
+		return true;
 	}
 private:
 	const LabGraphDom &lgDom;
 	const LabGraphCodom &lgCodom;
+	TermFilter termFilter;
 	Next next;
+	// the codomain machine with the domain machine as temp, created at the first morphism
+	mutable std::optional<Term::Wam> machine;
+	mutable std::optional<Term::MGU> mgu;
 };
 
-template<typename LabGraphDom, typename LabGraphCodom, typename Next>
-auto makeToTermVertexMap(const LabGraphDom &gDom, const LabGraphCodom &gCodom, Next next) {
-	return ToTermVertexMap<LabGraphDom, LabGraphCodom, Next>(gDom, gCodom, next);
+template<typename LabGraphDom, typename LabGraphCodom, typename TermFilter, typename Next>
+auto makeToTermVertexMap(const LabGraphDom &gDom, const LabGraphCodom &gCodom, TermFilter termFilter, Next next) {
+	return ToTermVertexMap<LabGraphDom, LabGraphCodom, TermFilter, Next>(gDom, gCodom, termFilter, next);
 }
 
 // Filters for isRenaming and isSpecialisation
 //------------------------------------------------------------------------------
 
 struct TermFilterRenaming {
-	template<typename VertexMap, typename GraphDom, typename GraphCodom>
-	bool operator()(const VertexMap &m, const GraphDom &gDom, const GraphCodom &gCodom) const {
-		//		Term::Write::wam(m.machine, Term::getStrings(), std::cout);
-		//		Term::Write::mgu(m.machine, m.mgu, Term::getStrings(), std::cout) << "\n";
-		const auto &data = get_prop(TermDataT(), m);
-		bool res = data.mgu.isRenaming(data.machine);
-		//		std::cout << "Result: " << std::boolalpha << res << "\n";
-		return res;
+	bool operator()(const Term::Wam &machine, const Term::MGU &mgu) const {
+		return mgu.isRenaming(machine);
 	}
 };
 
 struct TermFilterSpecialisation {
-	template<typename VertexMap, typename GraphDom, typename GraphCodom>
-	bool operator()(const VertexMap &m, const GraphDom &gDom, const GraphCodom &gCodom) const {
-		//		Term::Write::wam(m.machine, Term::getStrings(), std::cout);
-		//		Term::Write::mgu(m.machine, m.mgu, Term::getStrings(), std::cout) << "\n";
-		const auto &data = get_prop(TermDataT(), m);
-		bool res = data.mgu.isSpecialisation(data.machine);
-		//		std::cout << "Result: " << std::boolalpha << res << "\n";
-		return res;
+	bool operator()(const Term::Wam &machine, const Term::MGU &mgu) const {
+		return mgu.isSpecialisation(machine);
 	}
 };
 
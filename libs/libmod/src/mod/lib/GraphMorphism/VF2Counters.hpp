@@ -0,0 +1,53 @@
+#ifndef MOD_LIB_GRAPH_MORPHISM_VF2COUNTERS_HPP
+#define MOD_LIB_GRAPH_MORPHISM_VF2COUNTERS_HPP
+
+#include <cstdint>
+
+namespace mod::lib::GraphMorphism {
+
+// Statistics for the VF2 searches, see VF2CounterScope.
+struct VF2Counters {
+	VF2Counters &operator+=(const VF2Counters &other) {
+		numCalls += other.numCalls;
+		numCandidatePairs += other.numCandidatePairs;
+		return *this;
+	}
+public:
+	std::uint64_t numCalls = 0;
+	// the number of vertex pairs tried for extending a partial morphism,
+	// i.e., the number of nodes in the search trees
+	std::uint64_t numCandidatePairs = 0;
+};
+
+namespace detail {
+
+inline thread_local VF2Counters *threadVF2Counters = nullptr;
+
+} // namespace detail
+
+// The counters the VF2 searches of the current thread are currently counted in, or nullptr.
+inline VF2Counters *getThreadVF2Counters() {
+	return detail::threadVF2Counters;
+}
+
+// While alive, the VF2 searches done by the current thread are counted in the given counters
+// (instead of in those of an enclosing scope). Passing nullptr disables the counting.
+// Other threads are not affected, so parallel tasks must use their own scopes.
+struct VF2CounterScope {
+	explicit VF2CounterScope(VF2Counters *counters) : prev(detail::threadVF2Counters) {
+		detail::threadVF2Counters = counters;
+	}
+
+	VF2CounterScope(const VF2CounterScope &) = delete;
+	VF2CounterScope &operator=(const VF2CounterScope &) = delete;
+
+	~VF2CounterScope() {
+		detail::threadVF2Counters = prev;
+	}
+private:
+	VF2Counters *prev;
+};
+
+} // namespace mod::lib::GraphMorphism
+
+#endif // MOD_LIB_GRAPH_MORPHISM_VF2COUNTERS_HPP
@@ -2,12 +2,14 @@
 #define MOD_LIB_GRAPH_MORPHISM_VF2_HPP
 
 #include <mod/lib/GraphMorphism/Finder.hpp>
+#include <mod/lib/GraphMorphism/VF2Counters.hpp>
 
 #include <jla_boost/graph/morphism/finders/vf2.hpp>
 
 namespace mod {
 namespace lib {
 namespace GraphMorphism {
+
 namespace detail {
 
 template<typename Graph>
@@ -16,6 +18,18 @@ void assertSizes(const Graph &g) {
 	assert(num_edges(g) == std::distance(edges(g).first, edges(g).second));
 }
 
+// Counts the VF2 call and wraps the vertex predicate such that each tried vertex pair is counted.
+// When counting is disabled the overhead is a branch on a pointer that stays null.
+template<typename VertexPredicate>
+auto countVF2(VertexPredicate vertexPred) {
+	VF2Counters *counters = threadVF2Counters;
+	if(counters) ++counters->numCalls;
+	return [vertexPred, counters](const auto &vDomain, const auto &vCodomain) mutable -> bool {
+		if(counters) ++counters->numCandidatePairs;
+		return vertexPred(vDomain, vCodomain);
+	};
+}
+
 } // namespace detail
 
 struct VF2Isomorphism {
@@ -27,7 +41,7 @@ struct VF2Isomorphism {
 		auto &&vOrderDomain = get_vertex_order(argsDomain, gDomain);
 		return jla_boost::GraphMorphism::vf2_graph_iso(gDomain, gCodomain, mr,
 				get(boost::vertex_index_t(), gDomain), get(boost::vertex_index_t(), gCodomain),
-				vOrderDomain, edgePred, vertexPred);
+				vOrderDomain, edgePred, detail::countVF2(vertexPred));
 	}
 
 	template<typename GraphDomain, typename GraphCodomain, typename MR, typename EdgePredicate, typename VertexPredicate>
@@ -45,7 +59,8 @@ struct VF2Monomorphism {
 		auto &&vOrderDomain = get_vertex_order(argsDomain, gDomain);
 		return jla_boost::GraphMorphism::vf2_subgraph_mono(gDomain, gCodomain, mr,
 				get(boost::vertex_index_t(), gDomain), get(boost::vertex_index_t(), gCodomain),
-				vOrderDomain, edgePred, vertexPred);
+				vOrderDomain, edgePred, detail::countVF2(vertexPred),
+				get_partial_map_predicate(argsDomain, gDomain));
 	}
 
 	template<typename GraphDomain, typename GraphCodomain, typename MR, typename EdgePredicate, typename VertexPredicate>
@@ -0,0 +1,93 @@
+#ifndef MOD_LIB_GRAPH_MORPHISM_VF2PP_HPP
+#define MOD_LIB_GRAPH_MORPHISM_VF2PP_HPP
+
+#include <mod/Config.hpp>
+#include <mod/Error.hpp>
+#include <mod/lib/GraphMorphism/Finder.hpp>
+#include <mod/lib/GraphMorphism/VF2Finder.hpp>
+
+#include <jla_boost/graph/morphism/finders/vf2pp.hpp>
+
+namespace mod::lib::GraphMorphism {
+namespace detail {
+
+// Counts the call and wraps the partial map predicate such that each tried vertex pair is counted.
+// The vertex predicate is evaluated for all pairs up front, so it does not reflect the size of the search tree.
+template<typename PartialMapPredicate>
+auto countVF2PP(PartialMapPredicate partialMapPred) {
+	VF2Counters *counters = threadVF2Counters;
+	if(counters) ++counters->numCalls;
+	return [partialMapPred, counters](const auto &v, const auto &w, const auto &m,
+	                                  const auto &gDom, const auto &gCodom) mutable -> bool {
+		if(counters) ++counters->numCandidatePairs;
+		return partialMapPred(v, w, m, gDom, gCodom);
+	};
+}
+
+} // namespace detail
+
+// The VF2++-style search of jla_boost/graph/morphism/finders/vf2pp.hpp,
+// where the domain vertices are ordered by the rarity of their labels in the codomain,
+// instead of by the vertex order of the arguments.
+// The searches are counted in the VF2Counters as well.
+struct VF2PPIsomorphism {
+	template<typename GraphDomain, typename GraphCodomain, typename MR, typename EdgePredicate, typename VertexPredicate,
+			typename ArgsProviderDomain, typename ArgsProviderCodomain>
+	bool operator()(const GraphDomain &gDomain, const GraphCodomain &gCodomain, MR mr, EdgePredicate edgePred,
+	                VertexPredicate vertexPred, ArgsProviderDomain argsDomain, ArgsProviderCodomain argsCodomain) {
+		return jla_boost::GraphMorphism::vf2pp_graph_iso(gDomain, gCodomain, mr, edgePred, vertexPred,
+		                                                 detail::countVF2PP(jla_boost::AlwaysTrue()));
+	}
+
+	template<typename GraphDomain, typename GraphCodomain, typename MR, typename EdgePredicate, typename VertexPredicate>
+	bool operator()(const GraphDomain &gDomain, const GraphCodomain &gCodomain, MR mr, EdgePredicate edgePred,
+	                VertexPredicate vertexPred) {
+		return (*this)(gDomain, gCodomain, mr, edgePred, vertexPred, DefaultFinderArgsProvider(),
+		               DefaultFinderArgsProvider());
+	}
+};
+
+struct VF2PPMonomorphism {
+	template<typename GraphDomain, typename GraphCodomain, typename MR, typename EdgePredicate, typename VertexPredicate,
+			typename ArgsProviderDomain, typename ArgsProviderCodomain>
+	bool operator()(const GraphDomain &gDomain, const GraphCodomain &gCodomain, MR mr, EdgePredicate edgePred,
+	                VertexPredicate vertexPred, ArgsProviderDomain argsDomain, ArgsProviderCodomain argsCodomain) {
+		return jla_boost::GraphMorphism::vf2pp_subgraph_mono(gDomain, gCodomain, mr, edgePred, vertexPred,
+		                                                     detail::countVF2PP(
+				                                                     get_partial_map_predicate(argsDomain, gDomain)));
+	}
+
+	template<typename GraphDomain, typename GraphCodomain, typename MR, typename EdgePredicate, typename VertexPredicate>
+	bool operator()(const GraphDomain &gDomain, const GraphCodomain &gCodomain, MR mr, EdgePredicate edgePred,
+	                VertexPredicate vertexPred) {
+		return (*this)(gDomain, gCodomain, mr, edgePred, vertexPred, DefaultFinderArgsProvider(),
+		               DefaultFinderArgsProvider());
+	}
+};
+
+// The finders selected by getConfig().graph.morphismFinder when they are called.
+struct ConfiguredIsomorphism {
+	template<typename ...Args>
+	bool operator()(Args &&...args) {
+		switch(getConfig().graph.morphismFinder) {
+		case Config::MorphismFinder::VF2: return VF2Isomorphism()(std::forward<Args>(args)...);
+		case Config::MorphismFinder::VF2PP: return VF2PPIsomorphism()(std::forward<Args>(args)...);
+		}
+		MOD_ABORT;
+	}
+};
+
+struct ConfiguredMonomorphism {
+	template<typename ...Args>
+	bool operator()(Args &&...args) {
+		switch(getConfig().graph.morphismFinder) {
+		case Config::MorphismFinder::VF2: return VF2Monomorphism()(std::forward<Args>(args)...);
+		case Config::MorphismFinder::VF2PP: return VF2PPMonomorphism()(std::forward<Args>(args)...);
+		}
+		MOD_ABORT;
+	}
+};
+
+} // namespace mod::lib::GraphMorphism
+
+#endif // MOD_LIB_GRAPH_MORPHISM_VF2PP_HPP
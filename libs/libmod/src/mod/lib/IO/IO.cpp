@@ -1,11 +1,19 @@
 #include "IO.hpp"
 
+#include <mod/Post.hpp>
+
+#include <boost/functional/hash.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace mod::lib::IO {
 namespace {
@@ -47,7 +55,8 @@ PostStream postStream;
 } // namespace
 
 std::string makeUniqueFilePrefix() {
-	static int count = 0;
+	static std::atomic<int> nextCount(0);
+	const int count = nextCount++;
 
 	std::string strCount;
 	int k = 4;
@@ -56,7 +65,6 @@ std::string makeUniqueFilePrefix() {
 	for(int i = 0; i < diff; i++) strCount += '0';
 	strCount += boost::lexical_cast<std::string>(count);
 	strCount += '_';
-	count++;
 	return prefix + strCount;
 }
 
@@ -99,6 +107,45 @@ std::string asLatexMath(const std::string &str) {
 	return res;
 }
 
+namespace {
+
+// Only a hash of the content of each written file is kept,
+// and the candidates with the same hash are compared with what is on disk.
+std::mutex deduplicatedMutex;
+std::unordered_map<std::size_t, std::vector<std::string>> filesByHash;
+
+bool hasContent(const std::string &file, const std::string &content) {
+	std::ifstream ifs(file, std::ios::binary);
+	if(!ifs) return false;
+	const std::string onDisk{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+	return onDisk == content;
+}
+
+} // namespace
+
+std::string writeDeduplicated(const std::string &file, const std::string &content) {
+	const auto extPos = file.find_last_of('.');
+	const std::string ext = extPos == std::string::npos ? std::string() : file.substr(extPos);
+	std::size_t hash = std::hash<std::string>()(content);
+	boost::hash_combine(hash, ext);
+	std::scoped_lock lock(deduplicatedMutex);
+	auto &files = filesByHash[hash];
+	for(const auto &f: files)
+		if(hasContent(f, content))
+			return f;
+	{
+		post::FileHandle s(file);
+		s.stream << content;
+	}
+	files.push_back(file);
+	return file;
+}
+
+void clearDeduplicated() {
+	std::scoped_lock lock(deduplicatedMutex);
+	filesByHash.clear();
+}
+
 std::ostream &nullStream() {
 	// https://stackoverflow.com/questions/11826554/standard-no-op-output-stream/11826787
 	struct NullBuffer : public std::streambuf {
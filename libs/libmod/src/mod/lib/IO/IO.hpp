@@ -10,6 +10,16 @@ std::string makeUniqueFilePrefix();
 std::string escapeForLatex(const std::string &str);
 std::string asLatexMath(const std::string &str);
 
+// Writes the content to the file and returns the name of it,
+// unless a file with the same extension and content has previously been written with this function,
+// in which case the name of that file is returned and nothing is written.
+// Figures are written through this, so identical figures, e.g., of different graph objects with the same depiction,
+// are only processed once in post-processing.
+// Only a hash of each content is remembered, until clearDeduplicated() is called,
+// which is done when the post-processing commands are flushed.
+std::string writeDeduplicated(const std::string &file, const std::string &content);
+void clearDeduplicated();
+
 std::ostream &nullStream();
 std::ostream &post();
 
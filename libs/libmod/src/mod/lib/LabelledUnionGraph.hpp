@@ -46,6 +46,13 @@ protected:
       }
 
 MOD_MAKE_UNION_PROP(String, string)
+	friend decltype(auto) getLabelId(const UnionPropString &up, const typename Base::Vertex v) {
+		return getLabelId(get_string(*up.lgs[v.gIdx]), v.v);
+	}
+
+	friend decltype(auto) getLabelId(const UnionPropString &up, const typename Base::Edge e) {
+		return getLabelId(get_string(*up.lgs[e.gIdx]), e.e);
+	}
 };
 MOD_MAKE_UNION_PROP_MIN(Term, term)
 	UnionPropTerm(const std::vector<const LGraph *> &lgs) : Base(lgs) {
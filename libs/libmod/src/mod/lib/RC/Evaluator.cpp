@@ -4,6 +4,7 @@
 #include <mod/graph/Graph.hpp>
 #include <mod/rule/CompositionExpr.hpp>
 #include <mod/rule/Rule.hpp>
+#include <mod/lib/Algorithm/ParallelFor.hpp>
 #include <mod/lib/RC/ComposeFromMatchMaker.hpp>
 #include <mod/lib/RC/IO/Write.hpp>
 #include <mod/lib/RC/MatchMaker/Common.hpp>
@@ -13,9 +14,25 @@
 
 #include <boost/variant/static_visitor.hpp>
 
+#include <map>
+#include <sstream>
+
 namespace mod::lib::RC {
 namespace {
 
+// Compute the lazily initialised data of a rule used during composition,
+// such that threads afterwards only read from the rule.
+void prepareForParallelComposition(const lib::rule::Rule &r) {
+	const auto &rDPO = r.getDPORule();
+	get_string(rDPO);
+	get_molecule(rDPO);
+	for(const auto &lg: {get_labelled_left(rDPO), get_labelled_right(rDPO)})
+		for(std::size_t i = 0; i != get_num_connected_components(lg); ++i) {
+			get_vertex_order_component(i, lg);
+			get_component_fingerprint(i, lg);
+		}
+}
+
 struct EvalVisitor : public boost::static_visitor<std::vector<std::shared_ptr<mod::rule::Rule>>> {
 	EvalVisitor(bool onlyUnique, int verbosity, IO::Logger logger, Evaluator &evaluator)
 		: onlyUnique(onlyUnique), verbosity(verbosity), logger(logger), evaluator(evaluator) {}
@@ -67,22 +84,87 @@ struct EvalVisitor : public boost::static_visitor<std::vector<std::shared_ptr<mo
 
 	template<typename ComposeBinary, typename Composer>
 	std::vector<std::shared_ptr<mod::rule::Rule>> composeTemplate(
-			const ComposeBinary &compose, Composer composer) {
-		const auto doIt = [&compose, &composer, this](auto &result) {
+			const ComposeBinary &compose, Evaluator::ComposeKind kind, unsigned int params, Composer composer) {
+		const auto doIt = [&compose, kind, params, &composer, this](auto &result) {
 			auto firstResult = compose.first.applyVisitor(*this);
 			auto secondResult = compose.second.applyVisitor(*this);
-			for(auto rFirst: firstResult) {
-				for(auto rSecond: secondResult) {
-					std::vector<lib::rule::Rule*> resultVec;
-					auto reporter = [&resultVec](std::unique_ptr<lib::rule::Rule> r, const ResultMaps &) {
-						resultVec.push_back(r.release());
-						return true;
-					};
-					composer(rFirst->getRule(), rSecond->getRule(), reporter);
-					for(auto *r: resultVec) {
-						auto rWrapped = evaluator.checkIfNew(r);
-						bool isNew = evaluator.addRule(rWrapped);
-						if(isNew) evaluator.giveProductStatus(rWrapped);
+			const auto makeKey = [kind, params](const auto &rFirst, const auto &rSecond) {
+				return Evaluator::CompositionKey(kind, params, rFirst->getRule().getId(), rSecond->getRule().getId());
+			};
+			// wrap the results of a new composition and record them
+			const auto addComposition = [this](const Evaluator::CompositionKey &key,
+			                                   std::vector<std::unique_ptr<lib::rule::Rule>> &resultVec) -> const auto & {
+				std::vector<std::shared_ptr<mod::rule::Rule>> wrapped;
+				wrapped.reserve(resultVec.size());
+				for(auto &r: resultVec) {
+					auto rWrapped = evaluator.checkIfNew(r.release());
+					bool isNew = evaluator.addRule(rWrapped);
+					if(isNew) evaluator.giveProductStatus(rWrapped);
+					wrapped.push_back(std::move(rWrapped));
+				}
+				return evaluator.addComposition(key, std::move(wrapped));
+			};
+			const auto composeInto = [&composer](const lib::rule::Rule &rFirst, const lib::rule::Rule &rSecond,
+			                                     IO::Logger logger,
+			                                     std::vector<std::unique_ptr<lib::rule::Rule>> &resultVec) {
+				auto reporter = [&resultVec](std::unique_ptr<lib::rule::Rule> r, const ResultMaps &) {
+					resultVec.push_back(std::move(r));
+					return true;
+				};
+				composer(rFirst, rSecond, logger, reporter);
+			};
+
+			// compositions done in an earlier evaluation are reused,
+			// and when possible the new ones are done in parallel before they are merged in the serial order
+			struct Task {
+				const lib::rule::Rule *rFirst, *rSecond;
+				std::vector<std::unique_ptr<lib::rule::Rule>> results;
+				std::string log;
+			};
+			std::vector<Task> tasks;
+			std::map<Evaluator::CompositionKey, std::size_t> taskFromKey;
+			if(canComposeInParallel()) {
+				std::unordered_set<const lib::rule::Rule *> prepared;
+				const auto prepare = [&prepared](const lib::rule::Rule &r) {
+					if(prepared.insert(&r).second) prepareForParallelComposition(r);
+				};
+				for(const auto &rFirst: firstResult) {
+					for(const auto &rSecond: secondResult) {
+						const auto key = makeKey(rFirst, rSecond);
+						if(evaluator.findComposition(key) || taskFromKey.find(key) != taskFromKey.end()) continue;
+						prepare(rFirst->getRule());
+						prepare(rSecond->getRule());
+						taskFromKey.emplace(key, tasks.size());
+						tasks.push_back(Task{&rFirst->getRule(), &rSecond->getRule(), {}, {}});
+					}
+				}
+				lib::parallelFor(getConfig().common.numThreads, tasks.size(), [&](std::size_t iTask) {
+					Task &task = tasks[iTask];
+					std::ostringstream ss;
+					IO::Logger taskLogger(ss);
+					taskLogger.indentLevel = logger.indentLevel;
+					composeInto(*task.rFirst, *task.rSecond, taskLogger, task.results);
+					task.log = ss.str();
+				});
+			}
+
+			for(const auto &rFirst: firstResult) {
+				for(const auto &rSecond: secondResult) {
+					const auto key = makeKey(rFirst, rSecond);
+					const auto *rs = evaluator.findComposition(key);
+					if(!rs) {
+						const auto iterTask = taskFromKey.find(key);
+						if(iterTask != taskFromKey.end()) {
+							Task &task = tasks[iterTask->second];
+							logger.s << task.log;
+							rs = &addComposition(key, task.results);
+						} else {
+							std::vector<std::unique_ptr<lib::rule::Rule>> resultVec;
+							composeInto(rFirst->getRule(), rSecond->getRule(), logger, resultVec);
+							rs = &addComposition(key, resultVec);
+						}
+					}
+					for(const auto &rWrapped: *rs) {
 						evaluator.suggestComposition(&rFirst->getRule(), &rSecond->getRule(), &rWrapped->getRule());
 						result.insert(result.end(), rWrapped);
 					}
@@ -102,12 +184,14 @@ struct EvalVisitor : public boost::static_visitor<std::vector<std::shared_ptr<mo
 
 	std::vector<std::shared_ptr<mod::rule::Rule>> operator()(const mod::rule::RCExp::ComposeCommon &common) {
 		const auto composer = [&common, this](const lib::rule::Rule &rFirst, const lib::rule::Rule &rSecond,
+		                                      IO::Logger logger,
 		                                      std::function<bool(std::unique_ptr<lib::rule::Rule>, const ResultMaps &)>
 		                                      reporter) {
 			RC::Common mm(matchMakerVerbosity(), logger, common.maximum, common.connected);
 			lib::RC::composeFromMatchMaker(rFirst, rSecond, mm, reporter, evaluator.labelSettings);
 		};
-		auto res = composeTemplate(common, composer);
+		const unsigned int params = (common.maximum ? 1 : 0) | (common.connected ? 2 : 0);
+		auto res = composeTemplate(common, Evaluator::ComposeKind::Common, params, composer);
 		if(common.includeEmpty) {
 			auto resEmpty = (*this)(mod::rule::RCExp::ComposeParallel(common.first, common.second));
 			res.insert(res.end(), resEmpty.begin(), resEmpty.end());
@@ -117,32 +201,47 @@ struct EvalVisitor : public boost::static_visitor<std::vector<std::shared_ptr<mo
 
 	std::vector<std::shared_ptr<mod::rule::Rule>> operator()(const mod::rule::RCExp::ComposeParallel &common) {
 		const auto composer = [this](const lib::rule::Rule &rFirst, const lib::rule::Rule &rSecond,
+		                             IO::Logger logger,
 		                             std::function<bool(std::unique_ptr<lib::rule::Rule>, const ResultMaps &)>
 		                             reporter) {
 			lib::RC::composeFromMatchMaker(rFirst, rSecond, lib::RC::Parallel(verbosity, logger),
 			                               reporter, evaluator.labelSettings);
 		};
-		return composeTemplate(common, composer);
+		return composeTemplate(common, Evaluator::ComposeKind::Parallel, 0, composer);
 	}
 
 	std::vector<std::shared_ptr<mod::rule::Rule>> operator()(const mod::rule::RCExp::ComposeSub &sub) {
 		const auto composer = [&sub, this](const lib::rule::Rule &rFirst, const lib::rule::Rule &rSecond,
+		                                   IO::Logger logger,
 		                                   std::function<bool(std::unique_ptr<lib::rule::Rule>, const ResultMaps &)>
 		                                   reporter) {
 			RC::Sub mm(matchMakerVerbosity(), logger, sub.allowPartial);
 			lib::RC::composeFromMatchMaker(rFirst, rSecond, mm, reporter, evaluator.labelSettings);
 		};
-		return composeTemplate(sub, composer);
+		const unsigned int params = sub.allowPartial ? 1 : 0;
+		return composeTemplate(sub, Evaluator::ComposeKind::Sub, params, composer);
 	}
 
 	std::vector<std::shared_ptr<mod::rule::Rule>> operator()(const mod::rule::RCExp::ComposeSuper &super) {
 		const auto composer = [&super, this](const lib::rule::Rule &rFirst, const lib::rule::Rule &rSecond,
+		                                     IO::Logger logger,
 		                                     std::function<bool(std::unique_ptr<lib::rule::Rule>, const ResultMaps &)>
 		                                     reporter) {
 			RC::Super mm(matchMakerVerbosity(), logger, super.allowPartial, super.enforceConstraints);
 			lib::RC::composeFromMatchMaker(rFirst, rSecond, mm, reporter, evaluator.labelSettings);
 		};
-		return composeTemplate(super, composer);
+		const unsigned int params = (super.allowPartial ? 1 : 0) | (super.enforceConstraints ? 2 : 0);
+		return composeTemplate(super, Evaluator::ComposeKind::Super, params, composer);
+	}
+
+	// The compositions only read the (pre-computed) data of the input rules,
+	// except for term labels, which may intern new strings, and stereo data, which is
+	// inferred lazily, so those are done serially.
+	bool canComposeInParallel() const {
+		return getConfig().common.numThreads > 1
+		       && evaluator.labelSettings.type == LabelType::String
+		       && !evaluator.labelSettings.withStereo
+		       && !getConfig().rc.printMatches;
 	}
 
 	int matchMakerVerbosity() const {
@@ -168,6 +267,8 @@ Evaluator::Evaluator(std::unordered_set<std::shared_ptr<mod::rule::Rule>> databa
 			}
 		}
 	}
+	for(const auto &r: this->database)
+		databaseByInvariant[getInvariant(r->getRule())].push_back(r);
 }
 
 const std::unordered_set<std::shared_ptr<mod::rule::Rule>> &Evaluator::getRuleDatabase() const {
@@ -253,7 +354,9 @@ const Evaluator::GraphType &Evaluator::getGraph() const {
 }
 
 bool Evaluator::addRule(std::shared_ptr<mod::rule::Rule> r) {
-	return database.insert(r).second;
+	const bool isNew = database.insert(r).second;
+	if(isNew) databaseByInvariant[getInvariant(r->getRule())].push_back(r);
+	return isNew;
 }
 
 void Evaluator::giveProductStatus(std::shared_ptr<mod::rule::Rule> r) {
@@ -261,16 +364,35 @@ void Evaluator::giveProductStatus(std::shared_ptr<mod::rule::Rule> r) {
 }
 
 std::shared_ptr<mod::rule::Rule> Evaluator::checkIfNew(lib::rule::Rule *rCand) const {
-	for(auto rOther: database) {
-		if(lib::rule::makeIsomorphismPredicate(labelSettings.type, labelSettings.withStereo)
-			(&rOther->getRule(), rCand)) {
-			delete rCand;
-			return rOther;
+	const auto iter = databaseByInvariant.find(getInvariant(*rCand));
+	if(iter != databaseByInvariant.end()) {
+		const auto isomorphic = lib::rule::makeIsomorphismPredicate(labelSettings.type, labelSettings.withStereo);
+		for(const auto &rOther: iter->second) {
+			if(isomorphic(&rOther->getRule(), rCand)) {
+				delete rCand;
+				return rOther;
+			}
 		}
 	}
 	return mod::rule::Rule::makeRule(std::unique_ptr<lib::rule::Rule>(rCand));
 }
 
+std::size_t Evaluator::getInvariant(const lib::rule::Rule &r) const {
+	return r.getIsomorphismInvariant(labelSettings.type);
+}
+
+const std::vector<std::shared_ptr<mod::rule::Rule>> *Evaluator::findComposition(const CompositionKey &key) const {
+	const auto iter = compositions.find(key);
+	return iter != compositions.end() ? &iter->second : nullptr;
+}
+
+const std::vector<std::shared_ptr<mod::rule::Rule>> &
+Evaluator::addComposition(const CompositionKey &key, std::vector<std::shared_ptr<mod::rule::Rule>> results) {
+	const auto res = compositions.emplace(key, std::move(results));
+	assert(res.second);
+	return res.first->second;
+}
+
 void Evaluator::suggestComposition(const lib::rule::Rule *rFirst,
                                    const lib::rule::Rule *rSecond,
                                    const lib::rule::Rule *rResult) {
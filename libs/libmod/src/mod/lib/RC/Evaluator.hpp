@@ -7,9 +7,12 @@
 
 #include <boost/graph/adjacency_list.hpp>
 
+#include <map>
 #include <memory>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace mod::lib::RC {
 
@@ -31,6 +34,13 @@ struct Evaluator {
 		EdgeKind kind;
 	};
 
+	enum class ComposeKind {
+		Common, Parallel, Sub, Super
+	};
+	// the kind of composition, its parameters as bit flags, and the IDs of the first and second rule,
+	// which, unlike their addresses, are not reused when a rule is deallocated
+	using CompositionKey = std::tuple<ComposeKind, unsigned int, std::size_t, std::size_t>;
+
 	using GraphType = boost::adjacency_list<boost::vecS, boost::vecS, boost::bidirectionalS, VProp, EProp>;
 	using Vertex = boost::graph_traits<GraphType>::vertex_descriptor;
 	using Edge = boost::graph_traits<GraphType>::edge_descriptor;
@@ -46,15 +56,22 @@ public: // evaluation interface
 	bool addRule(std::shared_ptr<mod::rule::Rule> r);
 	// adds a rule to the product graph list
 	void giveProductStatus(std::shared_ptr<mod::rule::Rule> r);
-	// searches the database for an isomorphic rule
+	// searches the database for an isomorphic rule, only among the rules with the same invariant
 	// if found, the rule is deleted and the database rule is returned
 	// otherwise, the rule is wrapped and returned
 	// does NOT add to the database
 	std::shared_ptr<mod::rule::Rule> checkIfNew(lib::rule::Rule *rCand) const;
+	// the wrapped results of a composition done earlier, or nullptr if it has not been done
+	const std::vector<std::shared_ptr<mod::rule::Rule>> *findComposition(const CompositionKey &key) const;
+	// requires findComposition(key) == nullptr
+	const std::vector<std::shared_ptr<mod::rule::Rule>> &
+	addComposition(const CompositionKey &key, std::vector<std::shared_ptr<mod::rule::Rule>> results);
 	// records a composition
 	void suggestComposition(const lib::rule::Rule *rFirst,
 	                        const lib::rule::Rule *rSecond,
 	                        const lib::rule::Rule *rResult);
+private:
+	std::size_t getInvariant(const lib::rule::Rule &r) const;
 private: // graph interface
 	Vertex getVertexFromRule(const lib::rule::Rule *r);
 	Vertex getVertexFromArgs(const lib::rule::Rule *rFirst, const lib::rule::Rule *rSecond);
@@ -63,10 +80,13 @@ public:
 	rule::GraphAsRuleCache graphAsRuleCache;
 private:
 	std::unordered_set<std::shared_ptr<mod::rule::Rule>> database, createdRules;
+	// the database bucketed by getInvariant, each bucket in insertion order
+	std::unordered_map<std::size_t, std::vector<std::shared_ptr<mod::rule::Rule>>> databaseByInvariant;
 private:
 	GraphType rcg;
 	std::unordered_map<const lib::rule::Rule *, Vertex> ruleToVertex;
 	std::map<std::pair<const lib::rule::Rule *, const lib::rule::Rule *>, Vertex> argsToVertex;
+	std::map<CompositionKey, std::vector<std::shared_ptr<mod::rule::Rule>>> compositions;
 };
 
 } // namespace mod::lib::RC
@@ -1,9 +1,11 @@
 #ifndef MOD_LIB_RC_MATCH_MAKER_COMPONENTWISE_UTIL_HPP
 #define MOD_LIB_RC_MATCH_MAKER_COMPONENTWISE_UTIL_HPP
 
+#include <mod/lib/GraphMorphism/Fingerprint.hpp>
 #include <mod/lib/GraphMorphism/LabelledMorphism.hpp>
-#include <mod/lib/GraphMorphism/VF2Finder.hpp>
+#include <mod/lib/GraphMorphism/VF2PPFinder.hpp>
 #include <mod/lib/GraphMorphism/Constraints/CheckVisitor.hpp>
+#include <mod/lib/GraphMorphism/Constraints/PartialChecker.hpp>
 #include <mod/lib/Rule/Rule.hpp>
 
 #include <jla_boost/graph/FilteredWrapper.hpp>
@@ -27,7 +29,8 @@ struct FilteredWrapperReinterpretMRWrapper {
 	}
 };
 
-template<typename Rule>
+// The partial map predicate is given to the VF2 search when the component is the domain.
+template<typename Rule, typename PartialMapPred = jla_boost::AlwaysTrue>
 struct WrappedComponentGraph {
 	using ComponentGraph = typename Rule::ComponentGraph;
 	using GraphType = jla_boost::FilteredWrapper<ComponentGraph>;
@@ -35,49 +38,56 @@ struct WrappedComponentGraph {
 	using PropTermType = typename Rule::PropTermType;
 	using PropStereoType = typename Rule::PropStereoType;
 public:
-	WrappedComponentGraph(const ComponentGraph &g, std::size_t i, const Rule &r)
-			: g(jla_boost::makeFilteredWrapper(g)), i(i), r(r) {}
+	WrappedComponentGraph(const ComponentGraph &g, std::size_t i, const Rule &r, PartialMapPred partialMapPred)
+			: g(jla_boost::makeFilteredWrapper(g)), i(i), r(r), partialMapPred(partialMapPred) {}
 
-	friend const GraphType &get_graph(const WrappedComponentGraph<Rule> &g) {
+	friend const GraphType &get_graph(const WrappedComponentGraph &g) {
 		return g.g;
 	}
 
-	friend PropStringType get_string(const WrappedComponentGraph<Rule> &g) {
+	friend PropStringType get_string(const WrappedComponentGraph &g) {
 		return get_string(g.r);
 	}
 
-	friend PropTermType get_term(const WrappedComponentGraph<Rule> &g) {
+	friend PropTermType get_term(const WrappedComponentGraph &g) {
 		return get_term(g.r);
 	}
 
-	friend bool has_stereo(const WrappedComponentGraph<Rule> &g) {
+	friend bool has_stereo(const WrappedComponentGraph &g) {
 		return has_stereo(g.r);
 	}
 
-	friend PropStereoType get_stereo(const WrappedComponentGraph<Rule> &g) {
+	friend PropStereoType get_stereo(const WrappedComponentGraph &g) {
 		return get_stereo(g.r);
 	}
 
 	friend const std::vector<typename boost::graph_traits<GraphType>::vertex_descriptor> &
-	get_vertex_order(const WrappedComponentGraph<Rule> &g) {
+	get_vertex_order(const WrappedComponentGraph &g) {
 		return get_vertex_order_component(g.i, g.r);
 	}
+
+	friend PartialMapPred get_partial_map_predicate(const WrappedComponentGraph &g) {
+		return g.partialMapPred;
+	}
 private:
 	GraphType g;
 	std::size_t i;
 	const Rule &r;
+	PartialMapPred partialMapPred;
 };
 
-template<typename Rule>
-WrappedComponentGraph<Rule> makeWrappedComponentGraph(const typename Rule::ComponentGraph &g,
-                                                      std::size_t i,
-                                                      const Rule &r) {
-	return WrappedComponentGraph<Rule>(g, i, r);
+template<typename Rule, typename PartialMapPred = jla_boost::AlwaysTrue>
+WrappedComponentGraph<Rule, PartialMapPred> makeWrappedComponentGraph(const typename Rule::ComponentGraph &g,
+                                                                      std::size_t i,
+                                                                      const Rule &r,
+                                                                      PartialMapPred partialMapPred = {}) {
+	return WrappedComponentGraph<Rule, PartialMapPred>(g, i, r, partialMapPred);
 }
 
 template<typename RuleSideDom, typename RuleSideCodom>
 struct RuleRuleComponentMonomorphism {
 	using Morphism = GM::VectorVertexMap<typename RuleSideDom::GraphType, typename RuleSideCodom::GraphType>;
+	using Distances = GraphMorphism::Constraints::ShortestPathDistances<typename RuleSideCodom::GraphType>;
 public:
 	RuleRuleComponentMonomorphism(const RuleSideDom &rsDom,
 	                              const RuleSideCodom &rsCodom,
@@ -85,25 +95,53 @@ public:
 	                              LabelSettings labelSettings,
 	                              bool verbose, IO::Logger &logger)
 			: rsDom(rsDom), rsCodom(rsCodom), enforceConstraints(enforceConstraints), labelSettings(labelSettings),
-			  verbose(verbose), logger(logger), haxMorphismLimit(getConfig().rc.componentWiseMorphismLimit) {}
+			  verbose(verbose), logger(logger), haxMorphismLimit(getConfig().rc.componentWiseMorphismLimit),
+			  useFingerprints(getConfig().rc.useComponentFingerprints) {}
 
 	std::vector<Morphism> operator()(const std::size_t idDom, const std::size_t idCodom) const {
-		const auto doIt = [this, idDom, idCodom](auto mrStore) {
+		// reject pairs with too few elements or labels in the codomain before starting VF2
+		if(useFingerprints && !GM_MOD::mayHaveMonomorphism(get_component_fingerprint(idDom, rsDom),
+		                                                   get_component_fingerprint(idCodom, rsCodom),
+		                                                   labelSettings.type)) {
+			if(verbose)
+				logger.indent() << "RuleRuleComponentMonomorphism(" << idDom << ", " << idCodom
+				                << "): rejected by fingerprint" << std::endl;
+			return {};
+		}
+		const auto &constraints = get_match_constraints(rsDom);
+		const auto constraintsIterEnd = enforceConstraints ? constraints.end() : constraints.begin();
+		const auto constraintsRange = asRange(std::make_pair(constraints.begin(), constraintsIterEnd));
+		if(constraints.begin() != constraintsIterEnd && !distances)
+			distances = std::make_shared<Distances>(get_graph(rsCodom));
+		// the constraints are also checked during the search, as soon as their vertices are mapped
+		const auto &component = get_component(rsDom);
+		const GraphMorphism::Constraints::PartialChecker<typename RuleSideDom::GraphType, RuleSideCodom> partialChecker(
+				constraintsRange, get_graph(rsDom), rsCodom, labelSettings, distances,
+				[&](const auto v) {
+					return component[get(boost::vertex_index_t(), get_graph(rsDom), v)] == idDom;
+				});
+		if(partialChecker.isUnsatisfiable()) {
+			if(verbose)
+				logger.indent() << "RuleRuleComponentMonomorphism(" << idDom << ", " << idCodom
+				                << "): the constraints can not be satisfied" << std::endl;
+			return {};
+		}
+
+		const auto doIt = [&](auto mrStore) {
 			const auto &gDom = get_component_graph(idDom, rsDom);
 			const auto &gCodom = get_component_graph(idCodom, rsCodom);
-			auto wgDom = makeWrappedComponentGraph(gDom, idDom, rsDom);
+			auto wgDom = makeWrappedComponentGraph(gDom, idDom, rsDom,
+			                                       GraphMorphism::Constraints::PartialCheckerRef<
+					                                       std::decay_t<decltype(partialChecker)>>{&partialChecker});
 			auto wgCodom = makeWrappedComponentGraph(gCodom, idCodom, rsCodom);
 
 			auto makeCheckConstraints = [&](auto &&mrNext) {
-				const auto &constraints = get_match_constraints(rsDom);
-				auto constraintsIterEnd = enforceConstraints ? constraints.end() : constraints.begin();
 				if(verbose)
 					logger.indent() << "RuleRuleComponentMonomorphism(" << idDom << ", " << idCodom
 					                << ")::makeCheckConstraints: "
 					                << std::distance(constraints.begin(), constraintsIterEnd) << std::endl;
-				return GraphMorphism::Constraints::makeChecker(
-						asRange(std::make_pair(constraints.begin(), constraintsIterEnd)),
-						rsCodom, labelSettings, mrNext);
+				return GraphMorphism::Constraints::makeChecker(constraintsRange, rsCodom, labelSettings, mrNext,
+				                                               distances);
 			};
 			// First reinterpret the vertex descriptors from the reindexed graphs to their parent graphs.
 			auto mrWrapper = FilteredWrapperReinterpretMRWrapper<RuleSideDom, RuleSideCodom>();
@@ -130,7 +168,7 @@ public:
 			auto predWrapper = lib::GraphMorphism::IdentityWrapper();
 
 			//				auto mrPrinter = GraphMorphism::Callback::makePrint(std::cout, patternWrapped, targetWrapped, mrCheckConstraints);
-			lib::GraphMorphism::morphismSelectByLabelSettings(wgDom, wgCodom, labelSettings, GM_MOD::VF2Monomorphism(), mr,
+			lib::GraphMorphism::morphismSelectByLabelSettings(wgDom, wgCodom, labelSettings, GM_MOD::ConfiguredMonomorphism(), mr,
 			                                                  predWrapper, mrWrapper);
 		};
 		std::vector<Morphism> morphisms;
@@ -155,6 +193,9 @@ private:
 	const bool verbose;
 	IO::Logger &logger;
 	int haxMorphismLimit;
+	bool useFingerprints;
+	// the shortest path lengths in the codomain side, for the constraints
+	mutable std::shared_ptr<Distances> distances;
 };
 
 template<typename RuleSideDom, typename RuleSideCodom>
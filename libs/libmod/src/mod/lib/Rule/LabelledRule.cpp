@@ -161,23 +161,26 @@ const GraphType &get_graph(const LabelledRule &r) {
 
 const LabelledRule::PropStringType &get_string(const LabelledRule &r) {
 	assert(r.pString || r.pTerm);
-	if(!r.pString) {
+	// if pString is missing, then pTerm is not, so get_term does not call back here
+	std::call_once(r.flags->string, [&r]() {
+		if(r.pString) return;
 		r.pString.reset(new LabelledRule::PropStringType(
 				r.getRule(), r.leftData.matchConstraints, r.rightData.matchConstraints,
 				get_term(r), lib::Term::getStrings()
 		));
-	}
+	});
 	return *r.pString;
 }
 
 const LabelledRule::PropTermType &get_term(const LabelledRule &r) {
 	assert(r.pString || r.pTerm);
-	if(!r.pTerm) {
+	std::call_once(r.flags->term, [&r]() {
+		if(r.pTerm) return;
 		r.pTerm.reset(new LabelledRule::PropTermType(
 				r.getRule(), r.leftData.matchConstraints, r.rightData.matchConstraints,
 				get_string(r), lib::Term::getStrings()
 		));
-	}
+	});
 	return *r.pTerm;
 }
 
@@ -186,7 +189,9 @@ bool has_stereo(const LabelledRule &r) {
 }
 
 const LabelledRule::PropStereoType &get_stereo(const LabelledRule &r) {
-	if(!has_stereo(r)) {
+	// if the deduction fails the flag is not set, so the next call will try again and throw again
+	std::call_once(r.flags->stereo, [&r]() {
+		if(has_stereo(r)) return;
 		constexpr bool printStereoWarnings = true;
 		auto gLeft = get_labelled_left(r);
 		auto gRight = get_labelled_right(r);
@@ -215,14 +220,15 @@ const LabelledRule::PropStereoType &get_stereo(const LabelledRule &r) {
 		r.pStereo.reset(new PropStereo(r.getRule(),
 		                               std::move(leftInference), std::move(rightInference), jla_boost::AlwaysTrue(),
 		                               jla_boost::AlwaysTrue()));
-	}
+	});
 	return *r.pStereo;
 }
 
 const LabelledRule::PropMoleculeType &get_molecule(const LabelledRule &r) {
-	if(!r.pMolecule) {
-		r.pMolecule.reset(new LabelledRule::PropMoleculeType(r.getRule(), get_string(r)));
-	}
+	std::call_once(r.flags->molecule, [&r]() {
+		if(!r.pMolecule)
+			r.pMolecule.reset(new LabelledRule::PropMoleculeType(r.getRule(), get_string(r)));
+	});
 	return *r.pMolecule;
 }
 
@@ -309,7 +315,7 @@ std::size_t get_num_connected_components(const LabelledRule::Side &g) {
 	return g.data.numComponents;
 }
 
-const std::vector<std::size_t> get_component(const LabelledRule::Side &g) {
+const std::vector<std::size_t> &get_component(const LabelledRule::Side &g) {
 	return g.data.component;
 }
 
@@ -324,11 +330,28 @@ const std::vector<boost::graph_traits<GraphType>::vertex_descriptor> &
 get_vertex_order_component(std::size_t i, const LabelledRule::Side &g) {
 	assert(i < get_num_connected_components(g));
 	auto &vertex_orders = g.data.vertex_orders;
-	// the number of connected components is initialized externally after construction, so we have this annoying hax
-	if(vertex_orders.empty()) vertex_orders.resize(get_num_connected_components(g));
-	if(vertex_orders[i].empty())
-		vertex_orders[i] = get_vertex_order(lib::GraphMorphism::DefaultFinderArgsProvider(), get_component_graph(i, g));
+	// the orders of all components are computed together, under a single flag
+	std::call_once(*g.data.vertexOrdersFlag, [&g, &vertex_orders]() {
+		if(!vertex_orders.empty()) return;
+		vertex_orders.reserve(get_num_connected_components(g));
+		for(std::size_t c = 0; c != get_num_connected_components(g); ++c)
+			vertex_orders.push_back(get_vertex_order(lib::GraphMorphism::DefaultFinderArgsProvider(),
+			                                         get_component_graph(c, g)));
+	});
 	return vertex_orders[i];
 }
 
+const GraphMorphism::Fingerprint &get_component_fingerprint(std::size_t i, const LabelledRule::Side &g) {
+	assert(i < get_num_connected_components(g));
+	auto &fingerprints = g.data.fingerprints;
+	std::call_once(*g.data.fingerprintsFlag, [&g, &fingerprints]() {
+		if(!fingerprints.empty()) return;
+		const auto pString = get_string(g);
+		fingerprints.reserve(get_num_connected_components(g));
+		for(std::size_t c = 0; c != get_num_connected_components(g); ++c)
+			fingerprints.push_back(GraphMorphism::makeFingerprint(get_component_graph(c, g), pString));
+	});
+	return fingerprints[i];
+}
+
 } // namespace mod::lib::rule
\ No newline at end of file
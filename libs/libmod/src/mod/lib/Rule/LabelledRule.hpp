@@ -3,6 +3,7 @@
 
 #include <mod/lib/DPO/CombinedRule.hpp>
 #include <mod/lib/GraphMorphism/Constraints/Constraint.hpp>
+#include <mod/lib/GraphMorphism/Fingerprint.hpp>
 #include <mod/lib/Rule/ConnectedComponent.hpp>
 #include <mod/lib/Rule/GraphDecl.hpp>
 #include <mod/lib/Rule/Properties/Molecule.hpp>
@@ -10,6 +11,7 @@
 #include <mod/lib/Rule/Properties/String.hpp>
 #include <mod/lib/Rule/Properties/Term.hpp>
 
+#include <mutex>
 #include <vector>
 
 namespace mod::lib::rule {
@@ -66,11 +68,12 @@ public:
 		get_match_constraints(const Side &g);
 	public:
 		friend std::size_t get_num_connected_components(const Side &g);
-		friend const std::vector<std::size_t> get_component(const Side &g);
+		friend const std::vector<std::size_t> &get_component(const Side &g);
 		friend ComponentGraph get_component_graph(std::size_t i, const Side &g);
 	public:
 		friend const std::vector<boost::graph_traits<GraphType>::vertex_descriptor> &
 		get_vertex_order_component(std::size_t i, const Side &g);
+		friend const GraphMorphism::Fingerprint &get_component_fingerprint(std::size_t i, const Side &g);
 	public:
 		const LabelledRule &r;
 		const GraphType &g;
@@ -121,12 +124,23 @@ public:
 	mutable std::unique_ptr<PropStereoType> pStereo;
 private:
 	mutable std::unique_ptr<PropMoleculeType> pMolecule;
+	// each lazily computed property is initialised under its own flag,
+	// so concurrent readers block until the first one has published it,
+	// the flags are allocated, so they follow their data when the rule is moved
+	struct Flags {
+		std::once_flag string, term, stereo, molecule;
+	};
+	std::unique_ptr<Flags> flags = std::make_unique<Flags>();
 public:
 	struct SideData {
 		std::size_t numComponents = -1;
 		std::vector<std::size_t> component;
 		std::vector<std::unique_ptr<MatchConstraint>> matchConstraints;
 		mutable std::vector<std::vector<Vertex>> vertex_orders;
+		mutable std::vector<GraphMorphism::Fingerprint> fingerprints;
+		// the flags are allocated, so they follow their data when the sides are swapped by invert()
+		std::unique_ptr<std::once_flag> vertexOrdersFlag = std::make_unique<std::once_flag>(),
+				fingerprintsFlag = std::make_unique<std::once_flag>();
 	} leftData, rightData;
 };
 
@@ -91,6 +91,14 @@ public: // is updated
 	void print(std::ostream &s, RuleType::CombinedVertex v) const;
 	void print(std::ostream &s, RuleType::CombinedEdge e) const;
 	const Derived &getDerived() const;
+protected:
+	// Called after the properties of a vertex/edge (with the given index) have been changed,
+	// except by invert(). Derived classes can hide these to maintain additional data.
+	void onChangedVertex(std::size_t) {}
+	void onChangedEdge(std::size_t) {}
+private:
+	void changedVertex(std::size_t vId);
+	void changedEdge(std::size_t eId);
 protected:
 	const RuleType &rule;
 protected:
@@ -172,6 +180,7 @@ void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::addL(RuleType::SideVertex v, VertexP
 	assert(get(boost::vertex_index_t(), getL(rule), v) == vPropL.size());
 	vPropL.push_back(std::move(p));
 	vPropR.emplace_back();
+	changedVertex(vPropL.size() - 1);
 	verify();
 }
 
@@ -181,6 +190,7 @@ void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::addR(RuleType::SideVertex v, VertexP
 	assert(get(boost::vertex_index_t(), getR(rule), v) == vPropR.size());
 	vPropL.emplace_back();
 	vPropR.push_back(std::move(p));
+	changedVertex(vPropR.size() - 1);
 	verify();
 }
 
@@ -196,6 +206,7 @@ void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::addK(RuleType::KVertex vK, VertexPro
 	       == vPropR.size());
 	vPropL.push_back(std::move(pL));
 	vPropR.push_back(std::move(pR));
+	changedVertex(vPropL.size() - 1);
 	verify();
 }
 
@@ -204,6 +215,7 @@ void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::promoteL(RuleType::SideVertex vL, Ru
 	assert(vL == vR);
 	const auto vRId = get(boost::vertex_index_t(), getR(rule), vR);
 	vPropR[vRId] = std::move(pR);
+	changedVertex(vRId);
 	verify();
 }
 
@@ -213,6 +225,7 @@ void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::addL(RuleType::SideEdge e, EdgeProp
 	assert(get(boost::edge_index_t(), getL(rule), e) == ePropL.size());
 	ePropL.push_back(std::move(p));
 	ePropR.emplace_back();
+	changedEdge(ePropL.size() - 1);
 	verify();
 }
 
@@ -222,6 +235,7 @@ void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::addR(RuleType::SideEdge e, EdgeProp
 	assert(get(boost::edge_index_t(), getR(rule), e) == ePropR.size());
 	ePropL.emplace_back();
 	ePropR.push_back(std::move(p));
+	changedEdge(ePropR.size() - 1);
 	verify();
 }
 
@@ -237,6 +251,7 @@ void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::addK(RuleType::KEdge eK, EdgeProp pL
 	       == ePropR.size());
 	ePropL.push_back(std::move(pL));
 	ePropR.push_back(std::move(pR));
+	changedEdge(ePropL.size() - 1);
 	verify();
 }
 
@@ -278,6 +293,7 @@ void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::add(RuleType::CombinedVertex v, cons
 	assert(get(boost::vertex_index_t(), rule.getCombinedGraph(), v) == vPropR.size());
 	vPropL.push_back(valueLeft);
 	vPropR.push_back(valueRight);
+	changedVertex(vPropL.size() - 1);
 	verify();
 }
 
@@ -290,6 +306,7 @@ void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::add(RuleType::CombinedEdge e, const
 	assert(get(boost::edge_index_t(), rule.getCombinedGraph(), e) == ePropR.size());
 	ePropL.push_back(valueLeft);
 	ePropR.push_back(valueRight);
+	changedEdge(ePropL.size() - 1);
 	verify();
 }
 
@@ -299,6 +316,7 @@ void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::setLeft(RuleType::CombinedVertex v,
 	assert(vId < vPropL.size());
 	assert(rule.getCombinedGraph()[v].membership != Membership::R);
 	vPropL[vId] = value;
+	changedVertex(vId);
 	verify();
 }
 
@@ -308,6 +326,7 @@ void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::setRight(RuleType::CombinedVertex v,
 	assert(vId < vPropR.size());
 	assert(rule.getCombinedGraph()[v].membership != Membership::L);
 	vPropR[vId] = value;
+	changedVertex(vId);
 	verify();
 }
 
@@ -317,6 +336,7 @@ void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::setLeft(RuleType::CombinedEdge e, co
 	assert(eId < ePropL.size());
 	assert(rule.getCombinedGraph()[e].membership != Membership::R);
 	ePropL[eId] = value;
+	changedEdge(eId);
 	verify();
 }
 
@@ -326,6 +346,7 @@ void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::setRight(RuleType::CombinedEdge e, c
 	assert(eId < ePropR.size());
 	assert(rule.getCombinedGraph()[e].membership != Membership::L);
 	ePropR[eId] = value;
+	changedEdge(eId);
 	verify();
 }
 
@@ -398,6 +419,16 @@ const Derived &PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::getDerived() const {
 	return static_cast<const Derived &>(*this);
 }
 
+template<MOD_RULE_PROP_TEMPLATE_PARAMS>
+void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::changedVertex(std::size_t vId) {
+	static_cast<Derived &>(*this).onChangedVertex(vId);
+}
+
+template<MOD_RULE_PROP_TEMPLATE_PARAMS>
+void PropBase<MOD_RULE_PROP_TEMPLATE_ARGS>::changedEdge(std::size_t eId) {
+	static_cast<Derived &>(*this).onChangedEdge(eId);
+}
+
 } // namespace mod::lib::rule
 
 #endif // MOD_LIB_RULES_PROP_HPP
\ No newline at end of file
@@ -94,6 +94,51 @@ PropString::PropString(const RuleType &rule,
 	};
 	handleConstraints(leftMatchConstraints);
 	handleConstraints(rightMatchConstraints);
+	for(std::size_t vId = 0; vId != vPropL.size(); ++vId) onChangedVertex(vId);
+	for(std::size_t eId = 0; eId != ePropL.size(); ++eId) onChangedEdge(eId);
+}
+
+void PropString::invert() {
+	Base::invert();
+	using std::swap;
+	swap(vIdsL, vIdsR);
+	swap(eIdsL, eIdsR);
+}
+
+const std::vector<LabelId> &PropString::getVertexIds(const Side &side) const {
+	assert(&side.pV == &vPropL || &side.pV == &vPropR);
+	return &side.pV == &vPropL ? vIdsL : vIdsR;
+}
+
+const std::vector<LabelId> &PropString::getEdgeIds(const Side &side) const {
+	assert(&side.pE == &ePropL || &side.pE == &ePropR);
+	return &side.pE == &ePropL ? eIdsL : eIdsR;
+}
+
+std::pair<LabelId, LabelId> PropString::getIds(RuleType::CombinedVertex v) const {
+	const auto m = rule.getCombinedGraph()[v].membership;
+	const auto vId = get(boost::vertex_index_t(), rule.getCombinedGraph(), v);
+	return {m != Membership::R ? vIdsL[vId] : NoLabel, m != Membership::L ? vIdsR[vId] : NoLabel};
+}
+
+std::pair<LabelId, LabelId> PropString::getIds(RuleType::CombinedEdge e) const {
+	const auto m = rule.getCombinedGraph()[e].membership;
+	const auto eId = get(boost::edge_index_t(), rule.getCombinedGraph(), e);
+	return {m != Membership::R ? eIdsL[eId] : NoLabel, m != Membership::L ? eIdsR[eId] : NoLabel};
+}
+
+void PropString::onChangedVertex(std::size_t vId) {
+	vIdsL.resize(vPropL.size());
+	vIdsR.resize(vPropR.size());
+	vIdsL[vId] = internLabel(vPropL[vId]);
+	vIdsR[vId] = internLabel(vPropR[vId]);
+}
+
+void PropString::onChangedEdge(std::size_t eId) {
+	eIdsL.resize(ePropL.size());
+	eIdsR.resize(ePropR.size());
+	eIdsL[eId] = internLabel(ePropL[eId]);
+	eIdsR[eId] = internLabel(ePropR[eId]);
 }
 
 } // namespace mod::lib::rule
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include <mod/lib/GraphMorphism/Constraints/Constraint.hpp>
 #include <mod/lib/Rule/GraphDecl.hpp>
 #include <mod/lib/Rule/Properties/Property.hpp>
+#include <mod/lib/StringStore.hpp>
+
+#include <limits>
 
 namespace mod::lib {
 struct StringStore;
@@ -12,15 +15,47 @@ namespace mod::lib::rule {
 struct PropTerm;
 
 struct PropString : PropBase<PropString, std::string, std::string> {
+	using Base = PropBase<PropString, std::string, std::string>;
 	using ConstraintPtr = std::unique_ptr<GraphMorphism::Constraints::Constraint<lib::DPO::CombinedRule::SideGraphType>>;
+	// the label ID of a vertex/edge not on a side
+	static constexpr LabelId NoLabel = std::numeric_limits<LabelId>::max();
 public:
 	explicit PropString(const RuleType &rule);
 	PropString(const RuleType &rule,
 	           const std::vector<ConstraintPtr> &leftMatchConstraints,
 	           const std::vector<ConstraintPtr> &rightMatchConstraints,
 	           const PropTerm &term, const StringStore &strings);
+	void invert();
+	// The indices in getLabelStrings() of the labels on the given side.
+	const std::vector<LabelId> &getVertexIds(const Side &side) const;
+	const std::vector<LabelId> &getEdgeIds(const Side &side) const;
+	// The left and right label IDs, NoLabel when not on that side.
+	std::pair<LabelId, LabelId> getIds(RuleType::CombinedVertex v) const;
+	std::pair<LabelId, LabelId> getIds(RuleType::CombinedEdge e) const;
+private:
+	friend Base;
+	void onChangedVertex(std::size_t vId);
+	void onChangedEdge(std::size_t eId);
+private:
+	std::vector<LabelId> vIdsL, vIdsR, eIdsL, eIdsR;
 };
 
+inline LabelId getLabelId(const PropString::Side &p, lib::DPO::CombinedRule::SideVertex v) {
+	return p.p.getDerived().getVertexIds(p)[get(boost::vertex_index_t(), p.g, v)];
+}
+
+inline LabelId getLabelId(const PropString::Side &p, lib::DPO::CombinedRule::SideEdge e) {
+	return p.p.getDerived().getEdgeIds(p)[get(boost::edge_index_t(), p.g, e)];
+}
+
+inline std::pair<LabelId, LabelId> getLabelId(const PropString &p, lib::DPO::CombinedRule::CombinedVertex v) {
+	return p.getIds(v);
+}
+
+inline std::pair<LabelId, LabelId> getLabelId(const PropString &p, lib::DPO::CombinedRule::CombinedEdge e) {
+	return p.getIds(e);
+}
+
 } // namespace mod::lib::rule
 
 #endif // MOD_LIB_RULES_PROP_STRING_HPP
\ No newline at end of file
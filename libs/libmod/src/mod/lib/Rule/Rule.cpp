@@ -5,8 +5,10 @@
 #include <mod/lib/Graph/Graph.hpp>
 #include <mod/lib/Graph/Properties/Stereo.hpp>
 #include <mod/lib/Graph/Properties/String.hpp>
+#include <mod/lib/GraphMorphism/Invariant.hpp>
 #include <mod/lib/GraphMorphism/LabelledMorphism.hpp>
 #include <mod/lib/GraphMorphism/VF2Finder.hpp>
+#include <mod/lib/GraphMorphism/VF2PPFinder.hpp>
 #include <mod/lib/LabelledGraph.hpp>
 #include <mod/lib/LabelledFilteredGraph.hpp>
 #include <mod/lib/IO/IO.hpp>
@@ -21,6 +23,8 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <atomic>
+
 namespace mod::lib::rule {
 BOOST_CONCEPT_ASSERT((LabelledGraphConcept<LabelledRule>));
 BOOST_CONCEPT_ASSERT((LabelledGraphConcept<LabelledRule::Side>));
@@ -78,7 +82,8 @@ bool Rule::sanityChecks(const lib::DPO::CombinedRule::CombinedGraphType &gCombin
 }
 
 namespace {
-std::size_t nextRuleNum = 0;
+// atomic as rules may be created concurrently during parallel rule application
+std::atomic<std::size_t> nextRuleNum(0);
 } // namespace
 
 Rule::Rule(LabelledRule &&rule, std::optional<LabelType> labelType)
@@ -249,14 +254,14 @@ std::size_t Rule::isomorphism(const Rule &rDom,
                               const Rule &rCodom,
                               std::size_t maxNumMatches,
                               LabelSettings labelSettings) {
-	return morphism(rDom, rCodom, maxNumMatches, labelSettings, lib::GraphMorphism::VF2Isomorphism());
+	return morphism(rDom, rCodom, maxNumMatches, labelSettings, lib::GraphMorphism::ConfiguredIsomorphism());
 }
 
 std::size_t Rule::monomorphism(const Rule &rDom,
                                const Rule &rCodom,
                                std::size_t maxNumMatches,
                                LabelSettings labelSettings) {
-	return morphism(rDom, rCodom, maxNumMatches, labelSettings, lib::GraphMorphism::VF2Monomorphism());
+	return morphism(rDom, rCodom, maxNumMatches, labelSettings, lib::GraphMorphism::ConfiguredMonomorphism());
 }
 
 bool Rule::isomorphicLeftRight(const Rule &rDom, const Rule &rCodom, LabelSettings labelSettings) {
@@ -276,4 +281,50 @@ bool Rule::isomorphicLeftRight(const Rule &rDom, const Rule &rCodom, LabelSettin
 	return mrRight.getNumHits() == 1;
 }
 
+std::size_t Rule::getIsomorphismInvariant(LabelType labelType) const {
+	const auto &g = get_graph(dpoRule);
+	// each element is hashed by its membership and its label(s)
+	const auto hashLabels = [&g](const auto ve, const auto &pLabel, auto labelHash) {
+		std::size_t res = static_cast<std::size_t>(g[ve].membership);
+		const auto labels = pLabel[ve];
+		if(labels.first) boost::hash_combine(res, labelHash(*labels.first));
+		if(labels.second) boost::hash_combine(res, labelHash(*labels.second));
+		return res;
+	};
+	const auto structureHash = [&]() -> std::size_t {
+		switch(labelType) {
+		case LabelType::String: {
+			const auto &pString = get_string(dpoRule);
+			return lib::GraphMorphism::hashWL(g, [&](const auto ve) {
+				std::size_t res = static_cast<std::size_t>(g[ve].membership);
+				const auto ids = getLabelId(pString, ve);
+				boost::hash_combine(res, ids.first);
+				boost::hash_combine(res, ids.second);
+				return res;
+			});
+		}
+		case LabelType::Term: {
+			const auto &pTerm = get_term(dpoRule);
+			if(!isValid(pTerm)) {
+				return lib::GraphMorphism::hashWL(g, [&](const auto ve) {
+					return static_cast<std::size_t>(g[ve].membership);
+				});
+			}
+			const auto &machine = getMachine(pTerm);
+			return lib::GraphMorphism::hashWL(g, [&](const auto ve) {
+				return hashLabels(ve, pTerm, [&machine](std::size_t addr) {
+					return lib::GraphMorphism::hashTermModuloRenaming(machine, {lib::Term::AddressType::Heap, addr});
+				});
+			});
+		}
+		}
+		MOD_ABORT;
+	}();
+	// the numbers of connected components on each side are not captured by the few refinement rounds
+	std::size_t res = get_num_connected_components(get_labelled_left(dpoRule));
+	boost::hash_combine(res, get_num_connected_components(get_labelled_right(dpoRule)));
+	boost::hash_combine(res, structureHash);
+	return res;
+}
+
 } // namespace mod::lib::rule
\ No newline at end of file
@@ -70,6 +70,9 @@ public:
 	static bool isomorphicLeftRight(const Rule &rDom,
 	                                const Rule &rCodom,
 	                                LabelSettings labelSettings);
+	// A hash which is equal for isomorphic rules with the given label type (ignoring stereo-information),
+	// to avoid most isomorphism checks between non-isomorphic rules.
+	std::size_t getIsomorphismInvariant(LabelType labelType) const;
 private:
 	const std::size_t id;
 	std::weak_ptr<mod::rule::Rule> apiReference;
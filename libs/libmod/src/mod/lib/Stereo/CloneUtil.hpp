@@ -24,7 +24,8 @@ public:
 		if(conf.getFixation() == lib::Stereo::Fixation::free()) {
 			return conf.cloneFree(lib::Stereo::getGeometryGraph());
 		} else {
-			std::vector<std::size_t> offsetMap(out_degree(vDom, gDom));
+			// reuse the buffer, as this is called for every vertex of, e.g., every product of a rule application
+			offsetMap.assign(out_degree(vDom, gDom), 0);
 			assert(out_degree(vDom, gDom) == out_degree(vCodom, gCodom));
 			std::size_t offsetCodom = 0;
 			for(const auto eOutCodom : asRange(out_edges(vCodom, gCodom))) {
@@ -56,6 +57,7 @@ private:
 	const GraphCodom &gCodom;
 	InverseVertexMorphism mInverseVertex;
 	InverseEdgeMorphism mInverseEdge;
+	mutable std::vector<std::size_t> offsetMap;
 };
 
 template<typename LGraphDom, typename GraphCodom, typename InverseVertexMorphism, typename InverseEdgeMorphism>
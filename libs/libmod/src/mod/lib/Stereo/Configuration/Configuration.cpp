@@ -127,8 +127,6 @@ std::string Configuration::asRawStringImpl(std::function<std::size_t(const Embed
 //------------------------------------------------------------------------------
 
 DynamicDegree::DynamicDegree(GeometryGraph::Vertex vGeometry, const EmbeddingEdge *b, const EmbeddingEdge *e)
-: Configuration(vGeometry, b, e) {
-	std::copy(b, e, std::back_inserter(edges));
-}
+: Configuration(vGeometry, b, e), edges(b, e) { }
 
 } // namespace mod::lib::Stereo
\ No newline at end of file
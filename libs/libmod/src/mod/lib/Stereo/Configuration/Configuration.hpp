@@ -103,7 +103,7 @@ public:
 		return edges.data() + edges.size();
 	}
 protected:
-	std::vector<EmbeddingEdge> edges;
+	EmbeddingEdges edges;
 };
 
 template<std::size_t d>
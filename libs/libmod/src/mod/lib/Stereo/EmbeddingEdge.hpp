@@ -3,6 +3,7 @@
 
 #include <mod/lib/Stereo/EdgeCategory.hpp>
 
+#include <boost/container/small_vector.hpp>
 #include <boost/graph/graph_traits.hpp>
 
 namespace mod::lib::Stereo {
@@ -29,6 +30,10 @@ public:
 	EdgeCategory cat;
 };
 
+// The embedding of a single vertex, stored inline for the common degrees,
+// so a vector of per-vertex data keeps all embeddings of a graph in one contiguous block.
+using EmbeddingEdges = boost::container::small_vector<EmbeddingEdge, 4>;
+
 } // namespace mod::lib::Stereo
 
 #endif // MOD_LIB_STEREO_EMBEDDINGEDGE_HPP
\ No newline at end of file
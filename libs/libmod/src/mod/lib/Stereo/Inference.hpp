@@ -19,7 +19,7 @@ namespace mod::lib::Stereo {
 struct InferenceVertexData {
 	GeometryGraph::Vertex vGeometry = GeometryGraph::nullGeometry();
 	int nextAvailableVirtual;
-	std::vector<EmbeddingEdge> edges;
+	EmbeddingEdges edges;
 	bool explicitEmbedding = false;
 	Fixation fix = Fixation::free();
 public:
@@ -1,39 +1,36 @@
 #include "StringStore.hpp"
 
 #include <cassert>
-#include <iostream>
+#include <mutex>
 
 namespace mod::lib {
 
 bool StringStore::hasString(const std::string &s) const {
+	std::shared_lock lock(mtx);
 	return index.find(s) != end(index);
 }
 
 std::size_t StringStore::getIndex(const std::string &s) const {
-	struct DoPrint {
-		DoPrint(const StringStore &store, const std::string &s) : store(store), s(s) {}
-
-		~DoPrint() {
-			std::cout << "StringStore getIndex(" << s << ")" << std::endl;
-			std::cout << "================================================" << std::endl;
-			for(const auto &p : store.index) {
-				assert(p.second < store.strings.size());
-				assert(store.strings[p.second] == p.first);
-				std::cout << "\t" << p.second << " -> " << p.first << std::endl;
-			}
-		}
-	private:
-		const StringStore &store;
-		const std::string &s;
-	} /*doPrint(*this, s)*/;
+	{
+		std::shared_lock lock(mtx);
+		const auto iter = index.find(s);
+		if(iter != end(index)) return iter->second;
+	}
+	std::unique_lock lock(mtx);
 	auto pIter = index.emplace(s, strings.size());
 	if(pIter.second) strings.push_back(s);
 	return pIter.first->second;
 }
 
 const std::string &StringStore::getString(std::size_t index) const {
+	std::shared_lock lock(mtx);
 	assert(index < strings.size());
 	return strings[index];
 }
 
-} // namespace mod::lib
\ No newline at end of file
+const StringStore &getLabelStrings() {
+	static StringStore strings;
+	return strings;
+}
+
+} // namespace mod::lib
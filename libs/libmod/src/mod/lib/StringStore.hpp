@@ -1,12 +1,17 @@
 #ifndef MOD_LIB_STRINGSTORE_HPP
 #define MOD_LIB_STRINGSTORE_HPP
 
-#include <map>
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
 #include <string>
-#include <vector>
+#include <unordered_map>
 
 namespace mod::lib {
 
+// An interning table for strings.
+// All member functions may be called concurrently,
+// and references returned by getString stay valid for the lifetime of the store.
 struct StringStore {
 	StringStore() = default;
 	StringStore(const StringStore&) = delete;
@@ -17,10 +22,21 @@ struct StringStore {
 	std::size_t getIndex(const std::string &s) const;
 	const std::string &getString(std::size_t index) const;
 private:
-	mutable std::vector<std::string> strings;
-	mutable std::map<std::string, std::size_t> index;
+	mutable std::shared_mutex mtx;
+	mutable std::deque<std::string> strings;
+	mutable std::unordered_map<std::string, std::size_t> index;
 };
 
+// The store for the vertex and edge labels of graphs and rules.
+// The string properties keep the index of each label, so labels can be compared as integers.
+const StringStore &getLabelStrings();
+
+using LabelId = std::uint32_t;
+
+inline LabelId internLabel(const std::string &label) {
+	return static_cast<LabelId>(getLabelStrings().getIndex(label));
+}
+
 } // namespace mod::lib
 
-#endif // MOD_LIB_STRINGSTORE_HPP
\ No newline at end of file
+#endif // MOD_LIB_STRINGSTORE_HPP
@@ -94,12 +94,19 @@ public:
 struct Wam;
 
 struct MGU {
+	// A point in the trail of an MGU which can be returned to with Wam::undo.
+	struct Mark {
+		std::size_t heapSize, numBindings, numOverwritten;
+	};
+public:
 	MGU(std::size_t preHeapSize) : preHeapSize(preHeapSize) {}
 	bool isRenaming(const Wam &machine) const;
 	bool isSpecialisation(const Wam &machine) const;
 public:
 	std::size_t preHeapSize;
 	std::vector<Address> bindings; // stack of addresses of REFs that were self-references before
+	// stack of temp cells that were overwritten with pointers into the heap, and their previous value
+	std::vector<std::pair<Address, Cell>> overwritten;
 	enum class Status {
 		Exists, Fail
 	} status = Status::Exists;
@@ -277,10 +284,38 @@ struct Wam {
 			assert(c.REF.addr != a);
 			c.REF.addr = a;
 		}
+		for(auto iter = mgu.overwritten.rbegin(); iter != mgu.overwritten.rend(); ++iter)
+			getCell(iter->first) = iter->second;
 		assert(heap.size() >= mgu.preHeapSize);
 		heap.resize(mgu.preHeapSize);
 	}
 
+	MGU::Mark mark(const MGU &mgu) const {
+		assert(mgu.status == MGU::Status::Exists);
+		return {heap.size(), mgu.bindings.size(), mgu.overwritten.size()};
+	}
+
+	// Undo the unifications recorded in the MGU after the mark was made, also if they failed,
+	// and remove them from the MGU.
+	// This makes it possible to unify incrementally with a single machine instead of copying it for each attempt.
+	void undo(MGU &mgu, MGU::Mark m) {
+		assert(mgu.bindings.size() >= m.numBindings);
+		assert(mgu.overwritten.size() >= m.numOverwritten);
+		assert(heap.size() >= m.heapSize);
+		for(std::size_t i = mgu.bindings.size(); i != m.numBindings; --i) {
+			const Address a = mgu.bindings[i - 1];
+			Cell &c = getCell(a);
+			assert(c.tag == Cell::Tag::REF);
+			c.REF.addr = a;
+		}
+		mgu.bindings.resize(m.numBindings);
+		for(std::size_t i = mgu.overwritten.size(); i != m.numOverwritten; --i)
+			getCell(mgu.overwritten[i - 1].first) = mgu.overwritten[i - 1].second;
+		mgu.overwritten.resize(m.numOverwritten);
+		heap.resize(m.heapSize);
+		mgu.status = MGU::Status::Exists;
+	}
+
 	void appendHeapFrom(const Wam &mOther) {
 		const int offset = heap.size();
 		heap.reserve(heap.size() + mOther.heap.size());
@@ -437,6 +472,7 @@ inline void Wam::unifyHeapTemp(std::size_t lhsIndex, std::size_t rhsIndex, MGU &
 					getCell(lhsAddr).REF.addr = rhsAddrNew;
 					mgu.bindings.push_back(lhsAddr);
 					// overwrite rhs
+					mgu.overwritten.emplace_back(rhsAddr, rhsCell);
 					getCell(rhsAddr).tag = Cell::Tag::STR;
 					getCell(rhsAddr).STR.addr = rhsAddrNew;
 					// copy arguments
@@ -452,6 +488,7 @@ inline void Wam::unifyHeapTemp(std::size_t lhsIndex, std::size_t rhsIndex, MGU &
 						case Cell::Tag::Structure:
 							assert(rhsSubCell.Structure.arity == 0);
 							// overwrite rhs and append structure
+							mgu.overwritten.emplace_back(rhsSubAddr, rhsSubCell);
 							getCell(rhsSubAddr).tag = Cell::Tag::STR;
 							getCell(rhsSubAddr).STR.addr = putStructure(rhsSubCell.Structure.name, rhsSubCell.Structure.arity);
 							break;
@@ -463,6 +500,7 @@ inline void Wam::unifyHeapTemp(std::size_t lhsIndex, std::size_t rhsIndex, MGU &
 						for(std::size_t i = lhsCell.Structure.arity; i > 0; i--)
 							stack.emplace(lhsAddr + i, rhsAddr + i);
 						// overwrite rhs to point to heap
+						mgu.overwritten.emplace_back(rhsAddr, rhsCell);
 						getCell(rhsAddr).tag = Cell::Tag::STR;
 						getCell(rhsAddr).STR.addr = lhsAddr;
 					} else {
@@ -2,9 +2,10 @@
 import collections.abc
 import ctypes
 import inspect
+import json
 import sys
 from typing import (
-	Any, Callable, cast, Iterable, List, Optional, Sequence,
+	Any, Callable, cast, Dict, Iterable, List, Optional, Sequence,
 	TextIO, Tuple, Type, Union
 )
 
@@ -412,6 +413,10 @@ def _DGExecuteResult_list(self: DG.Builder.ExecuteResult, *, withUniverse: bool=
 	return _DGExecuteResult_list_orig(self, withUniverse)  # type: ignore
 DG.Builder.ExecuteResult.list = _DGExecuteResult_list  # type: ignore
 
+def _DGExecuteResult_getStats(self: DG.Builder.ExecuteResult) -> Dict[str, Any]:
+	return json.loads(self.getStatsJson())  # type: ignore
+DG.Builder.ExecuteResult.getStats = _DGExecuteResult_getStats  # type: ignore
+
 
 #----------------------------------------------------------
 # DG.HyperEdge
@@ -516,7 +521,9 @@ def _DGStrat_makeParallel(l: Iterable[DGStrat]) -> DGStrat:
 DGStrat.makeParallel = _DGStrat_makeParallel  # type: ignore
 
 _DGStrat_makeFilter_orig = DGStrat.makeFilter
-def _DGStrat_makeFilter(alsoUniverse: bool, filterFunc: Callable[[Graph, DGStrat.GraphState, bool], bool]) -> DGStrat:
+def _DGStrat_makeFilter(alsoUniverse: bool, filterFunc: Union[Callable[[Graph, DGStrat.GraphState, bool], bool], GraphPredicate]) -> DGStrat:
+	if isinstance(filterFunc, GraphPredicate):
+		return _DGStrat_makeFilter_orig(alsoUniverse, filterFunc)
 	return _DGStrat_makeFilter_orig(alsoUniverse, _funcWrap(libpymod._Func_BoolGraphDGStratGraphStateBool, filterFunc))
 DGStrat.makeFilter = _DGStrat_makeFilter  # type: ignore
 
@@ -526,15 +533,38 @@ def _DGStrat_makeExecute(func: Callable[[DGStrat.GraphState], None]) -> DGStrat:
 DGStrat.makeExecute = _DGStrat_makeExecute  # type: ignore
 
 _DGStrat_makeLeftPredicate_orig = DGStrat.makeLeftPredicate
-def _DGStrat_makeLeftPredicate(pred: Callable[[Derivation], bool], strat: DGStrat) -> DGStrat:
+def _DGStrat_makeLeftPredicate(pred: Union[Callable[[Derivation], bool], GraphPredicate], strat: DGStrat) -> DGStrat:
+	if isinstance(pred, GraphPredicate):
+		return _DGStrat_makeLeftPredicate_orig(pred, strat)
 	return _DGStrat_makeLeftPredicate_orig(_funcWrap(libpymod._Func_BoolDerivation, pred), strat)
 DGStrat.makeLeftPredicate = _DGStrat_makeLeftPredicate  # type: ignore
 
 _DGStrat_makeRightPredicate_orig = DGStrat.makeRightPredicate
-def _DGStrat_makeRightPredicate(pred: Callable[[Derivation], bool], strat: DGStrat) -> DGStrat:
+def _DGStrat_makeRightPredicate(pred: Union[Callable[[Derivation], bool], GraphPredicate], strat: DGStrat) -> DGStrat:
+	if isinstance(pred, GraphPredicate):
+		return _DGStrat_makeRightPredicate_orig(pred, strat)
 	return _DGStrat_makeRightPredicate_orig(_funcWrap(libpymod._Func_BoolDerivation, pred), strat)
 DGStrat.makeRightPredicate = _DGStrat_makeRightPredicate  # type: ignore
 
+_DGStrat_makeBestFirst_orig = DGStrat.makeBestFirst
+def _DGStrat_makeBestFirst(score: Union[Callable[[Graph], float], GraphValue], strat: DGStrat,
+		targets: Iterable[Graph], maxExpansions: int, maxVertices: int, maxDerivations: int,
+		timeLimit: float) -> DGStrat:
+	if not isinstance(score, GraphValue):
+		score = _funcWrap(libpymod._Func_DoubleGraph, score)
+	return _DGStrat_makeBestFirst_orig(score, strat, _wrap(libpymod._VecGraph, targets),
+		maxExpansions, maxVertices, maxDerivations, timeLimit)
+DGStrat.makeBestFirst = _DGStrat_makeBestFirst  # type: ignore
+
+def _makeGraphsCall(orig: Any) -> Any:
+	def call(self: Any, g: Union[Graph, Iterable[Graph]]) -> Any:
+		if g is None or isinstance(g, Graph):
+			return orig(self, g)
+		return orig(self, _wrap(libpymod._VecGraph, g))
+	return call
+GraphValue.__call__ = _makeGraphsCall(GraphValue.__call__)  # type: ignore
+GraphPredicate.__call__ = _makeGraphsCall(GraphPredicate.__call__)  # type: ignore
+
 
 #----------------------------------------------------------
 # DG Strategy Prettification
@@ -650,6 +680,15 @@ repeat = _DGStrat_RepeatProxy()
 def revive(s):
 	return DGStrat.makeRevive(dgStrat(s))
 
+# bestFirst
+#----------------------------------------------------------
+
+def bestFirst(score: Union[Callable[[Graph], float], GraphValue], strat: _DGStratType, *,
+		targets: Iterable[Graph]=[], maxExpansions: int=0, maxVertices: int=0, maxDerivations: int=0,
+		timeLimit: float=0) -> DGStrat:
+	return DGStrat.makeBestFirst(score, dgStrat(strat), targets,
+		maxExpansions, maxVertices, maxDerivations, timeLimit)
+
 # sequence
 #----------------------------------------------------------
 
@@ -758,6 +797,9 @@ _Graph_fromSDString_orig       = Graph.fromSDString
 _Graph_fromSDFile_orig         = Graph.fromSDFile
 _Graph_fromSDStringMulti_orig  = Graph.fromSDStringMulti
 _Graph_fromSDFileMulti_orig    = Graph.fromSDFileMulti
+_Graph_fromSMILESFileBatch_orig = Graph.fromSMILESFileBatch
+_Graph_fromSDFileBatch_orig     = Graph.fromSDFileBatch
+_Graph_fromGMLFileBatch_orig    = Graph.fromGMLFileBatch
 
 def _Graph_fromGMLString(     s: str, name: Optional[str] = None,                                     add: bool = True, printStereoWarnings: bool = True) -> Graph:
 	return _graphLoad(_Graph_fromGMLString_orig(                   s         , printStereoWarnings), name, add)
@@ -793,6 +835,13 @@ def _Graph_fromSDStringMulti( s: str,                             options: MDLOp
 	return _graphssLoad(_Graph_fromSDStringMulti_orig(             s,  options                    ),       add)
 def _Graph_fromSDFileMulti(   f: str,                             options: MDLOptions = MDLOptions(), add: bool = True) -> List[List[Graph]]:
 	return _graphssLoad(_Graph_fromSDFileMulti_orig(prefixFilename(f), options                    ),       add)
+def _Graph_fromSMILESFileBatch(f: str,                             allowAbstract: bool = False, classPolicy: SmilesClassPolicy = SmilesClassPolicy.NoneOnDuplicate,
+                                                                                                      add: bool = True, printStereoWarnings: bool = True) -> List[Graph]:
+	return _graphsLoad(_Graph_fromSMILESFileBatch_orig(prefixFilename(f), allowAbstract, classPolicy, printStereoWarnings), add)
+def _Graph_fromSDFileBatch(   f: str,                             options: MDLOptions = MDLOptions(), add: bool = True) -> List[Graph]:
+	return _graphsLoad(_Graph_fromSDFileBatch_orig(   prefixFilename(f), options                    ),       add)
+def _Graph_fromGMLFileBatch(  fs: Iterable[str],                                                      add: bool = True, printStereoWarnings: bool = True) -> List[Graph]:
+	return _graphsLoad(_Graph_fromGMLFileBatch_orig(_wrap(libpymod._VecString, (prefixFilename(f) for f in fs)), printStereoWarnings), add)
 
 Graph.fromGMLString      = _Graph_fromGMLString  # type: ignore
 Graph.fromGMLFile        = _Graph_fromGMLFile  # type: ignore
@@ -810,6 +859,9 @@ Graph.fromSDString       = _Graph_fromSDString  # type: ignore
 Graph.fromSDFile         = _Graph_fromSDFile  # type: ignore
 Graph.fromSDStringMulti  = _Graph_fromSDStringMulti  # type: ignore
 Graph.fromSDFileMulti    = _Graph_fromSDFileMulti  # type: ignore
+Graph.fromSMILESFileBatch = _Graph_fromSMILESFileBatch  # type: ignore
+Graph.fromSDFileBatch     = _Graph_fromSDFileBatch  # type: ignore
+Graph.fromGMLFileBatch    = _Graph_fromGMLFileBatch  # type: ignore
 
 graphGMLString = Graph.fromGMLString
 graphGML       = Graph.fromGMLFile
@@ -1,5 +1,5 @@
 import enum
-from typing import Callable, Iterable, List, Optional, overload, Tuple, TypeVar, Union
+from typing import Any, Callable, Dict, Iterable, List, Optional, overload, Tuple, TypeVar, Union
 
 T = TypeVar("T")
 U = TypeVar("U")
@@ -61,6 +61,8 @@ class _Func_BoolGraph:
 	def __call__(self, g: Graph) -> bool: ...
 class _Func_IntGraph:
 	def __call__(self, g: Graph) -> int: ...
+class _Func_DoubleGraph:
+	def __call__(self, g: Graph) -> float: ...
 
 class _Func_StringGraphDGBool:
 	def __call__(self, g: Graph, dg: DG, first: bool) -> str: ...
@@ -192,6 +194,8 @@ class DG:
 
 		class ExecuteResult:
 			def list(self, *, withUniverse: bool=...) -> None: ...
+			def getStatsJson(self) -> str: ...
+			def getStats(self) -> Dict[str, Any]: ...
 
 		class AddAbstractResult:
 			def getGraph(self, name: str) -> Optional[Graph]: ...
@@ -228,19 +232,67 @@ class DGStrat:
 	@staticmethod
 	def makeParallel(strats: List[DGStrat]) -> DGStrat: ...
 	@staticmethod
-	def makeFilter(alsoUniverse: bool, p: Callable[[Graph, GraphState, bool], bool]) -> DGStrat: ...
+	def makeFilter(alsoUniverse: bool, p: Union[Callable[[Graph, GraphState, bool], bool], GraphPredicate]) -> DGStrat: ...
 	@staticmethod
 	def makeExecute(func: Callable[[GraphState], None]) -> DGStrat: ...
 	@staticmethod
 	def makeRule(rule: Rule) -> DGStrat: ...
 	@staticmethod
-	def makeLeftPredicate(p: Callable[[Derivation], bool], strat: DGStrat) -> DGStrat: ...
+	def makeLeftPredicate(p: Union[Callable[[Derivation], bool], GraphPredicate], strat: DGStrat) -> DGStrat: ...
 	@staticmethod
-	def makeRightPredicate(p: Callable[[Derivation], bool], strat: DGStrat) -> DGStrat: ...
+	def makeRightPredicate(p: Union[Callable[[Derivation], bool], GraphPredicate], strat: DGStrat) -> DGStrat: ...
 	@staticmethod
 	def makeRevive(strat: DGStrat) -> DGStrat: ...
 	@staticmethod
 	def makeRepeat(limit: int, strat: DGStrat) -> DGStrat: ...
+	@staticmethod
+	def makeBestFirst(score: Union[Callable[[Graph], float], GraphValue], strat: DGStrat, targets: List[Graph],
+			maxExpansions: int, maxVertices: int, maxDerivations: int, timeLimit: float) -> DGStrat: ...
+
+class GraphValue:
+	def __call__(self, g: Union[Graph, Iterable[Graph]]) -> float: ...
+	def __lt__(self, c: float) -> GraphPredicate: ...  # type: ignore
+	def __le__(self, c: float) -> GraphPredicate: ...  # type: ignore
+	def __gt__(self, c: float) -> GraphPredicate: ...  # type: ignore
+	def __ge__(self, c: float) -> GraphPredicate: ...  # type: ignore
+	def __eq__(self, c: float) -> GraphPredicate: ...  # type: ignore
+	def __ne__(self, c: float) -> GraphPredicate: ...  # type: ignore
+	@staticmethod
+	def numVertices() -> GraphValue: ...
+	@staticmethod
+	def numEdges() -> GraphValue: ...
+	@staticmethod
+	def numComponents() -> GraphValue: ...
+	@staticmethod
+	def numRings() -> GraphValue: ...
+	@staticmethod
+	def vertexLabelCount(label: str) -> GraphValue: ...
+	@staticmethod
+	def edgeLabelCount(label: str) -> GraphValue: ...
+	@staticmethod
+	def exactMass() -> GraphValue: ...
+	@staticmethod
+	def charge() -> GraphValue: ...
+	@staticmethod
+	def numChargedVertices() -> GraphValue: ...
+	@staticmethod
+	def numRadicals() -> GraphValue: ...
+	@staticmethod
+	def energy() -> GraphValue: ...
+	@staticmethod
+	def massDistance(target: Graph) -> GraphValue: ...
+	@staticmethod
+	def vertexLabelDistance(target: Graph) -> GraphValue: ...
+
+class GraphPredicate:
+	def __call__(self, g: Union[Graph, Iterable[Graph]]) -> bool: ...
+	def __and__(self, other: GraphPredicate) -> GraphPredicate: ...
+	def __or__(self, other: GraphPredicate) -> GraphPredicate: ...
+	def __invert__(self) -> GraphPredicate: ...
+	@staticmethod
+	def makeAll(p: GraphPredicate) -> GraphPredicate: ...
+	@staticmethod
+	def makeAny(p: GraphPredicate) -> GraphPredicate: ...
 
 
 #-----------------------------------------------------------------------------
@@ -297,6 +297,9 @@ void Config_doExport() {
 				.value("VF2", mod::Config::IsomorphismAlg::VF2)
 				.value("Canon", mod::Config::IsomorphismAlg::Canon)
 				.value("SmilesCanonVF2", mod::Config::IsomorphismAlg::SmilesCanonVF2);
+		py::enum_<Config::MorphismFinder>("MorphismFinder")
+				.value("VF2", mod::Config::MorphismFinder::VF2)
+				.value("VF2PP", mod::Config::MorphismFinder::VF2PP);
 
 #define NSIter(rNS, dataNS, tNS)                                                                        \
    py::class_<Config:: BOOST_PP_TUPLE_ELEM(MOD_CONFIG_DATA_NS_SIZE(), 0, tNS), boost::noncopyable>      \
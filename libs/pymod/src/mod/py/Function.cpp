@@ -35,6 +35,7 @@ void Function_doExport() {
 	// Graph -> X
 	exportFunc<bool(std::shared_ptr<mod::graph::Graph>)>("_Func_BoolGraph");
 	exportFunc<int(std::shared_ptr<mod::graph::Graph>)>("_Func_IntGraph");
+	exportFunc<double(std::shared_ptr<mod::graph::Graph>)>("_Func_DoubleGraph");
 	exportFunc<std::string(std::shared_ptr<mod::graph::Graph>)>("_Func_StringGraph");
 	// Graph x Strategy::GraphState -> X
 	exportFunc<bool(std::shared_ptr<mod::graph::Graph>, const dg::Strategy::GraphState &)>(
@@ -13,7 +13,7 @@
 #define MOD_NAMESPACED_FILES()                                                   \
    ((graph, (Printer))) /* this must be before DGGraphInterface due to default arg */ \
    /* DG first, as others makes nested classes */                                \
-   ((dg, (DG) (Builder) (GraphInterface) (Printer) (Strategy) (VertexMapper)))   \
+   ((dg, (DG) (Builder) (GraphInterface) (Printer) (Strategy) (GraphPredicate) (VertexMapper))) \
    ((graph, (Graph) (Union)))                                                    \
    ((graph, (Automorphism) (GraphInterface))) /* nested classes of Graph, so must be after */ \
    ((rule, (CompositionMatch) (Composition) (Rule) (GraphInterface)))            \
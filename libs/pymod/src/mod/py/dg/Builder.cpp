@@ -74,7 +74,7 @@ void Builder_doExport() {
 					// rst:			:raises: :class:`LogicError` if ``graphPolicy == IsomorphismPolicy.Check`` and a given graph object
 					// rst:				is different but isomorphic to another given graph object or to a graph object already
 					// rst:				in the internal graph database in the associated derivation graph.
-			.def("addDerivation", static_cast<AddDerivation>(&Builder::addDerivation))
+			.def("addDerivation", mod::Py::withoutGIL<static_cast<AddDerivation>(&Builder::addDerivation)>)
 					// rst:		.. method:: addHyperEdge(e, graphPolicy=IsomorphismPolicy.Check)
 					// rst:
 					// rst:			Adds a hyperedge to the associated :class:`DG` from a copy of the given hyperedge
@@ -117,7 +117,7 @@ void Builder_doExport() {
 					// rst:			:throws: :class:`LogicError`: if ``ignoreRuleLabelTypes`` is ``False``, which is the default,
 					// rst:				and a rule in the given strategy has an associated :class:`LabelType` which is different from the one
 					// rst:				in the derivation graph.
-			.def("execute", &Builder_execute)
+			.def("execute", mod::Py::withoutGIL<&Builder_execute>)
 					// rst:		.. method:: apply(graphs, r, onlyProper=True, verbosity=0, graphPolicy=IsomorphismPolicy.Check)
 					// rst:
 					// rst:			Compute direct derivations.
@@ -139,7 +139,7 @@ void Builder_doExport() {
 					// rst:			:raises: :class:`LogicError` if ``graphPolicy == IsomorphismPolicy.Check`` and a given graph object
 					// rst:				is different but isomorphic to another given graph object or to a graph object already
 					// rst:				in the internal graph database in the associated derivation graph.
-			.def("apply", static_cast<Apply>(&Builder::apply))
+			.def("apply", mod::Py::withoutGIL<static_cast<Apply>(&Builder::apply)>)
 					// rst:		.. method:: addAbstract(description)
 					// rst:
 					// rst:			Add vertices and hyperedges based on the given abstract description.
@@ -174,7 +174,7 @@ void Builder_doExport() {
 					// rst:			:raises: :class:`LogicError` if there is a ``None`` in ``ruleDatabase``.
 					// rst:			:raises: :class:`LogicError` if the label settings of the dump does not match those of this DG.
 					// rst: 		:raises: :class:`InputError` if the file can not be opened or its content is bad.
-			.def("load", &Builder::load);
+			.def("load", mod::Py::withoutGIL<&Builder::load>);
 
 	py::scope Builderscope = BuilderObj;
 	// rst: .. class:: DG.Builder.ExecuteResult
@@ -198,7 +198,19 @@ void Builder_doExport() {
 					// rst:			Output information from the execution of the strategy.
 					// rst:
 					// rst:			:param bool withUniverse: The universe lists can be rather long. As default, they are omitted when listing.
-			.def("list", &ExecuteResult::list);
+			.def("list", &ExecuteResult::list)
+					// rst:		.. method:: getStatsJson()
+					// rst:
+					// rst:			:returns: statistics for the execution of the strategy, encoded as JSON.
+					// rst:				See :cpp:func:`dg::ExecuteResult::getStatsJson` for the format.
+					// rst:			:rtype: str
+					// rst:			:throws: :class:`LogicError` if ``config.dg.collectStats`` was ``False``
+					// rst:				when the strategy was executed.
+					// rst:		.. method:: getStats()
+					// rst:
+					// rst:			:returns: the statistics from :meth:`getStatsJson`, decoded with :func:`json.loads`.
+					// rst:			:rtype: dict
+			.def("getStatsJson", &ExecuteResult::getStatsJson);
 
 	// rst: .. class:: DG.Builder.AddAbstractResult
 	// rst:
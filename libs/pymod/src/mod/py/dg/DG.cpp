@@ -199,6 +199,8 @@ void DG_doExport() {
 					// rst:
 					// rst:			Exports the derivation graph to a file, including associated graphs and rules.
 					// rst:			Use :meth:`load` or :meth:`DG.Builder.load` to import the derivation graph again.
+					// rst:			The dump is written in a compact binary format, unless ``config.dg.dumpAsJson`` is set,
+					// rst:			in which case the older JSON-based format is used. Both formats can be loaded.
 					// rst:
 					// rst:			:param str filename: the name of the file to save the dump to.
 					// rst:				If non is given an auto-generated name in the ``out/`` folder is used.
@@ -210,11 +212,12 @@ void DG_doExport() {
 					// rst:			:rtype: str
 					// rst:			:raises: :class:`LogicError` if the DG is not :attr:`locked`.
 					// rst:			:raises: :class:`LogicError` if the target file can not be opened.
-			.def("dump", static_cast<std::string (DG::*)() const>(&DG::dump))
-			.def("dump", static_cast<std::string (DG::*)(const std::string &) const>(&DG::dump))
+			.def("dump", mod::Py::withoutGIL<static_cast<std::string (DG::*)() const>(&DG::dump)>)
+			.def("dump", mod::Py::withoutGIL<static_cast<std::string (DG::*)(const std::string &) const>(&DG::dump)>)
 					// rst:		.. method:: listStats()
 					// rst:
-					// rst:			Lists various statistics for the derivation graph.
+					// rst:			Lists various statistics for the derivation graph,
+					// rst:			including the index of the graph database and the cache of component matches.
 					// rst:
 					// rst:			:raises: :class:`LogicError` if the DG has not been calculated.
 			.def("listStats", &DG::listStats)
@@ -249,7 +252,7 @@ void DG_doExport() {
 					// rst:			:raises: the same exceptions :func:`__init__` raises related to ``graphDatabase`` and ``graphPolicy``.
 					// rst:			:raises: :class:`LogicError` if there is a ``None`` in ``ruleDatabase``.
 					// rst:			:raises: :class:`InputError` if the file can not be opened or its content is bad.
-			.def("load", static_cast<Load>(&DG::load))
+			.def("load", mod::Py::withoutGIL<static_cast<Load>(&DG::load)>)
 			.staticmethod("load");
 
 	// rst: .. method:: diffDGs(dg1, dg2)
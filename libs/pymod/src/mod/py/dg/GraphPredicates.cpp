@@ -0,0 +1,149 @@
+#include <mod/py/Common.hpp>
+
+#include <mod/dg/GraphPredicates.hpp>
+#include <mod/graph/Graph.hpp>
+
+// rst: Native predicates on graphs and on the sides of derivations, for use with
+// rst: :func:`DGStrat.makeFilter`, :func:`DGStrat.makeLeftPredicate`, and :func:`DGStrat.makeRightPredicate`,
+// rst: and thereby also with :func:`filterSubset`, :func:`filterUniverse`, :data:`leftPredicate`, and :data:`rightPredicate`.
+// rst: They are evaluated entirely in the library, without calling back into Python,
+// rst: and the per-graph values are computed only once for each graph.
+// rst: A predicate is built by comparing a :class:`GraphValue` with a number,
+// rst: and combining such comparisons with ``&``, ``|``, and ``~``. For example:
+// rst:
+// rst: .. code-block:: python
+// rst:
+// rst:    small = (GraphValue.vertexLabelCount("C") <= 7) & (GraphValue.exactMass() < 200)
+// rst:    dg.build().execute(filterUniverse(small) >> rightPredicate[GraphPredicate.makeAll(small)](rules))
+// rst:
+
+namespace mod::dg::Py {
+
+void GraphPredicate_doExport() {
+	double (GraphValue::*valueGraph)(std::shared_ptr<mod::graph::Graph>) const = &GraphValue::operator();
+	double (GraphValue::*valueGraphs)(const std::vector<std::shared_ptr<mod::graph::Graph>> &) const
+	= &GraphValue::operator();
+	bool (GraphPredicate::*predGraph)(std::shared_ptr<mod::graph::Graph>) const = &GraphPredicate::operator();
+	bool (GraphPredicate::*predGraphs)(const std::vector<std::shared_ptr<mod::graph::Graph>> &) const
+	= &GraphPredicate::operator();
+
+	// rst: .. class:: GraphValue
+	// rst:
+	// rst:		A quantity of a multiset of graphs, e.g., a side of a derivation.
+	// rst:		The value of a multiset is the sum of the values of its graphs,
+	// rst:		and a single graph is evaluated as a multiset with only that graph.
+	// rst:		Comparing a value with a number using ``<``, ``<=``, ``>``, ``>=``, ``==``, or ``!=``
+	// rst:		gives a :class:`GraphPredicate`.
+	// rst:
+	py::class_<GraphValue>("GraphValue", py::no_init)
+			.def(str(py::self))
+			.def(py::self < double())
+			.def(py::self <= double())
+			.def(py::self > double())
+			.def(py::self >= double())
+			.def(py::self == double())
+			.def(py::self != double())
+					// rst:		.. method:: __call__(g)
+					// rst:
+					// rst:			:param g: the graph or graphs to evaluate the value on.
+					// rst:			:type g: Graph or list[Graph]
+					// rst:			:returns: the value of the given graph or multiset of graphs.
+					// rst:			:rtype: float
+			.def("__call__", valueGraph)
+			.def("__call__", valueGraphs)
+					// rst:		.. staticmethod:: numVertices()
+					// rst:		                  numEdges()
+					// rst:
+					// rst:			:returns: the number of vertices, respectively edges.
+					// rst:			:rtype: GraphValue
+			.def("numVertices", &GraphValue::numVertices).staticmethod("numVertices")
+			.def("numEdges", &GraphValue::numEdges).staticmethod("numEdges")
+					// rst:		.. staticmethod:: numComponents()
+					// rst:
+					// rst:			:returns: the number of connected components, i.e., the number of graphs.
+					// rst:			:rtype: GraphValue
+			.def("numComponents", &GraphValue::numComponents).staticmethod("numComponents")
+					// rst:		.. staticmethod:: numRings()
+					// rst:
+					// rst:			:returns: the cycle rank, i.e., the number of independent cycles.
+					// rst:			:rtype: GraphValue
+			.def("numRings", &GraphValue::numRings).staticmethod("numRings")
+					// rst:		.. staticmethod:: vertexLabelCount(label)
+					// rst:		                  edgeLabelCount(label)
+					// rst:
+					// rst:			:param str label: the label to count.
+					// rst:			:returns: the number of vertices, respectively edges, with the given string label.
+					// rst:			:rtype: GraphValue
+			.def("vertexLabelCount", &GraphValue::vertexLabelCount).staticmethod("vertexLabelCount")
+			.def("edgeLabelCount", &GraphValue::edgeLabelCount).staticmethod("edgeLabelCount")
+					// rst:		.. staticmethod:: exactMass()
+					// rst:
+					// rst:			:returns: the exact mass, which is NaN for graphs which are not molecules.
+					// rst:				Therefore all comparisons of it are false for such graphs, including ``!=``.
+					// rst:			:rtype: GraphValue
+			.def("exactMass", &GraphValue::exactMass).staticmethod("exactMass")
+					// rst:		.. staticmethod:: charge()
+					// rst:
+					// rst:			:returns: the total charge.
+					// rst:			:rtype: GraphValue
+			.def("charge", &GraphValue::charge).staticmethod("charge")
+					// rst:		.. staticmethod:: numChargedVertices()
+					// rst:
+					// rst:			:returns: the number of vertices with non-zero charge.
+					// rst:			:rtype: GraphValue
+			.def("numChargedVertices", &GraphValue::numChargedVertices).staticmethod("numChargedVertices")
+					// rst:		.. staticmethod:: numRadicals()
+					// rst:
+					// rst:			:returns: the number of vertices with a radical.
+					// rst:			:rtype: GraphValue
+			.def("numRadicals", &GraphValue::numRadicals).staticmethod("numRadicals")
+					// rst:		.. staticmethod:: energy()
+					// rst:
+					// rst:			:returns: the energy as given by :attr:`Graph.energy`, which is NaN for graphs which are not molecules.
+					// rst:			:rtype: GraphValue
+			.def("energy", &GraphValue::energy).staticmethod("energy")
+					// rst:		.. staticmethod:: massDistance(target)
+					// rst:		                  vertexLabelDistance(target)
+					// rst:
+					// rst:			Heuristic distances to a target graph, e.g., for the score in :func:`DGStrat.makeBestFirst`.
+					// rst:			The mass distance is the absolute difference of the exact masses, and thus NaN if one of the graphs is not a molecule.
+					// rst:			The vertex label distance is the number of vertex labels to add or remove from the multiset of vertex labels of a graph
+					// rst:			to obtain the multiset of the target.
+					// rst:
+					// rst:			:param Graph target: the graph to measure the distance to.
+					// rst:			:returns: the distance of a graph to ``target``.
+					// rst:			:rtype: GraphValue
+					// rst:			:raises: :class:`LogicError` if ``target`` is ``None``.
+			.def("massDistance", &GraphValue::massDistance).staticmethod("massDistance")
+			.def("vertexLabelDistance", &GraphValue::vertexLabelDistance).staticmethod("vertexLabelDistance");
+
+	// rst: .. class:: GraphPredicate
+	// rst:
+	// rst:		An immutable predicate on a multiset of graphs.
+	// rst:		Predicates can be combined with ``p & q``, ``p | q``, and ``~p``.
+	// rst:
+	py::class_<GraphPredicate>("GraphPredicate", py::no_init)
+			.def(str(py::self))
+					// rst:		.. method:: __call__(g)
+					// rst:
+					// rst:			:param g: the graph or graphs to evaluate the predicate on.
+					// rst:			:type g: Graph or list[Graph]
+					// rst:			:returns: whether the predicate holds for the given graph or multiset of graphs.
+					// rst:			:rtype: bool
+			.def("__call__", predGraph)
+			.def("__call__", predGraphs)
+			.def("__and__", &GraphPredicate::makeAnd)
+			.def("__or__", &GraphPredicate::makeOr)
+			.def("__invert__", &GraphPredicate::makeNot)
+					// rst:		.. staticmethod:: makeAll(p)
+					// rst:		                  makeAny(p)
+					// rst:
+					// rst:			:param GraphPredicate p: the predicate to quantify.
+					// rst:			:returns: a predicate which holds for a multiset of graphs if ``p`` holds for each graph,
+					// rst:				respectively for some graph, on its own.
+					// rst:			:rtype: GraphPredicate
+			.def("makeAll", &GraphPredicate::makeAll).staticmethod("makeAll")
+			.def("makeAny", &GraphPredicate::makeAny).staticmethod("makeAny");
+}
+
+} // namespace mod::dg::Py
@@ -1,6 +1,7 @@
 #include <mod/py/Common.hpp>
 
 #include <mod/dg/DG.hpp>
+#include <mod/dg/GraphPredicates.hpp>
 #include <mod/dg/Strategies.hpp>
 
 // rst: This section describes two interfaces for the derivation graph strategies;
@@ -32,6 +33,7 @@
 // rst:         : "leftPredicate[" derivationPred "](" `strat` ")"
 // rst:         : "rightPredicate[" derivationPred "](" `strat` ")"
 // rst:         : "repeat" [ "[" int "]" ] "(" strat ")"
+// rst:         : "bestFirst(" score "," `strat` { "," keyword "=" value } ")"
 // rst:         : "revive(" `strat` ")"
 // rst:
 // rst: A ``strats`` must be an iterable of :token:`~dgStrat:strat`, e.g., an iterable of :class:`Rule`.
@@ -81,6 +83,10 @@
 // rst:
 // rst:		:returns: the result of :func:`DGStrat.makeRevive`.
 // rst:
+// rst: .. function:: bestFirst(score, strat, *, targets=[], maxExpansions=0, maxVertices=0, maxDerivations=0, timeLimit=0)
+// rst:
+// rst:		:returns: the result of :func:`DGStrat.makeBestFirst`.
+// rst:
 
 namespace mod::dg::Py {
 
@@ -95,6 +101,27 @@ void Strategy_doExport() {
 	std::shared_ptr<Strategy> (*makeAdd_dynamic)(bool,
 	                                             const std::shared_ptr<mod::Function<std::vector<std::shared_ptr<mod::graph::Graph>>()>>,
 	                                             IsomorphismPolicy) = &Strategy::makeAdd;
+	std::shared_ptr<Strategy> (*makeFilter_func)(bool,
+	                                             std::shared_ptr<mod::Function<bool(std::shared_ptr<mod::graph::Graph>,
+	                                                                                const Strategy::GraphState &,
+	                                                                                bool)>>) = &Strategy::makeFilter;
+	std::shared_ptr<Strategy> (*makeFilter_native)(bool, const GraphPredicate &) = &Strategy::makeFilter;
+	std::shared_ptr<Strategy> (*makeLeftPredicate_func)(std::shared_ptr<mod::Function<bool(const Derivation &)>>,
+	                                                    std::shared_ptr<Strategy>) = &Strategy::makeLeftPredicate;
+	std::shared_ptr<Strategy> (*makeLeftPredicate_native)(const GraphPredicate &,
+	                                                      std::shared_ptr<Strategy>) = &Strategy::makeLeftPredicate;
+	std::shared_ptr<Strategy> (*makeRightPredicate_func)(std::shared_ptr<mod::Function<bool(const Derivation &)>>,
+	                                                     std::shared_ptr<Strategy>) = &Strategy::makeRightPredicate;
+	std::shared_ptr<Strategy> (*makeRightPredicate_native)(const GraphPredicate &,
+	                                                       std::shared_ptr<Strategy>) = &Strategy::makeRightPredicate;
+	std::shared_ptr<Strategy> (*makeBestFirst_func)(std::shared_ptr<mod::Function<double(std::shared_ptr<mod::graph::Graph>)>>,
+	                                                std::shared_ptr<Strategy>,
+	                                                const std::vector<std::shared_ptr<mod::graph::Graph>> &,
+	                                                int, int, int, double) = &Strategy::makeBestFirst;
+	std::shared_ptr<Strategy> (*makeBestFirst_native)(const GraphValue &,
+	                                                  std::shared_ptr<Strategy>,
+	                                                  const std::vector<std::shared_ptr<mod::graph::Graph>> &,
+	                                                  int, int, int, double) = &Strategy::makeBestFirst;
 	// rst: .. class:: DGStrat
 	// rst: 
 	auto pyStrat = py::class_<Strategy, std::shared_ptr<Strategy>, boost::noncopyable>("DGStrat", py::no_init)
@@ -142,10 +169,12 @@ void Strategy_doExport() {
 					// rst:			:param p: the filtering predicate being called for each graph in either the subset or the universe.
 					// rst:				The predicate is called with the graph and the graph state as arguments, and a bool stating whether
 					// rst:				the call is the first in the filtering process.
-					// rst:			:type p: Callable[[Graph, DGStrat.GraphState, bool], bool]
+					// rst:				If a :class:`GraphPredicate` is given, then it is evaluated natively on each graph on its own.
+					// rst:			:type p: Callable[[Graph, DGStrat.GraphState, bool], bool] or GraphPredicate
 					// rst:			:returns: a :ref:`strat-filterUniverse` strategy if ``onlyUniverse`` is ``True``, otherwise a :ref:`strat-filterSubset` strategy.
 					// rst:			:rtype: DGStrat
-			.def("makeFilter", &Strategy::makeFilter).staticmethod("makeFilter")
+			.def("makeFilter", makeFilter_func)
+			.def("makeFilter", makeFilter_native).staticmethod("makeFilter")
 					// rst:		.. staticmethod:: makeExecute(func)
 					// rst:
 					// rst:			:param func: A function being executed when the strategy is evaluated.
@@ -164,21 +193,25 @@ void Strategy_doExport() {
 					// rst:
 					// rst:			:param p: the predicate to be called on each candidate derivation.
 					// rst:				Even though the predicate is called with a :class:`Derivation` object, only the left side and the rule of the object is valid.
-					// rst:			:type p: Callable[[Derivation], bool]
+					// rst:				If a :class:`GraphPredicate` is given, then it is evaluated natively on the left graphs.
+					// rst:			:type p: Callable[[Derivation], bool] or GraphPredicate
 					// rst:			:param DGStrat strat: the sub-strategy to be evaluated under the constraints of the left predicate.
 					// rst:			:returns: a :ref:`strat-leftPredicate` strategy.
 					// rst:			:rtype: DGStrat
 					// rst:			:raises: :class:`LogicError` if ``strat`` is ``None``.
-			.def("makeLeftPredicate", &Strategy::makeLeftPredicate).staticmethod("makeLeftPredicate")
+			.def("makeLeftPredicate", makeLeftPredicate_func)
+			.def("makeLeftPredicate", makeLeftPredicate_native).staticmethod("makeLeftPredicate")
 					// rst:		.. staticmethod:: makeRightPredicate(p, strat)
 					// rst:
 					// rst:			:param p: the predicate to be called on each candidate derivation.
-					// rst:			:type p: Callable[[Derivation], bool]
+					// rst:				If a :class:`GraphPredicate` is given, then it is evaluated natively on the right graphs.
+					// rst:			:type p: Callable[[Derivation], bool] or GraphPredicate
 					// rst:			:param DGStrat strat: the sub-strategy to be evaluated under the constraints of the right predicate.
 					// rst:			:returns: a :ref:`strat-rightPredicate` strategy.
 					// rst:			:rtype: DGStrat
 					// rst:			:raises: :class:`LogicError` if ``strat`` is ``None``.
-			.def("makeRightPredicate", &Strategy::makeRightPredicate).staticmethod("makeRightPredicate")
+			.def("makeRightPredicate", makeRightPredicate_func)
+			.def("makeRightPredicate", makeRightPredicate_native).staticmethod("makeRightPredicate")
 					// rst:		.. staticmethod:: makeRevive(strat)
 					// rst:
 					// rst:			:param DGStrat strat: the strategy to encapsulate.
@@ -194,7 +227,26 @@ void Strategy_doExport() {
 					// rst:			:rtype: DGStrat
 					// rst:			:raises: :class:`LogicError` if ``limit`` is negative.
 					// rst:			:raises: :class:`LogicError` if ``strat`` is ``None``.
-			.def("makeRepeat", &Strategy::makeRepeat).staticmethod("makeRepeat");
+			.def("makeRepeat", &Strategy::makeRepeat).staticmethod("makeRepeat")
+					// rst:		.. staticmethod:: makeBestFirst(score, strat, targets, maxExpansions, maxVertices, maxDerivations, timeLimit)
+					// rst:
+					// rst:			:param score: the score of each graph found, where the graphs with the lowest score are expanded first.
+					// rst:				If a :class:`GraphValue` is given, e.g., :meth:`GraphValue.massDistance`, then it is evaluated natively.
+					// rst:			:type score: Callable[[Graph], float] or GraphValue
+					// rst:			:param DGStrat strat: the strategy to evaluate on each expanded graph.
+					// rst:			:param targets: graphs where the rest of the execution is skipped when an isomorphic graph is derived.
+					// rst:			:type targets: list[Graph]
+					// rst:			:param int maxExpansions: the maximum number of graphs to expand, or 0 for no limit.
+					// rst:			:param int maxVertices: the maximum size of the universe, or 0 for no limit.
+					// rst:			:param int maxDerivations: the maximum number of derivations, or 0 for no limit.
+					// rst:			:param float timeLimit: the maximum number of seconds to search, or 0 for no limit.
+					// rst:			:returns: a :ref:`strat-bestFirst` strategy.
+					// rst:			:rtype: DGStrat
+					// rst:			:raises: :class:`LogicError` if ``strat`` is ``None``.
+					// rst:			:raises: :class:`LogicError` if there is a ``None`` in ``targets``.
+					// rst:			:raises: :class:`LogicError` if one of the limits is negative.
+			.def("makeBestFirst", makeBestFirst_func)
+			.def("makeBestFirst", makeBestFirst_native).staticmethod("makeBestFirst");
 
 	{
 		auto scope = py::scope(pyStrat);
@@ -46,6 +46,7 @@ void Graph_doExport() {
 					// rst:
 					// rst:			:param LabelSettings labelSettings: the label settings to use.
 					// rst:			:returns: an object representing the automorphism group of the graph, with the given label settings.
+					// rst:			:throws: :class:`LogicError` if stereo-information is requested.
 					// rst:			:rtype: AutGroup
 			.def("aut", &Graph::aut)
 					//------------------------------------------------------------------
@@ -181,8 +182,8 @@ void Graph_doExport() {
 					// rst:			:returns: the number of isomorphisms/monomorphisms from this graph to ``other``, but at most ``maxNumMatches``.
 					// rst:			:rtype: int
 					// rst:			:raises LogicError: if ``codomain`` is null.
-			.def("isomorphism", &Graph::isomorphism)
-			.def("monomorphism", &Graph::monomorphism)
+			.def("isomorphism", mod::Py::withoutGIL<&Graph::isomorphism>)
+			.def("monomorphism", mod::Py::withoutGIL<&Graph::monomorphism>)
 					// rst:		.. method:: enumerateIsomorphisms(codomain, callback,  labelSettings=LabelSettings(LabelType.String, LabelRelation.Isomorphism))
 					// rst:		            enumerateMonomorphisms(codomain, callback,  labelSettings=LabelSettings(LabelType.String, LabelRelation.Isomorphism))
 					// rst:
@@ -198,8 +199,8 @@ void Graph_doExport() {
 					// rst:
 					// rst:			:raises LogicError: if ``codomain`` is null.
 					// rst:			:raises LogicError: if ``callback`` is null.
-			.def("enumerateIsomorphisms", &Graph::enumerateIsomorphisms)
-			.def("enumerateMonomorphisms", &Graph::enumerateMonomorphisms)
+			.def("enumerateIsomorphisms", mod::Py::withoutGIL<&Graph::enumerateIsomorphisms>)
+			.def("enumerateMonomorphisms", mod::Py::withoutGIL<&Graph::enumerateMonomorphisms>)
 					// rst:		.. method:: makePermutation()
 					// rst:
 					// rst:			:returns: a graph isomorphic to this, but with the vertex indices randomly permuted.
@@ -434,7 +435,32 @@ void Graph_doExport() {
 			.def("fromSDStringMulti", &Graph::fromSDStringMulti)
 			.staticmethod("fromSDStringMulti")
 			.def("fromSDFileMulti", &Graph::fromSDFileMulti)
-			.staticmethod("fromSDFileMulti");
+			.staticmethod("fromSDFileMulti")
+					// rst: .. staticmethod:: Graph.fromSMILESFileBatch(f, allowAbstract=False, classPolicy=SmilesClassPolicy.NoneOnDuplicate, add=True, printStereoWarnings=True)
+					// rst:                   Graph.fromSDFileBatch(f, options=MDLOptions(), add=True)
+					// rst:                   Graph.fromGMLFileBatch(fs, add=True, printStereoWarnings=True)
+					// rst:
+					// rst:		Load a large collection of graphs, where each record is a single connected graph.
+					// rst:		For SMILES files each non-blank line is a record, consisting of a SMILES string optionally followed
+					// rst:		by whitespace and the name of the graph.
+					// rst:		For SD files each MOL entry is a record, and for GML each file is a record.
+					// rst:		The records are parsed and canonicalised in parallel using ``config.common.numThreads`` threads,
+					// rst:		and only the first graph of each isomorphism class is returned, in the order of the records.
+					// rst:		Warnings and errors are reported with the index of the record they originate from, starting from 0.
+					// rst:
+					// rst:		See :meth:`fromSMILES`, :meth:`fromSDFile`, and :meth:`fromGMLFile`
+					// rst:		for a description of the parameters and exceptions.
+					// rst:
+					// rst:		:param fs: the names of the GML files to load.
+					// rst:		:type fs: list[str or CWDPath]
+					// rst:		:returns: a list of pairwise non-isomorphic graphs.
+					// rst:		:rtype: list[Graph]
+			.def("fromSMILESFileBatch", mod::Py::withoutGIL<&Graph::fromSMILESFileBatch>)
+			.staticmethod("fromSMILESFileBatch")
+			.def("fromSDFileBatch", mod::Py::withoutGIL<&Graph::fromSDFileBatch>)
+			.staticmethod("fromSDFileBatch")
+			.def("fromGMLFileBatch", mod::Py::withoutGIL<&Graph::fromGMLFileBatch>)
+			.staticmethod("fromGMLFileBatch");
 
 	mod::Py::exportVertexMap<VertexMap<graph::Graph, graph::Graph>>("VertexMapGraphGraph");
 
@@ -124,7 +124,7 @@ void Composition_doExport() {
 			// rst:				See :cpp:func:`rule::Composer::eval` for details.
 			// rst:			:returns: the resulting list of rules of the expression.
 			// rst:			:rtype: list[Rule]
-			.def("eval", &Composer::eval)
+			.def("eval", mod::Py::withoutGIL<&Composer::eval>)
 			// rst:		.. method:: print()
 			// rst:
 			// rst:			Print the graph representing all expressions evaluated so far.
@@ -145,7 +145,7 @@ void Rule_doExport() {
 					// rst:			:param LabelSettings labelSettings: the label settings to use during the search.
 					// rst:			:returns: the number of isomorphisms found between ``other`` and this rule, but at most ``maxNumMatches``.
 					// rst:			:rtype: int
-			.def("isomorphism", &Rule::isomorphism)
+			.def("isomorphism", mod::Py::withoutGIL<&Rule::isomorphism>)
 					// rst:		.. method:: monomorphism(host, maxNumMatches=1, labelSettings=LabelSettings(LabelType.String, LabelRelation.Isomorphism))
 					// rst:
 					// rst:			:param Rule host: the host :class:`Rule` to check for subgraphs.
@@ -153,7 +153,7 @@ void Rule_doExport() {
 					// rst:			:param LabelSettings labelSettings: the label settings to use during the search.
 					// rst:			:returns: the number of monomorphisms from this rule to subgraphs of ``host``, though at most ``maxNumMatches``.
 					// rst:			:rtype: int
-			.def("monomorphism", &Rule::monomorphism)
+			.def("monomorphism", mod::Py::withoutGIL<&Rule::monomorphism>)
 					// rst:		.. method:: isomorphicLeftRight(other, labelSettings=LabelSettings(LabelType.String, LabelRelation.Isomorphism))
 					// rst:
 					// rst:			:param Rule other: the other :class:`Rule` for comparison.
@@ -9,6 +9,7 @@
 #undef BOOST_BIND_GLOBAL_PLACEHOLDERS
 
 #include <optional>
+#include <utility>
 
 namespace py = boost::python;
 namespace mod::Py {
@@ -57,6 +58,71 @@ struct ToPythonOptionalValue {
 	}
 };
 
+// Releases the GIL for the lifetime of the object.
+// Use it around library calls which do not touch Python objects,
+// except through callbacks which acquire the GIL themselves.
+struct ReleaseGIL {
+	ReleaseGIL() : state(PyEval_SaveThread()) {}
+	ReleaseGIL(const ReleaseGIL &) = delete;
+	ReleaseGIL &operator=(const ReleaseGIL &) = delete;
+
+	~ReleaseGIL() {
+		PyEval_RestoreThread(state);
+	}
+private:
+	PyThreadState *state;
+};
+
+// Acquires the GIL for the lifetime of the object, from any thread, and whether or not it is already held.
+struct AcquireGIL {
+	AcquireGIL() : state(PyGILState_Ensure()) {}
+	AcquireGIL(const AcquireGIL &) = delete;
+	AcquireGIL &operator=(const AcquireGIL &) = delete;
+
+	~AcquireGIL() {
+		PyGILState_Release(state);
+	}
+private:
+	PyGILState_STATE state;
+};
+
+namespace detail {
+
+template<auto F, typename FType = decltype(F)>
+struct WithoutGIL;
+
+template<auto F, typename R, typename ...Args>
+struct WithoutGIL<F, R (*)(Args...)> {
+	static R call(Args ...args) {
+		ReleaseGIL noGIL;
+		return F(std::forward<Args>(args)...);
+	}
+};
+
+template<auto F, typename R, typename C, typename ...Args>
+struct WithoutGIL<F, R (C::*)(Args...)> {
+	static R call(C &self, Args ...args) {
+		ReleaseGIL noGIL;
+		return (self.*F)(std::forward<Args>(args)...);
+	}
+};
+
+template<auto F, typename R, typename C, typename ...Args>
+struct WithoutGIL<F, R (C::*)(Args...) const> {
+	static R call(const C &self, Args ...args) {
+		ReleaseGIL noGIL;
+		return (self.*F)(std::forward<Args>(args)...);
+	}
+};
+
+} // namespace detail
+
+// A function with the same signature as the function or member function F,
+// but which releases the GIL during the call, e.g., .def("execute", withoutGIL<&Builder::execute>).
+// The arguments are converted and destroyed, and the result is converted, while the GIL is held.
+template<auto F>
+constexpr auto withoutGIL = &detail::WithoutGIL<F>::call;
+
 } // namespace mod::Py
 
 #endif // MOD_PY_COMMON_HPP
\ No newline at end of file
@@ -4,6 +4,7 @@
 // The wrapping and haxing of reference counts could probably be done simpler.
 // The arg wrapping should also be looked into.
 // Use exportFunc to export the wrapper class for a given signature.
+// The trampolines acquire the GIL, so they can be called from library code running without it.
 
 #include <mod/Function.hpp>
 
@@ -48,8 +49,15 @@ struct FunctionWrapper {
 template<typename R, typename ...Args>
 struct FunctionWrapper<R(Args...)> : mod::Function<R(Args...)>, py::wrapper<FunctionWrapper<R(Args...)> > {
 	std::shared_ptr<mod::Function<R(Args...)> > clone() const {
+		AcquireGIL gil;
 		if(py::override f = this->get_override("clone")) {
-			return f();
+			std::shared_ptr<mod::Function<R(Args...)> > res = f();
+			// the clone keeps its Python object alive, which must only be released with the GIL,
+			// but the library may destroy the clone while running without it
+			return std::shared_ptr<mod::Function<R(Args...)> >(res.get(), [res](auto *) mutable {
+				AcquireGIL gil;
+				res.reset();
+			});
 		} else {
 			print(std::cerr << "ERROR: override of 'clone' not found in Function\n");
 			std::cerr << std::endl;
@@ -58,6 +66,7 @@ struct FunctionWrapper<R(Args...)> : mod::Function<R(Args...)>, py::wrapper<Func
 	}
 
 	void print(std::ostream &s) const {
+		AcquireGIL gil;
 		if(py::override f = this->get_override("__str__")) {
 			std::string str = f();
 			s << str;
@@ -68,6 +77,8 @@ struct FunctionWrapper<R(Args...)> : mod::Function<R(Args...)>, py::wrapper<Func
 	}
 
 	R operator()(Args ...args) const {
+		// the library may call from any thread, and usually without the GIL, see withoutGIL
+		AcquireGIL gil;
 		if(py::override f = this->get_override("__call__")) {
 			return Returner<R>::doReturn(f(ArgWrap<Args>::wrap(args)...));
 		} else {
@@ -0,0 +1,149 @@
+#include <mod/graph/Graph.hpp>
+#include <mod/lib/DG/Strategies/GraphState.hpp>
+#include <mod/lib/Graph/Graph.hpp>
+
+#undef NDEBUG
+
+#include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace mod;
+using GraphState = lib::DG::Strategies::GraphState;
+using GraphList = GraphState::GraphList;
+
+// the graphs are created in order, so their IDs are increasing
+std::vector<std::shared_ptr<graph::Graph>> makeGraphs() {
+	std::vector<std::shared_ptr<graph::Graph>> res;
+	for(const std::string smiles : {"C", "N", "O", "S", "P", "F"})
+		res.push_back(graph::Graph::fromSMILES(smiles));
+	return res;
+}
+
+GraphList getSubset(const GraphState &s) {
+	return GraphList(s.getSubset().begin(), s.getSubset().end());
+}
+
+void testMembership(const GraphList &gs) {
+	GraphState s;
+	s.addToUniverse(gs[0]);
+	s.addToSubset(gs[1]);
+	assert(s.isInUniverse(gs[0]));
+	assert(!s.isInSubset(gs[0]));
+	assert(s.isInUniverse(gs[1]));
+	assert(s.isInSubset(gs[1]));
+	assert(!s.isInUniverse(gs[2]));
+	assert(!s.isInSubset(gs[2]));
+	s.addToSubset(gs[0]);
+	s.addToSubset(gs[0]);
+	s.addToUniverse(gs[1]);
+	assert(s.isInSubset(gs[0]));
+	assert((s.getUniverse() == GraphList{gs[0], gs[1]}));
+	assert((getSubset(s) == GraphList{gs[1], gs[0]}));
+}
+
+void testEquality(const GraphList &gs) {
+	GraphState a, b;
+	for(int i : {0, 1, 2}) a.addToUniverse(gs[i]);
+	a.addToSubset(gs[2]);
+	a.addToSubset(gs[0]);
+	for(int i : {2, 0, 1}) b.addToUniverse(gs[i]);
+	b.addToSubset(gs[0]);
+	b.addToSubset(gs[2]);
+	assert(a == b);
+	assert(b == a);
+
+	GraphState c(b);
+	c.addToSubset(gs[1]);
+	assert(!(a == c));
+	assert(!(c == a));
+
+	GraphState d;
+	for(int i : {0, 1, 3}) d.addToUniverse(gs[i]);
+	d.addToSubset(gs[0]);
+	d.addToSubset(gs[3]);
+	assert(!(a == d));
+	assert(!(d == a));
+}
+
+void testCopy(const GraphList &gs) {
+	GraphState a;
+	a.addToSubset(gs[0]);
+	a.addToUniverse(gs[1]);
+	GraphState b(a);
+	assert(b == a);
+	// adding to a copy must not change the original, and vice versa
+	b.addToUniverse(gs[2]);
+	b.addToSubset(gs[1]);
+	assert(!a.isInUniverse(gs[2]));
+	assert(!a.isInSubset(gs[1]));
+	assert((a.getUniverse() == GraphList{gs[0], gs[1]}));
+	assert(b.isInUniverse(gs[2]));
+	assert(b.isInSubset(gs[0]));
+	assert(b.isInSubset(gs[1]));
+	a.addToUniverse(gs[3]);
+	assert(a.isInUniverse(gs[3]));
+	assert(!b.isInUniverse(gs[3]));
+	assert((b.getUniverse() == GraphList{gs[0], gs[1], gs[2]}));
+}
+
+void testSortUniverse(const GraphList &gs) {
+	GraphState s;
+	for(int i = 0; i != 5; ++i) s.addToUniverse(gs[i]);
+	s.addToSubset(gs[3]);
+	s.addToSubset(gs[1]);
+	GraphState copy(s);
+	s.sortUniverse([](const lib::graph::Graph *a, const lib::graph::Graph *b) {
+		return a->getId() > b->getId();
+	});
+	assert((s.getUniverse() == GraphList{gs[4], gs[3], gs[2], gs[1], gs[0]}));
+	// the subset keeps its order, and the lookups follow the new indices
+	assert((getSubset(s) == GraphList{gs[3], gs[1]}));
+	for(int i = 0; i != 5; ++i) {
+		assert(s.isInUniverse(gs[i]));
+		assert(s.isInSubset(gs[i]) == (i == 1 || i == 3));
+	}
+	assert(s == copy);
+	// the copy made before the sort keeps the old order
+	assert((copy.getUniverse() == GraphList{gs[0], gs[1], gs[2], gs[3], gs[4]}));
+	assert(copy.isInSubset(gs[3]));
+
+	s.addToSubset(gs[5]);
+	s.addToSubset(gs[0]);
+	assert((s.getUniverse() == GraphList{gs[4], gs[3], gs[2], gs[1], gs[0], gs[5]}));
+	assert((getSubset(s) == GraphList{gs[3], gs[1], gs[5], gs[0]}));
+	assert(!copy.isInUniverse(gs[5]));
+
+	s.sortSubset(lib::graph::Graph::IdLess());
+	assert((getSubset(s) == GraphList{gs[0], gs[1], gs[3], gs[5]}));
+}
+
+void testMerge(const GraphList &gs) {
+	GraphState a;
+	a.addToSubset(gs[4]);
+	a.addToUniverse(gs[2]);
+	a.addToSubset(gs[0]);
+	GraphState b;
+	b.addToUniverse(gs[2]);
+	b.addToSubset(gs[1]);
+	b.addToSubset(gs[4]);
+	b.sortUniverse(lib::graph::Graph::IdLess());
+	const GraphState m(std::vector<const GraphState *>{&a, &b});
+	// both ordered by ID
+	assert((m.getUniverse() == GraphList{gs[0], gs[1], gs[2], gs[4]}));
+	assert((getSubset(m) == GraphList{gs[0], gs[1], gs[4]}));
+	assert(!m.isInSubset(gs[2]));
+	assert(!m.isInUniverse(gs[3]));
+}
+
+int main() {
+	const auto graphs = makeGraphs();
+	GraphList gs;
+	for(const auto &g : graphs) gs.push_back(&g->getGraph());
+	testMembership(gs);
+	testEquality(gs);
+	testCopy(gs);
+	testSortUniverse(gs);
+	testMerge(gs);
+}
@@ -0,0 +1,31 @@
+include("xx0_helpers.py")
+
+# all isomers have the same number of vertices and edges,
+# so they end up in the same bucket and must be told apart by the index
+hexanes = ['CCCCCC', 'CC(C)CCC', 'CCC(C)CC', 'CC(C)(C)CC', 'CC(C)C(C)C']
+isomers = [smiles(s, name=s) for s in hexanes]
+dg = DG(graphDatabase=isomers)
+dg.build().execute(addSubset(isomers))
+assert dg.numVertices == len(isomers)
+
+for g in isomers:
+	h = graphDFS(g.graphDFS, name="h")
+	fail(lambda: DG(graphDatabase=isomers).build().execute(addSubset(h)),
+		"Isomorphic graphs. Candidate graph 'h' is isomorphic to '{}' in the graph database.".format(g.name))
+
+fail(lambda: DG(graphDatabase=isomers + [smiles('C(CC)CCC', name="dup")]),
+	"Isomorphic graphs 'CCCCCC' and 'dup' in initial graph database.")
+
+# non-molecules are indexed by their labelled structure
+ls = LabelSettings(LabelType.Term, LabelRelation.Isomorphism)
+a = graphDFS("[f(_X)]1[a][b][a]1", name="a")
+b = graphDFS("[f(_Y)]1[a][b][a]1", name="b")
+c = graphDFS("[f(_X)]1[a][a][b]1", name="c")
+dg = DG(graphDatabase=[a, c], labelSettings=ls)
+dg.build().execute(addSubset(a, c))
+assert dg.numVertices == 2
+fail(lambda: DG(graphDatabase=[a, c], labelSettings=ls).build().execute(addSubset(b)),
+	"Isomorphic graphs. Candidate graph 'b' is isomorphic to 'a' in the graph database.")
+fail(lambda: DG(graphDatabase=[a, b], labelSettings=ls),
+	"Isomorphic graphs 'a' and 'b' in initial graph database.")
+dg.listStats()
@@ -0,0 +1,23 @@
+include("xx0_helpers.py")
+
+# the canonical forms of added graphs are computed in parallel before the isomorphism checks,
+# which must not change the result
+def run(numThreads, graphs, ls):
+	config.common.numThreads = numThreads
+	dg = DG(labelSettings=ls)
+	dg.build().execute(addSubset(graphs))
+	config.common.numThreads = 1
+	return [(v.id, v.graph.name) for v in dg.vertices]
+
+alkanes = [smiles("C" * i, name="C{}".format(i)) for i in range(1, 30)]
+abstract = [graphDFS("[x]1" + "[y]" * i + "1", name="ring{}".format(i)) for i in range(2, 30)]
+lsString = LabelSettings(LabelType.String, LabelRelation.Isomorphism)
+lsTerm = LabelSettings(LabelType.Term, LabelRelation.Isomorphism)
+for graphs in [alkanes, abstract, alkanes + abstract]:
+	for ls in [lsString, lsTerm]:
+		serial = run(1, graphs, ls)
+		assert serial == run(4, graphs, ls)
+
+# the data must be the same regardless of which thread computed it
+for g in alkanes:
+	assert g.smiles == smiles(g.smiles).smiles
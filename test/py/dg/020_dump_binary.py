@@ -0,0 +1,73 @@
+include("xx0_helpers.py")
+include("../formoseCommon/grammar.py")
+disableBuildHook()
+
+dg = DG(graphDatabase=inputGraphs)
+dg.build().execute(addSubset(inputGraphs) >> repeat[2](inputRules))
+
+fBinary = dg.dump("out/020_binary.dg")
+config.dg.dumpAsJson = True
+fJson = dg.dump("out/020_json.dg")
+config.dg.dumpAsJson = False
+
+with open(fBinary, "rb") as f:
+	assert f.read(8) == b"MODDGBIN"
+strFromDump(fBinary)
+
+# both formats load to the same DG
+for f in [fBinary, fJson]:
+	dg2 = DG.load(dg.graphDatabase, inputRules, CWDPath(f))
+	_compareDGs(dg, dg2)
+	dg3 = DG.load([], [], CWDPath(f))
+	_compareDGs(dg, dg3, compareData=False)
+	for v, v3 in zip(dg.vertices, dg3.vertices):
+		assert v.graph.name == v3.graph.name
+		assert v.graph.isomorphism(v3.graph) == 1
+
+	dg4 = DG(graphDatabase=inputGraphs)
+	dg4.build().load(inputRules, CWDPath(f))
+	_compareDGs(dg, dg4, compareData=False)
+	for v, v4 in zip(dg.vertices, dg4.vertices):
+		assert v.graph.isomorphism(v4.graph) == 1
+
+# a binary dump of a loaded DG is the same
+_compareDumps(fBinary, DG.load(dg.graphDatabase, inputRules, CWDPath(fBinary)).dump())
+
+# corruption is detected
+with open(fBinary, "rb") as f:
+	data = bytearray(f.read())
+data[len(data) // 2] ^= 0xFF
+with open("out/020_corrupt.dg", "wb") as f:
+	f.write(data)
+fail(lambda: DG.load([], [], CWDPath("out/020_corrupt.dg")),
+	"DG load error: Integrity check failed. Wrong checksum",
+	err=InputError, isSubstring=True)
+with open("out/020_truncated.dg", "wb") as f:
+	f.write(data[:20])
+fail(lambda: DG.load([], [], CWDPath("out/020_truncated.dg")),
+	"DG load error: Integrity check failed. Input too short.",
+	err=InputError)
+
+# corrupt data found after the checksum is rejected before the DG is changed
+import struct, zlib
+with open(fBinary, "rb") as f:
+	data = bytearray(f.read())
+# the last rule index of the last edge
+data[-8:-4] = struct.pack("=I", 2**31)
+data[-4:] = struct.pack("=I", zlib.crc32(bytes(data[:-4])))
+with open("out/020_badRule.dg", "wb") as f:
+	f.write(data)
+dg5 = DG(graphDatabase=inputGraphs)
+b = dg5.build()
+fail(lambda: b.load(inputRules, CWDPath("out/020_badRule.dg")),
+	"DG load error: Corrupt data for edge", err=InputError, isSubstring=True)
+assert dg5.numVertices == 0
+assert dg5.numEdges == 0
+del b
+
+dg = DG(labelSettings=LabelSettings(LabelType.Term, LabelRelation.Specialisation))
+dg.build().execute(addSubset(inputGraphs))
+f = dg.dump()
+fail(lambda: DG().build().load([], CWDPath(f)),
+	"DG load error: Mismatch of label settings.", err=InputError, isSubstring=True)
+assert DG.load([], [], CWDPath(f)).labelSettings == dg.labelSettings
@@ -0,0 +1,28 @@
+include("xx0_helpers.py")
+include("../formoseCommon/grammar.py")
+disableBuildHook()
+
+import threading
+
+def run():
+	dg = DG(graphDatabase=inputGraphs)
+	# the filter is called from the library, which must re-acquire the GIL
+	strat = (addSubset(inputGraphs)
+		>> repeat[2](inputRules)
+		>> filterUniverse(lambda g, gs, first: g.numVertices < 12))
+	dg.build().execute(strat, verbosity=0)
+	vs = [(v.id, v.graph.smiles) for v in dg.vertices]
+	es = [(e.id, sorted(v.id for v in e.sources), sorted(v.id for v in e.targets),
+		sorted(r.name for r in e.rules)) for e in dg.edges]
+	return vs, es
+
+expected = run()
+
+results = [None] * 4
+def worker(i):
+	results[i] = run()
+threads = [threading.Thread(target=worker, args=(i,)) for i in range(len(results))]
+for t in threads: t.start()
+for t in threads: t.join()
+for i, r in enumerate(results):
+	assert r == expected, "thread {}".format(i)
@@ -0,0 +1,51 @@
+include("xx0_helpers.py")
+include("../formoseCommon/grammar.py")
+disableBuildHook()
+
+import json
+
+def run(**kwargs):
+	dg = DG(graphDatabase=inputGraphs)
+	with dg.build() as b:
+		res = b.execute(addSubset(inputGraphs) >> repeat[2](inputRules), **kwargs)
+	return dg, res
+
+dg, res = run()
+fail(lambda: res.getStatsJson(), "No statistics were collected", isSubstring=True)
+
+config.dg.collectStats = True
+for direct in (True, False):
+	config.dg.directRuleApplication = direct
+	dg, res = run(verbosity=0)
+	stats = res.getStats()
+	assert stats == json.loads(res.getStatsJson())
+	assert stats["time"] >= 0
+	names = [rs["name"] for rs in stats["rules"]]
+	assert len(names) == len(set(names))
+	assert set(names) <= set(r.name for r in inputRules)
+	numDerivations = 0
+	for rs in stats["rules"]:
+		# the repeat clones the rule strategies, but each rule has a single entry
+		assert rs["executions"] == 2, rs
+		assert rs["time"]["products"] <= rs["time"]["total"]
+		assert rs["predicateRejections"] == {"left": 0, "right": 0}
+		assert rs["checkIfNew"]["hits"] + rs["checkIfNew"]["misses"] > 0 or rs["derivations"] == 0
+		assert rs["vf2"]["calls"] <= stats["vf2"]["calls"]
+		if direct:
+			assert rs["compositions"] == 0
+		assert rs["boundRules"]["duplicates"] <= rs["boundRules"]["created"]
+		numDerivations += rs["derivations"]
+	assert numDerivations >= dg.numEdges
+	assert sum(rs["vf2"]["calls"] for rs in stats["rules"]) <= stats["vf2"]["calls"]
+	if not direct:
+		assert sum(rs["compositions"] for rs in stats["rules"]) > 0
+config.dg.directRuleApplication = True
+
+# predicate rejections
+for pred, side in ((leftPredicate, "left"), (rightPredicate, "right")):
+	dg = DG(graphDatabase=inputGraphs)
+	res = dg.build().execute(addSubset(inputGraphs) >> pred[lambda d: False](inputRules), verbosity=0)
+	stats = res.getStats()
+	assert sum(rs["derivations"] for rs in stats["rules"]) == 0
+	assert sum(rs["predicateRejections"][side] for rs in stats["rules"]) > 0
+config.dg.collectStats = False
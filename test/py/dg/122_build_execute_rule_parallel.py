@@ -0,0 +1,22 @@
+include("1xx_execute_helpers.py")
+include("../formoseCommon/grammar.py")
+disableBuildHook()
+
+def run(numThreads):
+	config.common.numThreads = numThreads
+	dg = DG(graphDatabase=inputGraphs)
+	dg.build().execute(addSubset(inputGraphs) >> repeat[3](inputRules))
+	config.common.numThreads = 1
+	return dg
+
+serial = summary(run(1), withIds=True)
+for numThreads in [2, 4, 7]:
+	parallel = summary(run(numThreads), withIds=True)
+	assert serial == parallel, "numThreads={}".format(numThreads)
+
+# term labels are bound serially, but the result must of course be the same
+config.common.numThreads = 4
+dg = DG(graphDatabase=inputGraphs,
+	labelSettings=LabelSettings(LabelType.Term, LabelRelation.Specialisation))
+dg.build().execute(addSubset(inputGraphs) >> repeat[2](inputRules))
+config.common.numThreads = 1
@@ -0,0 +1,66 @@
+include("1xx_execute_helpers.py")
+include("../formoseCommon/grammar.py")
+disableBuildHook()
+
+def counters(stats):
+	return {rs["name"]: (rs["executions"], rs["boundRules"], rs["checkIfNew"], rs["derivations"])
+		for rs in stats["rules"]}
+
+def runExecute(direct, withOrder=False):
+	config.dg.directRuleApplication = direct
+	config.dg.collectStats = True
+	dg = DG(graphDatabase=inputGraphs)
+	res = dg.build().execute(addSubset(inputGraphs) >> repeat[3](inputRules))
+	config.dg.collectStats = False
+	config.dg.directRuleApplication = True
+	if withOrder:
+		return [edgeTuple(e) for e in dg.edges], counters(res.getStats())
+	return summary(dg)
+
+def runApply(direct):
+	config.dg.directRuleApplication = direct
+	dg = DG(graphDatabase=inputGraphs)
+	with dg.build() as b:
+		for r in inputRules:
+			b.apply(inputGraphs, r)
+			for g in inputGraphs:
+				b.apply([g], r)
+				b.apply([g, g], r)
+	config.dg.directRuleApplication = True
+	return summary(dg)
+
+assert runExecute(True) == runExecute(False)
+assert runApply(True) == runApply(False)
+
+# the same bound rules are found and discarded, so the counters are the same
+directOrder, directCounters = runExecute(True, withOrder=True)
+compOrder, compCounters = runExecute(False, withOrder=True)
+assert directCounters == compCounters, (directCounters, compCounters)
+assert len(directOrder) == len(compOrder)
+
+# and with multiple threads, with the derivations in the same order
+config.common.numThreads = 4
+assert runExecute(True) == runExecute(False)
+assert runExecute(True, withOrder=True) == (directOrder, directCounters)
+assert runExecute(False, withOrder=True) == (compOrder, compCounters)
+config.common.numThreads = 1
+
+# two symmetric components, where the second partial binding is automorphic to the first
+c = smiles("[C]", "c")
+rSym = ruleGMLString("""rule [
+	context [ node [ id 0 label "C" ] node [ id 1 label "C" ] ]
+	right [ edge [ source 0 target 1 label "-" ] ]
+]""")
+for direct in (True, False):
+	config.dg.directRuleApplication = direct
+	config.dg.collectStats = True
+	dg = DG(graphDatabase=[c])
+	res = dg.build().execute(addSubset(c) >> rSym)
+	rs = res.getStats()["rules"][0]
+	assert rs["boundRules"] == {"created": 3, "duplicates": 1}, rs
+	assert rs["checkIfNew"] == {"hits": 0, "misses": 1}, rs
+	assert rs["derivations"] == 1, rs
+	assert rs["compositions"] == (0 if direct else 2), rs
+	assert dg.numEdges == 1
+	config.dg.collectStats = False
+config.dg.directRuleApplication = True
@@ -0,0 +1,33 @@
+include("1xx_execute_helpers.py")
+include("../formoseCommon/grammar.py")
+disableBuildHook()
+
+# duplicate partially bound rules are only found through composition
+config.dg.directRuleApplication = False
+
+def run(graphs, rules, dedup, steps):
+	config.dg.doRuleIsomorphismDuringBinding = dedup
+	dg = DG(graphDatabase=graphs)
+	dg.build().execute(addSubset(graphs) >> repeat[steps](rules))
+	config.dg.doRuleIsomorphismDuringBinding = True
+	return summary(dg)
+
+assert run(inputGraphs, inputRules, True, 2) == run(inputGraphs, inputRules, False, 2)
+
+# many isomorphic partial bindings
+gs = [smiles("[O]", "O"), smiles("[N]", "N"), smiles("[O][N]", "ON")]
+r = ruleGMLString("""rule [
+	ruleID "Connect 3"
+	context [
+		node [ id 0 label "O" ]
+		node [ id 1 label "N" ]
+		node [ id 2 label "O" ]
+	]
+	right [
+		edge [ source 0 target 1 label "-" ]
+		edge [ source 1 target 2 label "-" ]
+	]
+]""")
+assert run(gs, [r], True, 1) == run(gs, [r], False, 1)
+
+config.dg.directRuleApplication = True
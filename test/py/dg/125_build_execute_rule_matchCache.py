@@ -0,0 +1,50 @@
+include("1xx_execute_helpers.py")
+include("../formoseCommon/grammar.py")
+disableBuildHook()
+
+# the matches of the rules into the graphs are reused over the rounds and executions
+def run(cacheSize):
+	config.dg.componentMatchCacheSize = cacheSize
+	config.dg.collectStats = True
+	dg = DG(graphDatabase=inputGraphs)
+	with dg.build() as b:
+		res1 = b.execute(addSubset(inputGraphs) >> repeat[3](inputRules))
+		res2 = b.execute(addSubset(inputGraphs) >> repeat[2](inputRules))
+		for r in inputRules:
+			b.apply(inputGraphs, r)
+	config.dg.collectStats = False
+	config.dg.componentMatchCacheSize = 65536
+	dg.listStats()
+	return summary(dg), res1.getStats()["componentMatchCache"], res2.getStats()["componentMatchCache"]
+
+expected, noCache1, noCache2 = run(0)
+assert noCache1["hits"] == 0 and noCache2["hits"] == 0, (noCache1, noCache2)
+assert noCache1["evictions"] == 0 and noCache2["evictions"] == 0, (noCache1, noCache2)
+assert noCache1["misses"] > 0, noCache1
+
+def check(cacheSize):
+	res, c1, c2 = run(cacheSize)
+	assert res == expected
+	# the lookups do not depend on the cache
+	assert c1["hits"] + c1["misses"] == noCache1["misses"], (c1, noCache1)
+	assert c2["hits"] + c2["misses"] == noCache2["misses"], (c2, noCache2)
+	return c1, c2
+
+c1, c2 = check(65536)
+# the later rounds reuse the matches of the earlier ones
+assert c1["hits"] > 0, c1
+assert c1["evictions"] == 0, c1
+# and the second execution only sees pairs seen by the first
+assert c2["misses"] == 0, c2
+assert c2["hits"] == noCache2["misses"], (c2, noCache2)
+
+# with evictions
+c1, c2 = check(1)
+assert c1["evictions"] > 0, c1
+assert c2["misses"] > 0, c2
+c1, c2 = check(7)
+assert c1["evictions"] > 0, c1
+
+config.common.numThreads = 4
+assert check(7) == (c1, c2)
+config.common.numThreads = 1
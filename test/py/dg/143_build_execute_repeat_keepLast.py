@@ -0,0 +1,43 @@
+include("1xx_execute_helpers.py")
+
+c1 = smiles("[C]", "c1")
+c2 = smiles("[C][C]", "c2")
+c3 = smiles("[C][C][C]", "c3")
+n1 = smiles("[N]", "n1")
+n2 = smiles("[N][N]", "n2")
+n3 = smiles("[N][N][N]", "n3")
+c1n1 = smiles("[C][N]", "c1n1")
+c2n1e = smiles("[C][C][N]", "c2n1e")
+c2n1m = smiles("[C][N][C]", "c2n1m")
+c1n2e = smiles("[C][N][N]", "c1n2e")
+c1n2m = smiles("[N][C][N]", "c1n2m")
+o1 = smiles("[O]", "o1")
+
+
+r = ruleGMLString("""rule [
+	left  [ node [ id 0 label "C" ] ]
+	right [ node [ id 0 label "N" ] ]
+]""")
+
+# only the last two rounds are kept, the same results are expected as with all rounds kept
+config.dg.repeatKeepOnlyLastRounds = True
+
+universe = [c1, c2, c3, n1, n2, n3, c1n1, c2n1e, c2n1m, c1n2e, c1n2m]
+exeStrat(addSubset(c1, c2, c3) >> repeat[1](r),
+	[n1, c1n1, c2n1e, c2n1m], [c1, c2, c3, n1, c1n1, c2n1e, c2n1m], graphDatabase=inputGraphs)
+exeStrat(addSubset(c1, c2, c3) >> repeat[2](r),
+	[n2, c1n2e, c1n2m], [c1, c2, c3, n1, n2, c1n1, c2n1e, c2n1m, c1n2e, c1n2m], graphDatabase=inputGraphs)
+exeStrat(addSubset(c1, c2, c3) >> repeat[3](r), [n3], universe, graphDatabase=inputGraphs)
+exeStrat(addSubset(c1, c2, c3) >> repeat(r), [n3], universe, graphDatabase=inputGraphs)
+
+# sub-strategies with the input as output
+exeStrat(addSubset(c1, c2, c3) >> repeat[5](r >> execute(lambda gs: None)), [n3], universe, graphDatabase=inputGraphs)
+exeStrat(addSubset(c1) >> repeat(filterSubset(False)), [c1], [c1])
+exeStrat(addSubset(c1) >> repeat(filterSubset(False) >> addSubset(c2)), [c2], [c1, c2])
+exeStrat(addSubset(c1) >> repeat[0](addSubset(c2)), [c1], [c1])
+
+# the consumed graphs of the discarded rounds
+exeStrat(addSubset(c1, c2, c3, o1) >> revive(repeat[3](r)), [n3, o1], universe + [o1],
+	graphDatabase=inputGraphs)
+
+config.dg.repeatKeepOnlyLastRounds = False
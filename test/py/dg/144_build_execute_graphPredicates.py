@@ -0,0 +1,66 @@
+include("1xx_execute_helpers.py")
+
+methane = smiles("C", "methane")
+ethane = smiles("CC", "ethane")
+ammonium = smiles("[NH4+]", "ammonium")
+benzene = smiles("c1ccccc1", "benzene")
+nonMol = graphGMLString('graph [ node [ id 0 label "Q" ] ]', "nonMol")
+
+# values
+C = GraphValue.vertexLabelCount("C")
+assert C(methane) == 1
+assert C([methane, ethane]) == 3
+assert C([]) == 0
+assert GraphValue.vertexLabelCount("H")(methane) == 4
+assert GraphValue.edgeLabelCount(":")(benzene) == 6
+assert GraphValue.numVertices()(ethane) == 8
+assert GraphValue.numEdges()(ethane) == 7
+assert GraphValue.numComponents()([methane, ethane]) == 2
+assert GraphValue.numRings()(benzene) == 1
+assert GraphValue.numRings()(ethane) == 0
+assert GraphValue.charge()(ammonium) == 1
+assert GraphValue.charge()(methane) == 0
+assert GraphValue.numChargedVertices()([ammonium, ammonium]) == 2
+assert GraphValue.numRadicals()(methane) == 0
+assert abs(GraphValue.exactMass()(methane) - methane.exactMass) < 1e-9
+assert str(C) == "vertexLabelCount('C')"
+fail(lambda: C(None), "The graph is a null pointer.")
+fail(lambda: C([methane, None]), "One of the graphs is a null pointer.")
+
+# predicates
+small = C <= 1
+assert str(small) == "vertexLabelCount('C') <= 1"
+assert small(methane)
+assert not small(ethane)
+assert not small([methane, methane])
+assert GraphPredicate.makeAll(small)([methane, methane])
+assert not GraphPredicate.makeAll(small)([methane, ethane])
+assert GraphPredicate.makeAny(small)([ethane, methane])
+assert (small | (C == 2))(ethane)
+assert not (small & (C == 2))(ethane)
+assert (~small)(ethane)
+# the mass of non-molecules is NaN
+assert not (GraphValue.exactMass() < 1000)(nonMol)
+assert not (GraphValue.exactMass() != 0)(nonMol)
+assert (~(GraphValue.exactMass() < 1000))(nonMol)
+
+# filters
+exeStrat(addSubset(methane, ethane) >> DGStrat.makeFilter(False, small), [methane], [methane, ethane])
+exeStrat(addSubset(methane, ethane) >> filterSubset(small), [methane], [methane, ethane])
+exeStrat(addSubset(methane, ethane) >> filterUniverse(small), [methane], [methane])
+exeStrat(addSubset(methane, ethane) >> filterUniverse(~small), [ethane], [ethane])
+
+# derivation predicates
+g1 = smiles("[C]", "g1")
+g2 = smiles("[N]", "g2")
+r = ruleGMLString("""rule [
+	left  [ node [ id 0 label "C" ] ]
+	right [ node [ id 0 label "N" ] ]
+]""")
+N = GraphValue.vertexLabelCount("N")
+exeStrat(DGStrat.makeLeftPredicate(C == 0, addSubset(g1) >> r), [],   [g1],     graphDatabase=[g1, g2])
+exeStrat(leftPredicate [C == 0](addSubset(g1) >> r),            [],   [g1],     graphDatabase=[g1, g2])
+exeStrat(leftPredicate [C == 1](addSubset(g1) >> r),            [g2], [g1, g2], graphDatabase=[g1, g2])
+exeStrat(rightPredicate[C >= 1](addSubset(g1) >> r),            [],   [g1],     graphDatabase=[g1, g2])
+exeStrat(rightPredicate[GraphPredicate.makeAll(N == 1)](addSubset(g1) >> r),
+         [g2], [g1, g2], graphDatabase=[g1, g2])
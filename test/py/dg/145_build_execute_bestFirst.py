@@ -0,0 +1,59 @@
+include("1xx_execute_helpers.py")
+
+c = smiles("[C]", "c")
+n = smiles("[N]", "n")
+o = smiles("[O]", "o")
+s = smiles("[S]", "s")
+p = smiles("[P]", "p")
+methane = smiles("C", "methane")
+ethane = smiles("CC", "ethane")
+
+def relabel(src, tar):
+	return ruleGMLString("""rule [
+		left  [ node [ id 0 label "%s" ] ]
+		right [ node [ id 0 label "%s" ] ]
+	]""" % (src, tar))
+rCN = relabel("C", "N")
+rNO = relabel("N", "O")
+rCS = relabel("C", "S")
+rSP = relabel("S", "P")
+rules = [rCN, rNO, rCS]
+db = [c, n, o, s, p]
+
+def score(g):
+	if g == c: return 0
+	if g == n: return 1
+	return 5
+
+# heuristics
+assert GraphValue.vertexLabelDistance(o)(c) == 2
+assert GraphValue.vertexLabelDistance(o)(o) == 0
+assert GraphValue.vertexLabelDistance(methane)(ethane) == 3
+assert abs(GraphValue.massDistance(ethane)(methane) - (ethane.exactMass - methane.exactMass)) < 1e-9
+assert str(GraphValue.vertexLabelDistance(o)) == "vertexLabelDistance('o')"
+assert str(GraphValue.energy()) == "energy"
+fail(lambda: GraphValue.massDistance(None), "The target is a null pointer.")
+
+fail(lambda: DGStrat.makeBestFirst(score, None, [], 0, 0, 0, 0), "The substrategy is a null pointer.")
+fail(lambda: DGStrat.makeBestFirst(score, dgStrat(rCN), [None], 0, 0, 0, 0), "One of the targets is a null pointer.")
+fail(lambda: DGStrat.makeBestFirst(score, dgStrat(rCN), [], -1, 0, 0, 0), "maxExpansions must be non-negative.")
+fail(lambda: DGStrat.makeBestFirst(score, dgStrat(rCN), [], 0, 0, 0, -1), "timeLimit must be non-negative.")
+
+# exhaustive, the output subset is the empty frontier
+exeStrat(addSubset(c) >> bestFirst(score, rules), [], [c, n, o, s], graphDatabase=db)
+# n is expanded before s, so o is derived before s is expanded
+exeStrat(addSubset(c) >> bestFirst(score, rules, targets=[o]), [o, s], [c, n, o, s], graphDatabase=db)
+# and the rest of the execution is skipped
+exeStrat(addSubset(c) >> bestFirst(score, rules, targets=[o]) >> rSP, [], [c, n, o, s], graphDatabase=db)
+exeStrat(addSubset(c) >> bestFirst(score, rules) >> addSubset(s) >> rSP, [p], [c, n, o, s, p], graphDatabase=db)
+
+# budgets
+exeStrat(addSubset(c) >> bestFirst(score, rules, maxExpansions=1), [n, s], [c, n, s], graphDatabase=db)
+exeStrat(addSubset(c) >> bestFirst(score, rules, maxDerivations=1), [n], [c, n], graphDatabase=db)
+exeStrat(addSubset(c) >> bestFirst(score, rules, maxVertices=3), [n, s], [c, n, s], graphDatabase=db)
+
+# native scores
+exeStrat(addSubset(c) >> bestFirst(GraphValue.vertexLabelDistance(o), rules, maxExpansions=1),
+	[n, s], [c, n, s], graphDatabase=db)
+exeStrat(addSubset(c) >> DGStrat.makeBestFirst(GraphValue.vertexLabelDistance(o), dgStrat(rules), [o], 0, 0, 0, 0),
+	[o, s], [c, n, o, s], graphDatabase=db)
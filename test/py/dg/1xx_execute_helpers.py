@@ -23,3 +23,21 @@ def exeStrat(strat, subset=None, universe=None, ls=lsString, graphDatabase=[], *
 			print("Res universe:", rUniverse)
 			assert False
 	return dg, b, res
+
+def edgeTuple(e):
+	return (tuple(sorted(v.graph.smiles for v in e.sources)),
+		tuple(sorted(v.graph.smiles for v in e.targets)),
+		tuple(sorted(r.name for r in e.rules)))
+
+# The vertices and edges of a DG by their contents,
+# or with withIds=True as ordered lists that also include the vertex and edge IDs.
+def summary(dg, withIds=False):
+	if withIds:
+		vs = [(v.id, v.graph.smiles) for v in dg.vertices]
+		es = [(e.id, sorted(v.id for v in e.sources), sorted(v.id for v in e.targets),
+			sorted(r.name for r in e.rules)) for e in dg.edges]
+		return vs, es
+	vs = set(v.graph.smiles for v in dg.vertices)
+	es = set(edgeTuple(e) for e in dg.edges)
+	assert len(es) == dg.numEdges
+	return vs, es
@@ -107,4 +107,4 @@ checkBad("[foo[]",    "Open square bracket in vertex label of vertex 0")
 checkBad("[[bar]",    "Open square bracket in vertex label of vertex 0")
 checkBad("[foo[bar]", "Open square bracket in vertex label of vertex 0")
 
-checkBad("[C]{X}[O]", "Can not canonicalise arbitrary edge labels.")
+checkBad("[C]{X}[O]", "The graph has non-chemical edge labels.")
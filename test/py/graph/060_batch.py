@@ -0,0 +1,58 @@
+include("../xxx_helpers.py")
+post.disableInvokeMake()
+config.common.numThreads = 4
+
+# SMILES, one record per line, with optional names, and isomorphic duplicates removed
+with open("out/batch.smi", "w") as f:
+	f.write("CCO ethanol\n\nOCC\nC methane\n  O   water  \r\nC(C)O dup\n")
+gs = Graph.fromSMILESFileBatch("out/batch.smi", add=False)
+assert [g.name for g in gs] == ["ethanol", "methane", "water"], [g.name for g in gs]
+assert [g.smiles for g in gs] == [smiles(s, add=False).smiles for s in ["CCO", "C", "O"]]
+assert gs[0].id < gs[1].id < gs[2].id
+
+many = ["C" * i for i in range(1, 60)]
+with open("out/many.smi", "w") as f:
+	for s in many + list(reversed(many)):
+		f.write(s + "\n")
+gs = Graph.fromSMILESFileBatch("out/many.smi", add=False)
+assert [g.smiles for g in gs] == [smiles(s, add=False).smiles for s in many]
+
+with open("out/bad.smi", "w") as f:
+	f.write("CCO\nC\n\nC.C\nCX\n")
+fail(lambda: Graph.fromSMILESFileBatch("out/bad.smi"), "record 2 (line 4)", err=InputError, isSubstring=True)
+fail(lambda: Graph.fromSMILESFileBatch("out/doesNotExist.smi"), "Could not open", err=InputError, isSubstring=True)
+
+# stereoisomers are not merged, but stereo-equal duplicates are
+with open("out/stereo.smi", "w") as f:
+	f.write("N[C@@H](C)C(=O)O L\nN[C@H](C)C(=O)O D\nC[C@H](N)C(=O)O L2\nNC(C)C(=O)O any\n")
+gs = Graph.fromSMILESFileBatch("out/stereo.smi", add=False)
+assert [g.name for g in gs] == ["L", "D", "any"], [g.name for g in gs]
+
+# SD, one record per MOL entry
+mol = """
+ OpenBabel03141812452D
+
+  3  2  0  0  0  0  0  0  0  0999 V2000
+    0.0000    0.0000    0.0000 C   0  0  0  0  0  0  0  0  0  0  0  0
+    0.0000    0.0000    0.0000 C   0  0  0  0  0  0  0  0  0  0  0  0
+    0.0000    0.0000    0.0000 O   0  0  0  0  0  0  0  0  0  0  0  0
+  1  2  1  0  0  0  0
+  2  3  1  0  0  0  0
+M  END
+"""
+with open("out/batch.sd", "w") as f:
+	f.write(mol + "$$$$\n" + mol + ">\n>\n\n$$$$\n" + mol + "$$$$\n\n")
+gs = Graph.fromSDFileBatch("out/batch.sd", add=False)
+assert len(gs) == 1
+assert gs[0].smiles == smiles("CCO", add=False).smiles
+
+with open("out/bad.sd", "w") as f:
+	f.write(mol + "$$$$\n" + mol + "a\n$$$$\n")
+fail(lambda: Graph.fromSDFileBatch("out/bad.sd"), "record 1 (line 12)", err=InputError, isSubstring=True)
+
+# GML, one record per file
+for i, s in enumerate(["CCO", "C", "OCC"]):
+	with open("out/batch_{}.gml".format(i), "w") as f:
+		f.write(smiles(s, add=False).getGMLString())
+gs = Graph.fromGMLFileBatch(["out/batch_{}.gml".format(i) for i in range(3)], add=False)
+assert len(gs) == 2
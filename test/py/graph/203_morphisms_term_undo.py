@@ -0,0 +1,25 @@
+include("2xx_morphisms_helpers.py")
+
+lsIso = LabelSettings(LabelType.Term, LabelRelation.Isomorphism)
+lsSpec = LabelSettings(LabelType.Term, LabelRelation.Specialisation)
+lsUni = LabelSettings(LabelType.Term, LabelRelation.Unification)
+
+# the unification of a candidate may fail after it has partially succeeded,
+# so the machine must be restored before trying the next candidate
+fa_a = Graph.fromDFS("[t(f(_A))][t(_A)]")
+star = Graph.fromDFS("[t(f(a))]([t(b)])([t(a)])[t(c)]")
+check(fa_a.enumerateMonomorphisms, star, [], ls=lsIso)
+check(fa_a.enumerateMonomorphisms, star, [[(0, 0), (1, 2)]], ls=lsSpec)
+check(fa_a.enumerateMonomorphisms, star, [[(0, 0), (1, 2)]], ls=lsUni)
+
+# many accepted candidates, each with their own unifier
+ab = Graph.fromDFS("[t(_A)][t(_B)]")
+cycle = Graph.fromDFS("[t(_C)]1[t(_D)][t(_E)][t(_F)]1")
+res = []
+for i in range(4):
+	j = (i + 1) % 4
+	res.append([(0, i), (1, j)])
+	res.append([(0, j), (1, i)])
+check(ab.enumerateMonomorphisms, cycle, res, ls=lsIso)
+check(ab.enumerateMonomorphisms, cycle, res, ls=lsSpec)
+check(ab.enumerateMonomorphisms, cycle, res, ls=lsUni)
@@ -0,0 +1,32 @@
+include("2xx_morphisms_helpers.py")
+
+# labels are compared by their interned IDs,
+# so the same label must compare equal regardless of where it came from
+g1 = Graph.fromDFS("[Q]-[R]{S}[Q]")
+g2 = Graph.fromGMLString("""graph [
+	node [ id 0 label "Q" ]
+	node [ id 1 label "R" ]
+	node [ id 2 label "Q" ]
+	edge [ source 0 target 1 label "-" ]
+	edge [ source 1 target 2 label "S" ]
+]""")
+g3 = Graph.fromDFS("[Q]-[R]{T}[Q]")
+assert g1.isomorphism(g2) == 1
+assert g1.isomorphism(g3) == 0
+check(g1.enumerateIsomorphisms, g2, [[(0, 0), (1, 1), (2, 2)]])
+check(g1.enumerateIsomorphisms, g3, [])
+assert Graph.fromDFS("[R]{S}[Q]").monomorphism(g1) == 1
+assert Graph.fromDFS("[R]{S}[Q]").monomorphism(g3) == 0
+
+# rule sides, also after inversion
+r = Rule.fromDFS("[R]0{S}[Q]1>>[R]0{T}[Q]1")
+rInv = r.makeInverse()
+dg = DG(graphDatabase=[g1, g3])
+with dg.build() as b:
+	res = b.apply([g1], r)
+	assert len(res) == 1
+	assert res[0].targets[0].graph.isomorphism(g3) == 1
+	res = b.apply([g3], rInv)
+	assert len(res) == 1
+	assert res[0].targets[0].graph.isomorphism(g1) == 1
+	assert len(b.apply([g3], r)) == 0
@@ -0,0 +1,48 @@
+include("2xx_morphisms_helpers.py")
+include("../formoseCommon/grammar.py")
+
+lsTermUni = LabelSettings(LabelType.Term, LabelRelation.Unification)
+
+def counts(pairs, ls):
+	return [gDom.monomorphism(gCodom, maxNumMatches=1000, labelSettings=ls)
+	        for gDom, gCodom in pairs]
+
+# the rejection before VF2 may never change the results
+pairs = [(a, b) for a in inputGraphs for b in inputGraphs]
+pairs.append((Graph.fromDFS("[R]{S}[Q]"), Graph.fromDFS("[Q]-[R]{S}[Q]")))
+pairs.append((Graph.fromDFS("[R]{S}[Q]"), Graph.fromDFS("[Q]-[R]{T}[Q]")))
+pairs.append((Graph.fromDFS("[Q]([Q])[Q]"), Graph.fromDFS("[Q][Q][Q]")))
+# variables must not be rejected by their string labels
+termPairs = [
+	(Graph.fromDFS("[_X]-[_Y]"), Graph.fromDFS("[C]-[O]")),
+	(Graph.fromDFS("[t(_A)]{_E}[t(_B)]"), Graph.fromDFS("[t(a)]-[t(b)]")),
+	(Graph.fromDFS("[_X]([_Y])[_Z]"), Graph.fromDFS("[C]([O])[O]")),
+]
+for ps, ls in ((pairs, lsString), (termPairs, lsTermUni)):
+	config.rc.useComponentFingerprints = True
+	withFp = counts(ps, ls)
+	config.rc.useComponentFingerprints = False
+	withoutFp = counts(ps, ls)
+	assert withFp == withoutFp, (withFp, withoutFp)
+config.rc.useComponentFingerprints = True
+assert counts(termPairs, lsTermUni) == [2, 2, 2]
+
+def numComposed():
+	rc = rcEvaluator(inputRules)
+	res = 0
+	for r1 in inputRules:
+		for r2 in inputRules:
+			res += len(rc.eval(r1 *rcSuper* r2))
+			res += len(rc.eval(r1 *rcSub* r2))
+	return res
+
+def numDerivations():
+	dg = DG(graphDatabase=inputGraphs)
+	dg.build().execute(addSubset(inputGraphs) >> repeat[2](inputRules))
+	return dg.numEdges
+
+for f in (numComposed, numDerivations):
+	config.rc.useComponentFingerprints = False
+	without = f()
+	config.rc.useComponentFingerprints = True
+	assert f() == without
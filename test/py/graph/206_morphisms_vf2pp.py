@@ -0,0 +1,57 @@
+include("2xx_morphisms_helpers.py")
+include("../formoseCommon/grammar.py")
+
+lsTermUni = LabelSettings(LabelType.Term, LabelRelation.Unification)
+lsStereo = LabelSettings(LabelType.String, LabelRelation.Isomorphism, LabelRelation.Isomorphism)
+
+def counts(pairs, ls):
+	res = []
+	for gDom, gCodom in pairs:
+		res.append(gDom.monomorphism(gCodom, maxNumMatches=1000, labelSettings=ls))
+		res.append(gDom.isomorphism(gCodom, maxNumMatches=1000, labelSettings=ls))
+		maps = []
+		gDom.enumerateMonomorphisms(gCodom,
+			callback=lambda m: maps.append(tuple(m[v].id for v in m.domain.vertices)) or True,
+			labelSettings=ls)
+		res.append(sorted(maps))
+	return res
+
+# the finders must find the same morphisms
+pairs = [(a, b) for a in inputGraphs for b in inputGraphs]
+pairs.append((Graph.fromDFS("O=C-C-O"), Graph.fromDFS("OCC(O)C(O)C(O)C=O")))
+pairs.append((Graph.fromDFS("[Q]([Q])[Q]"), Graph.fromDFS("[Q][Q][Q]")))
+pairs.append((Graph.fromDFS("C1CC1.O"), Graph.fromDFS("C1CC1CO")))
+termPairs = [
+	(Graph.fromDFS("[_X]-[_Y]"), Graph.fromDFS("[C]-[O]")),
+	(Graph.fromDFS("[t(_A)]{_E}[t(_B)]"), Graph.fromDFS("[t(a)]-[t(b)]")),
+	(Graph.fromDFS("[_X]([_Y])[_Z]"), Graph.fromDFS("[C]([O])[O]")),
+]
+config.graph.isomorphismAlg = Config.IsomorphismAlg.VF2
+for ps, ls in ((pairs, lsString), (termPairs, lsTermUni), (pairs, lsStereo)):
+	config.graph.morphismFinder = Config.MorphismFinder.VF2
+	withVF2 = counts(ps, ls)
+	config.graph.morphismFinder = Config.MorphismFinder.VF2PP
+	withVF2PP = counts(ps, ls)
+	assert withVF2 == withVF2PP, (withVF2, withVF2PP)
+config.graph.isomorphismAlg = Config.IsomorphismAlg.SmilesCanonVF2
+
+def numComposed():
+	rc = rcEvaluator(inputRules)
+	res = 0
+	for r1 in inputRules:
+		for r2 in inputRules:
+			res += len(rc.eval(r1 *rcSuper* r2))
+			res += len(rc.eval(r1 *rcSub* r2))
+	return res
+
+def numDerivations():
+	dg = DG(graphDatabase=inputGraphs)
+	dg.build().execute(addSubset(inputGraphs) >> repeat[2](inputRules))
+	return dg.numEdges
+
+for f in (numComposed, numDerivations):
+	config.graph.morphismFinder = Config.MorphismFinder.VF2
+	withVF2 = f()
+	config.graph.morphismFinder = Config.MorphismFinder.VF2PP
+	assert f() == withVF2
+config.graph.morphismFinder = Config.MorphismFinder.VF2
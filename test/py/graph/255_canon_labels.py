@@ -0,0 +1,73 @@
+include("../xxx_helpers.py")
+
+def check(gs, ls):
+	for g1 in gs:
+		for g2 in gs:
+			config.graph.isomorphismAlg = Config.IsomorphismAlg.VF2
+			expected = g1.isomorphism(g2, labelSettings=ls)
+			for alg in [Config.IsomorphismAlg.Canon, Config.IsomorphismAlg.SmilesCanonVF2]:
+				config.graph.isomorphismAlg = alg
+				res = g1.isomorphism(g2, labelSettings=ls)
+				assert res == expected, (g1, g2, ls, alg, res, expected)
+			config.graph.isomorphismAlg = Config.IsomorphismAlg.SmilesCanonVF2
+
+def withPermutations(gs):
+	res = []
+	for g in gs:
+		res.append(g)
+		for i in range(3):
+			res.append(g.makePermutation())
+	return res
+
+# arbitrary edge labels
+lsString = LabelSettings(LabelType.String, LabelRelation.Isomorphism)
+check(withPermutations([
+	Graph.fromDFS("[A]{x}[B]{y}[C]{x}[A]"),
+	Graph.fromDFS("[A]{x}[B]{x}[C]{y}[A]"),
+	Graph.fromDFS("[A]1{x}[A]{x}[A]{y}[A]{y}1"),
+	Graph.fromDFS("[A]1{x}[A]{y}[A]{x}[A]{y}1"),
+	Graph.fromDFS("C1CC{=}C1"),
+]), lsString)
+g = Graph.fromDFS("[A]1{x}[A]{y}[A]{x}[A]{y}1")
+assert len(g.aut(lsString).gens) > 0
+
+# variable-free terms, where equal terms may be written differently
+lsTerm = LabelSettings(LabelType.Term, LabelRelation.Isomorphism)
+check(withPermutations([
+	Graph.fromDFS("[f(a,b)]{g(c)}[h]"),
+	Graph.fromDFS("[f(a, b)]{g( c )}[h]"),
+	Graph.fromDFS("[f(b,a)]{g(c)}[h]"),
+]), lsTerm)
+g1 = Graph.fromDFS("[f(a,b)]{g(c)}[h]")
+g2 = Graph.fromDFS("[f(a, b)]{g( c )}[h]")
+config.graph.isomorphismAlg = Config.IsomorphismAlg.Canon
+assert g1.isomorphism(g2, labelSettings=lsTerm) == 1
+fail(lambda: Graph.fromDFS("[f(_X)][h]").isomorphism(Graph.fromDFS("[f(_X)][h]"), labelSettings=lsTerm),
+	"Can not canonicalise term labels with variables.", isSubstring=True)
+config.graph.isomorphismAlg = Config.IsomorphismAlg.SmilesCanonVF2
+
+# stereo
+lsStereo = LabelSettings(LabelType.String, LabelRelation.Isomorphism, LabelRelation.Isomorphism)
+check(withPermutations([
+	smiles("C[C@H](N)O"),
+	smiles("C[C@@H](N)O"),
+	smiles("C[C@H](O)N"),
+	smiles("C[C@H](C)O"),
+]), lsStereo)
+fail(lambda: smiles("C[C@H](N)O").aut(lsStereo), "Can not compute automorphism groups with stereo-information.")
+
+# stereo with terms, where equal terms may be written differently
+lsTermStereo = LabelSettings(LabelType.Term, LabelRelation.Isomorphism, LabelRelation.Isomorphism)
+def termStereo(conf, f, g):
+	gml = 'graph [ node [ id 0 label "Q" stereo "tetrahedral[%s]!" ]' % conf
+	for i, l in enumerate([f, g, "h", "k"], 1):
+		gml += ' node [ id %d label "%s" ] edge [ source 0 target %d label "-" ]' % (i, l, i)
+	return Graph.fromGMLString(gml + " ]")
+tsA = termStereo("1, 2, 3, 4", "f(a,b)", "g(c)")
+tsB = termStereo("1, 2, 3, 4", "f(a, b)", "g( c )")
+tsC = termStereo("1, 2, 4, 3", "f(a,b)", "g(c)")
+check(withPermutations([tsA, tsB, tsC]), lsTermStereo)
+config.graph.isomorphismAlg = Config.IsomorphismAlg.Canon
+assert tsA.isomorphism(tsB, labelSettings=lsTermStereo) == 1
+assert tsA.isomorphism(tsC, labelSettings=lsTermStereo) == 0
+config.graph.isomorphismAlg = Config.IsomorphismAlg.SmilesCanonVF2
@@ -0,0 +1,29 @@
+include("../xxx_helpers.py")
+post.enableInvokeMake()
+
+gml = 'graph [ node [ id 0 label "Q" ] node [ id 1 label "R" ] node [ id 2 label "S" ] edge [ source 0 target 1 label "-" ] edge [ source 1 target 2 label "=" ] ]'
+a = graphGMLString(gml, "a")
+b = graphGMLString(gml, "b")
+assert a != b
+c = graphGMLString(gml.replace('"S"', '"T"'), "c")
+
+# identical depictions of different graph objects share their files
+p = GraphPrinter()
+fa = a.print(p)
+fb = b.print(p)
+fc = c.print(p)
+assert fa == fb, (fa, fb)
+assert fa != fc, (fa, fc)
+
+p.withIndex = True
+assert a.print(p) == b.print(p)
+assert a.print(p) != fa
+
+# the deduplication starts over when the commands are flushed
+p.withIndex = False
+d = graphGMLString(gml, "d")
+post.flushCommands()
+fd = d.print(p)
+assert fd != fa, (fd, fa)
+e = graphGMLString(gml, "e")
+assert e.print(p) == fd
@@ -0,0 +1,60 @@
+# the constraints are also checked on the partial morphisms during the search,
+# which must give the same results as checking the complete morphisms
+graphCommon = """
+	node [ id 0 label "s" ]
+	node [ id 1 label "v" ]
+	node [ id 2 label "v" ]
+	node [ id 3 label "t" ]
+	edge [ source 0 target 1 label "-" ]
+	edge [ source 1 target 2 label "-" ]
+	edge [ source 2 target 3 label "-" ]
+"""
+ruleTemplate = """rule [
+	ruleID "%s"
+	left [
+		edge [ source 1 target 2 label "-" ]
+	]
+	context [
+		node [ id 0 label "s" ]
+		node [ id 1 label "v" ]
+		node [ id 2 label "v" ]
+		node [ id 3 label "t" ]
+		edge [ source 0 target 1 label "-" ]
+		edge [ source 2 target 3 label "-" ]
+	]
+	right [
+		edge [ source 1 target 2 label "%s" ]
+	]
+	constrainShortestPath [
+		source 0 target 3
+		op "%s" length %s
+	]
+	constrainAdj [
+		id 1 op ">=" count 2
+		nodeLabels [ label "s" label "v" ]
+	]
+]"""
+rules = [
+	Rule.fromGMLString(ruleTemplate % ("Leq2", "leq2", "<=", "2")),
+	Rule.fromGMLString(ruleTemplate % ("Eq1", "eq1", "=", "1")),
+	Rule.fromGMLString(ruleTemplate % ("Eq3", "eq3", "=", "3")),
+	Rule.fromGMLString(ruleTemplate % ("Geq2", "geq2", ">=", "2")),
+]
+length1 = Graph.fromGMLString('graph [ %s edge [ source 0 target 3  label "-" ] ]' % graphCommon, name="length1")
+length3 = Graph.fromGMLString('graph [ %s ]' % graphCommon, name="length3")
+expected = {
+	("Leq2", "length1"),
+	("Eq1", "length1"),
+	("Eq3", "length3"),
+	("Geq2", "length3"),
+}
+for lt in (LabelType.String, LabelType.Term):
+	for rel in (LabelRelation.Isomorphism, LabelRelation.Specialisation):
+		dg = DG(graphDatabase=[length1, length3], labelSettings=LabelSettings(lt, rel))
+		dg.build().execute(addSubset(length1, length3) >> rules)
+		found = set()
+		for e in dg.edges:
+			assert len(e.rules) == 1
+			for s in e.sources:
+				found.add((e.rules[0].name, s.graph.name))
+		assert found == expected, (lt, rel, found)
@@ -0,0 +1,28 @@
+include("../xxx_helpers.py")
+
+# composition results are looked up in the database by isomorphism,
+# so isomorphic results must be the same rule object
+r1 = Rule.fromDFS("[A]>>[B]", name="r1")
+r2 = Rule.fromDFS("[B]>>[C]", name="r2")
+r3 = Rule.fromDFS("[A]>>[B]", name="r3")
+rc = RCEvaluator([r1, r2])
+res1 = rc.eval(r1 *rcParallel* r2)
+res2 = rc.eval(r2 *rcParallel* r1)
+res3 = rc.eval(r3 *rcParallel* r2)
+assert len(res1) == 1
+assert res1 == res2 == res3, (res1, res2, res3)
+assert len(rc.createdRules) == 1, rc.createdRules
+
+# the same vertex labels, but a different structure
+ra = Rule.fromDFS("[A]1[B][C]1>>[A]1[B][C]1", name="ra")
+rb = Rule.fromDFS("[A][B][C]>>[A][B][C]", name="rb")
+res = rc.eval(ra *rcParallel* ra)
+res += rc.eval(rb *rcParallel* rb)
+assert len(res) == 2 and res[0] != res[1], res
+
+# isomorphism is modulo variable renaming for terms
+ls = LabelSettings(LabelType.Term, LabelRelation.Isomorphism)
+t1 = Rule.fromDFS("[f(_X)]>>[g(_X)]", name="t1")
+t2 = Rule.fromDFS("[f(_Y)]>>[g(_Y)]", name="t2")
+rc = RCEvaluator([t1, t2], labelSettings=ls)
+assert rc.eval(t1 *rcParallel* t2) == rc.eval(t2 *rcParallel* t1)
@@ -0,0 +1,32 @@
+include("../xxx_helpers.py")
+
+rs = [
+	Rule.fromDFS("[C]1[O][H].[H][O][C]1>>[C]1[O][C]1.[H][O][H]", name="condense"),
+	Rule.fromDFS("[C]1[O][C]1.[H][O][H]>>[C]1[O][H].[H][O][C]1", name="hydrolyse"),
+	Rule.fromDFS("[C]=[O].[H][C]>>[C]([O][H])[C]", name="aldol"),
+]
+
+def run(numThreads):
+	config.common.numThreads = numThreads
+	rc = RCEvaluator(rs)
+	exp = rcExp(rs) *rcSuper(allowPartial=False)* rcExp(rs)
+	exp = exp *rcCommon(maximum=True)* rcExp(rs)
+	res = rc.eval(exp)
+	config.common.numThreads = 1
+	return rc, exp, res
+
+rcSerial, exp, resSerial = run(1)
+numCreated = len(rcSerial.createdRules)
+
+# a repeated evaluation reuses the recorded compositions
+ids = lambda res: sorted(r.id for r in res)
+assert ids(rcSerial.eval(exp)) == ids(resSerial)
+assert len(rcSerial.createdRules) == numCreated
+
+# the parallel evaluation finds the same rules
+for numThreads in [2, 4]:
+	rc, _, res = run(numThreads)
+	assert len(rc.createdRules) == numCreated, (numThreads, len(rc.createdRules), numCreated)
+	assert len(res) == len(resSerial), (numThreads, len(res), len(resSerial))
+	for r in res:
+		assert any(r.isomorphism(rOther) == 1 for rOther in resSerial), (numThreads, r)
@@ -0,0 +1,9 @@
+include('common.py')
+
+# configurations with more neighbours than are stored inline
+def star(n):
+	return 'node [ id 0 label "Q" stereo "[%s]!" ]' % ", ".join(str(i) for i in range(1, n + 1)) \
+		+ "".join('node [ id %d label "Z" ] edge [ source 0 target %d label "-" ]' % (i, i) for i in range(1, n + 1))
+for n in [5, 6, 8]:
+	a = gGML(star(n))
+	assert a.isomorphism(a, labelSettings=isoLabelSettings) == 1